@@ -1,654 +1,1616 @@
-/******************************************************************************
-*                                                                             *
-* File -> NORX.c                                                              *
-* Purpose -> Encrypt and Decrypt text using the NORX algorithm                *
-* Author -> Joseph Kroeker                                                    *
-* Version -> 1.0 03/10/2018 - Setting Up Core Permutation                     *
-*            2.0 03/11/2018 - Adding High Level Prototypes/Functions and      *
-*                              calls in main functions                        *
-*            3.0 04/07/2018 - Compiling and correcting errors                 *
-*            4.0 04/18/2018 - Fill finalise() and create right()              *
-*            5.0 04/30/2018 - Review of previous functions and corrections    * 
-*                             for functionality                               *
-*                                                                             *
-******************************************************************************/
-
-//*****************************************************************************
-// Flag for 32 Bit Words
-//*****************************************************************************
-#define WORD_32 0x1
-
-//*****************************************************************************
-// Includes
-//*****************************************************************************
-#include <stdbool.h>   // bool types
-#include <stdint.h>    // uintXX_t types
-#include <string.h>    // string functions
-
-#include "NORX.h"      // NORX defines and prototypes
-
-//***************************************************************************
-//
-// Function -> main
-// Purpose -> test encode and decode functions
-// 
-//***************************************************************************
-int 
-main(void) {
-  word_t K[0x10];
-  word_t N[0x30];
-  word_t A[0x80];
-  word_t M[0x80];
-  word_t Z[0x80];
-  word_t C[0x80];
-  
-  int i;
- 
-  printf("running\n");
-  word_t Test[0x10] = { 0 }; // buffer for testing the different functions 
-
-  //TODO test the F with (u0, .. u15) = F(0, .. 15)**2 
-  
-  //
-  // Init K to 0x0, 0x1, ... 0xE, 0xF
-  //
-  for (i = 0; i <= 0xF; i++) {
-    K[i] = i;
-  }
-
-  // 
-  // Init N to 0x0, 0x1, ... 0x2E, 0x2F 
-  //
-  for (i = 0; i <= 0x2F; i++) {
-    N[i] = i;
-  }
-  
-  //
-  // Init A, M, and Z to 0x0, 0x1, ... 0x7E, 0x7F
-  //
-  for (i = 0; i <= 0x7F; i++) {
-    A[i] = i;
-    M[i] = i;
-    Z[i] = i;
-  } 
-
-  //
-  // Run encryption
-  //
-  //NORXEnc(K, N, A, M, Z, C);
-  //printf("done");
-
-  // 
-  // Print test key
-  //
-  printf("Key : \n");
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", K[i]);
-  } 
-
-  // 
-  // Print test Nonce
-  //
-  printf("\nNonce : \n");
-  for (i = 0; i<= 0x2F; i++) {
-    printf("%x ", N[i]);
-  } 
-
-    printf("%d \n", sizeof(M) / sizeof(word_t));
-  // 
-  // Print test init run
-  //
-  // TODO fix this to display given values from NORX instructions
-  // TODO test out different round amounts, indexing may be off
-  initialise(K, N, Test);
-  printf("\nTest Init : \n");
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", Test[i]);
-  }
-  
-  
-  absorb(Test, A, sizeof(A) / sizeof(word_t), 0x01);
-  printf("\nTest Absorb : \n");
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", Test[i]);
-  }
-
-
-  
-  branch(Test, Test, sizeof(M) / sizeof(word_t) , 0x10);
-  printf("\nTest Branch : \n");
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", Test[i]);
-  }
-
-  encrypt(Test, M, sizeof(M) / sizeof(word_t), 0x02, C);
-   
-  printf("\nTest Encrypt : \n");
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", Test[i]);
-  }
-  printf("\n");
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", C[i]); 
-  } 
-
-  printf("\n Test Merge : \n");
-  merge(Test, Test, sizeof(M) / sizeof(word_t), 0x20);
-  for (i=0; i<=0xF; i++) {
-    printf("%x ", Test[i]);
-  }
-  //
-  // Print the results of the encoding 
-  //
-  //printf("\n Test Enc : \n");
-  //for (i=0; i<=0xF; i++) {
-  //  printf("%x ", C[i]);
-  //} 
-
-  return 0;
-}
-
-//*****************************************************************************
-//
-// Function -> NORXEnc
-// Purpose -> Run all steps needed to complete a full NORX encryption
-// Inputs -> nkey_t K - Key value
-//           nonce_t N - Nonce value
-//           word_t A[] - Message Header
-//           word_t M[] - Message Text 
-//           word_t Z[] - Message Footer
-//
-//*****************************************************************************
-void 
-NORXEnc(word_t K[], word_t N[], word_t A[], word_t M[], word_t Z[], word_t C[]) {
-    word_t S[16] = { 0 };     // State, 4x4 matrix of words
-    word_t Sbar[16] = { 0 };  // State bar, 4x4 matrix of words
-    word_t outT[TAG_LEN] = { 0 };   // 4 word tag
-    uint32_t i;
-
-    uint32_t msgSize = sizeof(M) * sizeof(word_t);
-    uint32_t headSize = sizeof(A) * sizeof(word_t);
-    uint32_t footSize = sizeof(Z) * sizeof (word_t);
-
-    //
-    // Zero C
-    //
-    printf("%d \n", msgSize);
-    for (i = 0; i < msgSize; i++) {
-      C[i] = 0;
-    } 
-
-    // 
-    // Run encryption
-    //
-    initialise(K, N, S);
-    absorb(S, A, headSize, 0x01);
-    printf("branch : \n");
-    branch(S, Sbar, msgSize , 0x10);
-  printf("Enc : \n");
-    encrypt(Sbar, M, msgSize, 0x02, C);
-  printf("Merge : \n");
-    merge(Sbar, S, msgSize , 0x20);
-  printf("Absorb : \n");
-    absorb(S, Z, footSize, 0x04);
-  printf("Finalise : \n");
-    //finalise(S, K, 0x08, outT);
-  printf("Done : \n");
-}
-
-//*****************************************************************************
-//
-// Function -> NORXDec
-// Purpose -> Run all steps needed to complete a full NORX decryption
-// Inputs -> nkey_t K - Key value
-//           nonce_t N - Nonce value
-//           word_t A[] - Message Header
-//           word_t C[] - Cipher text 
-//           word_t Z[] - Message Footer
-//           tag_t T - Hash Value from Encryption
-//
-//*****************************************************************************
-void 
-NORXDec(word_t K[], word_t N[], word_t A[], word_t C[], word_t Z[], word_t T[], word_t M[]) {
-    word_t S[16] = { 0 };     // State, 4x4 matrix of words
-    word_t Sbar[16] = { 0 };  // State bar, 4x4 matrix of words
-    word_t outT[TAG_LEN] = { 0 };   // 4 word tag
-
-    uint32_t encSize = sizeof(C) / sizeof(word_t);
-    uint32_t headSize = sizeof(A) / sizeof(word_t);
-    uint32_t footSize = sizeof(Z) / sizeof (word_t);
-    
-    initialise(K, N, S);
-    absorb(S, A, headSize, 0x01);
-    branch(S, Sbar, encSize, 0x10);
-    decrypt(Sbar, C, encSize, 0x02, M);
-    merge(Sbar, S, encSize, 0x20);
-    absorb(S, Z, footSize, 0x04);
-    finalise(S, K, 0x08, outT);
-}
-
-//*****************************************************************************
-//
-// Function -> initialise
-// Purpose -> 
-// Inputs -> word_t* pwKIni - Key value
-//           word_t* pwNIni - Nonce value
-//           word_t* pwSIni[] - Pointer to State, 4x4 matrix of words
-//
-//*****************************************************************************
-void
-initialise(word_t* pwKIni, word_t* pwNIni, word_t* pwSIni) {
-  //
-  // S = N, K, U8 - U15
-  //
-  pwSIni[0] = pwNIni[0];  
-  pwSIni[1] = pwNIni[1];
-  pwSIni[2] = pwNIni[2];
-  pwSIni[3] = pwNIni[3];
-  pwSIni[4] = pwKIni[0];
-  pwSIni[5] = pwKIni[1];
-  pwSIni[6] = pwKIni[2];
-  pwSIni[7] = pwKIni[3];
-  pwSIni[8] = U8;
-  pwSIni[9] = U9;
-  pwSIni[10] = U10;
-  pwSIni[11] = U11;
-  pwSIni[12] = U12;
-  pwSIni[13] = U13;
-  pwSIni[14] = U14;
-  pwSIni[15] = U15;
-
-  //
-  // (12, 13, 14, 15) ^ w, l, p, t
-  //
-  pwSIni[12] ^= WORD_LEN;
-  pwSIni[13] ^= RND_NUM; 
-  pwSIni[14] ^= PARALLEL;
-  pwSIni[15] ^= TAG_LEN;
-
-  //
-  // Run F permutation on S
-  //
-  F(pwSIni);
-  
-  //
-  // (12, 13, 14, 15) ^ K
-  //
-  pwSIni[12] ^= pwKIni[0];
-  pwSIni[13] ^= pwKIni[1]; 
-  pwSIni[14] ^= pwKIni[2];
-  pwSIni[15] ^= pwKIni[3];
-}
-
-//*****************************************************************************
-//
-// Function -> absorb
-// Purpose ->
-// Inputs -> word_t* pwSAbs[] - Pointer to State, 4x4 matrix of words
-//           word_t* pwAZ[] - Pointer to Either the Header or Footer
-//           uint32_t absDomain - Domain Constant for Absorb
-//
-//*****************************************************************************
-void 
-absorb(word_t* pwSAbs, word_t* pwAZ, uint32_t AZSize, uint32_t absDomain) {
-  uint32_t i;
-  uint32_t j;
-  uint32_t k = 0;
-  word_t X[0xF] = { 0 };
-  uint32_t m = AZSize / 12;  // split AZ size into 12 word 
-  
-  //
-  // check if m needs to be rounded up for padding purposes
-  //
-  if (m * 12 != AZSize) {
-    m++;
-  }
-
-  // TODO check functionality, notation is weird in the notesi
-  if (AZSize > 0) {
-    for (i = 0; i <= m - 2; i++) {
-      //
-      // Set up X, which is 12 words of pwAZ, and 4 words of 0
-      //
-      for (j = 15; j > 3; j--) { 
-        X[j] = pwAZ[k];
-        k++;
-      } 
-      for (j; j > 0; j--) {
-        X[j - 1] = 0;
-      } 
-      
-      //
-      // XOR with domain and run F
-      //
-      pwSAbs[15] ^= absDomain;
-      F(pwSAbs);
-
-      //
-      // XOR S with X
-      //
-      for (j = AZSize; j > 0 ; j--) {
-	 pwSAbs[j - 1] ^= X[j - 1];
-      } 
-    }
-
-    //
-    //Last round 
-    //
-    
-    //
-    //Set up X
-    //
-    for (j = 15; k < AZSize; j--) { 
-      X[j] = pwAZ[k];
-      k++;
-    } 
-    for (j; j > 0; j--) {
-      X[j] = 0;
-    } 
-
-    //
-    // XOR with domain and run F
-    //
-    pwSAbs[15] ^= absDomain; 
-    F(pwSAbs); 
-
-    //
-    // XOR S with X padded
-    //
-    //pad(X);
-    for (j = AZSize; j > 0; j--)
-      pwSAbs[j - 1] ^= X[j - 1];
-  } 
-}
-
-//*****************************************************************************
-//
-// Function -> branch
-// Purpose ->
-// Inputs -> word_t* pwSBrch[] - Pointer to State, 4x4 matrix of words
-//           uint32_t msgSize - Size of Message
-//           uint32_t brchDomain - Domain Constant for Branch
-//
-//*****************************************************************************
-void 
-branch(const word_t* pwSBrch, word_t* pwSBar, uint32_t msgSize, uint32_t brchDomain) {
-  //
-  // If only one lane of parallelism then just assign Sbar to S
-  //
-  if (PARALLEL == 1) {
-    pwSBrch = pwSBar;
-  } 
-  else {
-    //
-    // TODO work with P != 1
-    //
-  } 
-} 
-
-//*****************************************************************************
-//
-// Function -> encrypt
-// Purpose -> Run a given number of rounds of encryption on the given text
-// Inputs -> word_t* pwSbarEnc[] - Pointer to State, 4x4 matrix of words
-//           word_t pwM[] - Pointer to message
-//           uint32_t encDomain - Domain Constant for Encrypt
-//
-//*****************************************************************************
-void
-encrypt(word_t* pwSbarEnc, word_t* pwM, uint32_t msgSize, uint32_t encDomain, word_t* pwC) {
-  uint32_t i;
-  uint32_t m = msgSize / 12;  // given rate value based on word size
-  uint32_t b = WIDTH;  // given block length for word size
-  uint32_t j = 0;
-  uint32_t k = 0;
-  word_t X[0xF] = { 0 };
-  
-  //
-  // check if m needs to be rounded up for padding purposes
-  //
-  if (m * 12 != msgSize) {
-    m++;
-  }
-
-  //
-  // Make sure C is initialized to 0
-  //
-  for (i = 0; i < msgSize; i++) {
-    pwC[i] = 0;
-  }
-
-  if (msgSize > 0) {
-    for (i = 0; i <= m-2; i++) {
-      //
-      // Set up X, which is 12 words of pwAZ, and 4 words of 0
-      //
-      for (j = 15; j > 3; j--) { 
-        X[j] = pwAZ[k];
-        k++;
-      } 
-      for (j; j > 0; j--) {
-        X[j - 1] = 0;
-      } 
-
-      // 
-      // Keep index in realm of max state size 
-      //
-      j = i % (sizeof(pwSbarEnc) / sizeof(word_t));
-
-      //
-      // XOR with the domain and run the F permutaion
-      //
-      pwSbarEnc[15] ^= encDomain;
-      F(pwSbarEnc);
-
-      //
-      // Left truncate XOR with message 
-      //
-      for (j = 0;
-      left(pwS, 12) ^ X[i]     
-      
-    }
-  }
-}
-
-//*****************************************************************************
-//
-// Function -> decrypt
-// Purpose -> Run a given number of rounds of decryption on the given text
-// Inputs -> word_t* pwSbarDec[] - Pointer to State, 4x4 matrix of words
-//           word_t* pwC[] - Pointer to cipher text
-//           uint32_t decDomain - Domain Constant for Decrypt
-//
-//*****************************************************************************
-void
-decrypt(word_t* pwSbarDec, word_t* pwC, uint32_t msgSize, uint32_t decDomain, word_t* pwM) {
-
-}
-
-//*****************************************************************************
-//
-// Function -> F
-// Purpose -> Run F perumtation on given text
-// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
-//
-//*****************************************************************************
-void
-F(word_t* pwS) {
-  int i;
-  for (i = 0; i < RND_NUM; i++) { 
-    col(pwS);
-    diag(pwS);
-  } 
-}
-
-//*****************************************************************************
-//
-// Function -> diag
-// Purpose -> Run G function on words diaganol from each other 
-// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
-//
-//*****************************************************************************
-void 
-diag(word_t* pwS) {
-    G(pwS, 0, 5, 10, 15);
-    G(pwS, 1, 6, 11, 12);
-    G(pwS, 2, 7, 8, 13);
-    G(pwS, 3, 4, 9, 14);	
-}
-
-//*****************************************************************************
-//
-// Function -> col
-// Purpose -> Run G function on words in a collumn 
-// Input -> word_t* pwS[] -> Pointer to State, 4x4 matrix of words
-//
-//*****************************************************************************
-void 
-col(word_t* pwS) {
-    G(pwS, 0, 4, 8, 12);
-    G(pwS, 1, 5, 9, 13);
-    G(pwS, 2, 6, 10, 14);
-    G(pwS, 3, 7, 11, 15);
-}
-
-//*****************************************************************************
-//
-// Function -> G
-// Purpose -> G function of NORX
-// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
-//          uint32_t sX - Index in state of 4 words that will be operated on
-//
-//*****************************************************************************
-void 
-G(word_t* pwS, word_t s0, word_t s1, word_t s2, word_t s3) {
-    pwS[s0] = H(pwS[s0], pwS[s1]);        
-    pwS[s3] = rightRot((pwS[s0] ^ pwS[s3]), R0);  
-    pwS[s2] = H(pwS[s2], pwS[s3]);        
-    pwS[s2] = rightRot((pwS[s1] ^ pwS[s2]), R1); 
-    pwS[s1] = H(pwS[s0], pwS[s1]);        
-    pwS[s3] = rightRot((pwS[s0] ^ pwS[s3]), R2);
-    pwS[s2] = H(pwS[s2], pwS[s3]);
-    pwS[s1] = rightRot((pwS[s1] ^ pwS[s2]), R3);
-}
-
-//*****************************************************************************
-//
-// Function -> Rot()
-// Purpose -> Rotate the given value by a set shift
-// Input -> 
-//
-//*****************************************************************************
-word_t  
-rightRot(word_t value, uint32_t shift) {
-  return ((value >> shift) | (value << (32 - shift)));
-} 
-
-//*****************************************************************************
-//
-// Function -> H
-// Purpose -> H function of NORX permutation
-// Input -> word_t x,y - Words to be operated on
-//
-//*****************************************************************************
-word_t
-H(word_t x, word_t y) {
-    return (x ^ y) ^ ((x & y) << 1);
-}
-
-//*****************************************************************************
-//
-// Function -> merge
-// Purpose ->
-//
-//*****************************************************************************
-void 
-merge(word_t* pwSbarMrg, word_t* pwSMrg, uint32_t msgSize, uint32_t mrgDomain) {
-  if (PARALLEL == 1) {
-    pwSMrg = pwSbarMrg;
-  }
-  else {
-  //
-  // TODO Work with P != 1
-  //
-  }
-}
-
-//*****************************************************************************
-//
-// Function -> finalise()
-// Purpose -> 
-// Inputs -> word_t* pwSfin[] - Pointer to State; 4x4 matrix of words
-//           nkey_t K - Key
-//           uint32_t finDomain - Domain constant for finalise 
-//           word_t*  pTag[4] - Hash value of message
-//
-//*****************************************************************************
-void
-finalise(word_t* pwSFin, word_t* K, uint32_t finDomain, word_t* outTag) {
-  pwSFin[15] ^= finDomain;
-  F(pwSFin);
-
-  // (s12, s13, s14, s15) ^= k0, k1, k2, k3
-  pwSFin[12] ^= K[12];
-  pwSFin[13] ^= K[13];
-  pwSFin[14] ^= K[14];
-  pwSFin[15] ^= K[15];
-
-  F(pwSFin);
-
-  // (s12, s13, s14, s15) ^= k0, k1, k2, k3
-  pwSFin[12] ^= K[12];
-  pwSFin[13] ^= K[13];
-  pwSFin[14] ^= K[14];
-  pwSFin[15] ^= K[15];
-
-  right(pwSFin, outTag, TAG_LEN);
-}
-
-//***************************************************************************
-//
-// Function -> pad()
-// Purpose -> pad out any values that need padding
-// Inputs -> 
-//
-//***************************************************************************
-//TODO make this do something rather than just return value. Currently place holder
-word_t
-pad(word_t input) {
-  return input;
-} 
-
-//***************************************************************************
-//
-// Function -> left
-// Purpose -> Truncation of bitstring x to its r left-most bits.
-// Inputs
-// 
-//***************************************************************************
-void 
-left(word_t* pwSL, word_t* retVal, uint32_t len) {
-  int i;
-  retVal = 0;
-  uint32_t size = sizeof(pwSL) / sizeof(word_t);
-  for (i = 0; i < len; i++) {
-    retVal[len - i] = pwSL[size - i];
-  } 
-}
-
-//***************************************************************************
-//
-// Function -> right
-// Purpose -> Truncation of bitstring x to its r right-most bits.
-// Inputs
-// 
-//***************************************************************************
-void
-right(word_t* pwSR, word_t* retVal, uint32_t len) {
-  int i;
-  retVal = 0;
-  for (i = 0; i < len; i++) {
-    retVal[i] = pwSR[i];
-  } 
-}
-
+/******************************************************************************
+*                                                                             *
+* File -> NORX.c                                                              *
+* Purpose -> Encrypt and Decrypt text using the NORX algorithm                *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 03/10/2018 - Setting Up Core Permutation                     *
+*            2.0 03/11/2018 - Adding High Level Prototypes/Functions and      *
+*                              calls in main functions                        *
+*            3.0 04/07/2018 - Compiling and correcting errors                 *
+*            4.0 04/18/2018 - Fill finalise() and create right()              *
+*            5.0 04/30/2018 - Review of previous functions and corrections    * 
+*                             for functionality                               *
+*            6.0 10/17/2026 - F() runs through the SIMD kernel picked at      *
+*                             startup, fix G() word order and rotation width  *
+*            7.0 10/17/2026 - branch()/merge() for P = 2 and P = 4, encrypt() *
+*                             and decrypt() spread blocks over the lanes      *
+*            8.0 10/17/2026 - Byte NORXEnc()/NORXDec() over the stream API,   *
+*                             whole block byte loops, finalise() key words    *
+*            9.0 10/17/2026 - absorb()/encrypt()/decrypt() work in place on   *
+*                             the caller's bytes, pad() does real padding     *
+*           10.0 10/17/2026 - wipe() shared by the stream and batch code      *
+*           11.0 10/17/2026 - main() test harness replaced by NORX_bench.c    *
+*           12.0 10/17/2026 - Key schedule, NORXEnc()/NORXDec() set one up    *
+*                             and wipe it per call                            *
+*           13.0 10/17/2026 - Fused scalar block loops, state kept in locals  *
+*                             across a whole phase                            *
+*           14.0 10/17/2026 - Last block and single lane helpers for P = 0    *
+*           15.0 10/17/2026 - NORX_STATS counters in the phase functions      *
+*           16.0 10/17/2026 - verify() phase and verify first decryption,     *
+*                             constant time tagMatch()                        *
+*           17.0 10/17/2026 - Straight line path for messages of at most one  *
+*                             block per phase                                 *
+*           18.0 10/17/2026 - Non temporal stores and input prefetch for      *
+*                             payloads of at least NORXNtBytes()              *
+*           19.0 10/17/2026 - Input prefetch kept inside the input            *
+*           20.0 10/17/2026 - NORX_STATS domain counts in the block helpers,  *
+*                             so every path through them is counted           *
+*           21.0 10/17/2026 - Small messages verified first in one pass       *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stdint.h>    // uintXX_t types
+#include <string.h>    // string functions
+
+#include "NORX.h"      // NORX defines and prototypes
+#include "NORX_simd.h" // SIMD permutation kernels and dispatch
+#include "NORX_stats.h" // Optional phase counters
+
+#if defined(__GNUC__) && defined(__SSE2__) && \
+    (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define NT_STORES  0x1
+#endif
+
+//*****************************************************************************
+// Large payloads. From ntBytes on, encrypt()/decrypt() write each word with
+// a non temporal store, so the output lines are neither read for ownership
+// nor left in the cache, and prefetch the input NT_AHEAD bytes on.
+//*****************************************************************************
+#define NT_AHEAD   (8 * PARALLEL * RATE_BYTES)
+
+static size_t ntBytes = NORX_NT_BYTES;
+
+//*****************************************************************************
+//
+// Function -> NORXEnc
+// Purpose -> Run all steps needed to complete a full NORX encryption
+// Inputs -> const uint8_t* pK - Key value, KEY_BYTES
+//           const uint8_t* pN - Nonce value, NONCE_BYTES
+//           const uint8_t* pA, aLen - Message Header
+//           const uint8_t* pM, mLen - Message Text 
+//           const uint8_t* pZ, zLen - Message Footer
+//           uint8_t* pC - Cipher text, mLen bytes, may be pM
+//           uint8_t* pT - Tag, TAG_BYTES
+//
+//*****************************************************************************
+void 
+NORXEnc(const uint8_t* pK, const uint8_t* pN,
+        const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t mLen,
+        const uint8_t* pZ, size_t zLen, uint8_t* pC, uint8_t* pT) {
+    norx_key_t key;
+
+    NORXKeyInit(&key, pK);
+    NORXKeyEnc(&key, pN, pA, aLen, pM, mLen, pZ, zLen, pC, pT);
+    NORXKeyWipe(&key);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDec
+// Purpose -> Run all steps needed to complete a full NORX decryption
+// Inputs -> const uint8_t* pK - Key value, KEY_BYTES
+//           const uint8_t* pN - Nonce value, NONCE_BYTES
+//           const uint8_t* pA, aLen - Message Header
+//           const uint8_t* pC, cLen - Cipher text 
+//           const uint8_t* pZ, zLen - Message Footer
+//           const uint8_t* pT - Tag from Encryption, TAG_BYTES
+//           uint8_t* pM - Message Text, cLen bytes, may be pC
+// Returns -> true if the tag matches
+//
+//*****************************************************************************
+bool 
+NORXDec(const uint8_t* pK, const uint8_t* pN,
+        const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+        const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM) {
+    norx_key_t key;
+    bool ok;
+
+    NORXKeyInit(&key, pK);
+    ok = NORXKeyDec(&key, pN, pA, aLen, pC, cLen, pZ, zLen, pT, pM);
+    NORXKeyWipe(&key);
+
+    return ok;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSetNtBytes / NORXNtBytes
+// Purpose -> Set or read the payload size from which encrypt()/decrypt()
+//            use non temporal stores, 0 turns them off. Like NORXSetKernel()
+//            it is one setting for the whole program, set it before sealing.
+//
+//*****************************************************************************
+void
+NORXSetNtBytes(size_t bytes) {
+  ntBytes = bytes;
+}
+
+size_t
+NORXNtBytes(void) {
+  return ntBytes;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDecVerify
+// Purpose -> NORXDec() that writes no plain text unless the tag matches
+// Inputs -> Same as NORXDec()
+// Returns -> true if the tag matches, pM is untouched otherwise
+//
+//*****************************************************************************
+bool
+NORXDecVerify(const uint8_t* pK, const uint8_t* pN,
+              const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+              const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM) {
+    norx_key_t key;
+    bool ok;
+
+    NORXKeyInit(&key, pK);
+    ok = NORXKeyDecVerify(&key, pN, pA, aLen, pC, cLen, pZ, zLen, pT, pM);
+    NORXKeyWipe(&key);
+
+    return ok;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKeyInit
+// Purpose -> Build the key schedule: everything initialise() does before its
+//            F that does not depend on the nonce
+// Inputs -> norx_key_t* pKey - Key schedule to fill
+//           const uint8_t* pK - Key value, KEY_BYTES
+//
+//*****************************************************************************
+void
+NORXKeyInit(norx_key_t* pKey, const uint8_t* pK) {
+  uint32_t i;
+
+  for (i = 0; i < 4; i++) {
+    pKey->K[i] = loadWord(pK + i * WORD_BYTES);
+    pKey->S[i] = pKey->K[i];
+  }
+
+  //
+  // U8 - U15 with (12, 13, 14, 15) ^ w, l, p, t
+  //
+  pKey->S[4] = U8;
+  pKey->S[5] = U9;
+  pKey->S[6] = U10;
+  pKey->S[7] = U11;
+  pKey->S[8] = U12 ^ WORD_LEN;
+  pKey->S[9] = U13 ^ RND_NUM;
+  pKey->S[10] = U14 ^ PARALLEL;
+  pKey->S[11] = U15 ^ TAG_LEN;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKeyWipe
+// Purpose -> Clear a key schedule once it is no longer needed
+//
+//*****************************************************************************
+void
+NORXKeyWipe(norx_key_t* pKey) {
+  wipe(pKey, sizeof(*pKey));
+}
+
+//*****************************************************************************
+// Small messages. When header, payload and trailer are each shorter than a
+// rate block, every phase is exactly one padded block and NORXKeyEnc()/
+// NORXKeyDec()/NORXKeyDecVerify() take sealSmall() instead of the phase
+// functions: one F per phase, the partial block moved through one zeroed
+// block on the stack, no block loops and no lane bookkeeping. The NORX_STATS
+// build keeps the phase functions so every message is counted.
+//*****************************************************************************
+#ifdef NORX_STATS
+  #define IS_SMALL(aLen, mLen, zLen)   false
+#else
+  #define IS_SMALL(aLen, mLen, zLen)                                       \
+    ((aLen) < RATE_BYTES && (mLen) < RATE_BYTES && (zLen) < RATE_BYTES)
+#endif
+
+//*****************************************************************************
+//
+// Function -> absorbSmall
+// Purpose -> Absorb fewer than RATE_BYTES bytes as one padded block
+//
+//*****************************************************************************
+static inline void
+absorbSmall(word_t* pwS, const uint8_t* pIn, size_t len, uint32_t domain) {
+  uint8_t blk[RATE_BYTES] = { 0 };
+  uint32_t i;
+
+  memcpy(blk, pIn, len);
+  blk[len] ^= 0x01;
+  blk[RATE_BYTES - 1] ^= 0x80;
+
+  pwS[15] ^= domain;
+  F(pwS);
+  for (i = 0; i < RATE_WORDS; i++) {
+    pwS[i] ^= loadWord(blk + i * WORD_BYTES);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> sealSmall
+// Purpose -> Whole message of at most one block per phase, see IS_SMALL()
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//           const uint8_t* pA, aLen - Header, less than RATE_BYTES
+//           const uint8_t* pIn, len - Payload, less than RATE_BYTES
+//           const uint8_t* pZ, zLen - Trailer, less than RATE_BYTES
+//           uint8_t* pOut - Payload out, len bytes, may be pIn
+//           word_t* pwT - Tag words
+//           bool dec - Decrypt rather than encrypt
+//
+//*****************************************************************************
+static void
+sealSmall(const norx_key_t* pKey, const uint8_t* pN,
+          const uint8_t* pA, size_t aLen, const uint8_t* pIn, size_t len,
+          const uint8_t* pZ, size_t zLen, uint8_t* pOut, word_t* pwT,
+          bool dec) {
+  word_t S[16];                 // State, 4x4 matrix of words
+  word_t Sbar[LANES_WORDS];     // Lane states, only lane 0 gets the block
+  uint8_t blk[RATE_BYTES];
+  word_t* pwS = (PARALLEL == 1) ? S : Sbar;
+  word_t w;
+  uint32_t i;
+
+  initialiseKey(pKey, pN, S);
+  if (aLen > 0) {
+    absorbSmall(S, pA, aLen, HEADER_DOMAIN);
+  }
+
+  if (len > 0) {
+    if (PARALLEL > 1) {
+      branch(S, Sbar, len, BRANCH_DOMAIN);
+    }
+    pwS[15] ^= PAYLOAD_DOMAIN;
+    F(pwS);
+
+    //
+    // Encrypting XORs the message into the rate. Decrypting lays the cipher
+    // text over the rate, the message is what that changed.
+    //
+    if (dec) {
+      for (i = 0; i < RATE_WORDS; i++) {
+        storeWord(blk + i * WORD_BYTES, pwS[i]);
+      }
+      memcpy(blk, pIn, len);
+      for (i = 0; i < RATE_WORDS; i++) {
+        w = loadWord(blk + i * WORD_BYTES);
+        storeWord(blk + i * WORD_BYTES, w ^ pwS[i]);
+        pwS[i] = w;
+      }
+    }
+    else {
+      memset(blk, 0, sizeof(blk));
+      memcpy(blk, pIn, len);
+      for (i = 0; i < RATE_WORDS; i++) {
+        pwS[i] ^= loadWord(blk + i * WORD_BYTES);
+        storeWord(blk + i * WORD_BYTES, pwS[i]);
+      }
+    }
+    memcpy(pOut, blk, len);
+    pad(pwS, (uint32_t)len);
+
+    if (PARALLEL > 1) {
+      merge(Sbar, S, len, MERGE_DOMAIN);
+    }
+  }
+
+  if (zLen > 0) {
+    absorbSmall(S, pZ, zLen, TRAILER_DOMAIN);
+  }
+  finalise(S, pKey->K, FINAL_DOMAIN, pwT);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKeyEnc
+// Purpose -> NORXEnc() with a key schedule set up by NORXKeyInit()
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           The rest as NORXEnc()
+//
+//*****************************************************************************
+void
+NORXKeyEnc(const norx_key_t* pKey, const uint8_t* pN,
+           const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t mLen,
+           const uint8_t* pZ, size_t zLen, uint8_t* pC, uint8_t* pT) {
+    word_t S[16];                 // State, 4x4 matrix of words
+    word_t Sbar[LANES_WORDS];     // State bar, one 4x4 matrix per lane
+    word_t outT[TAG_WORDS];       // Tag words
+    uint32_t i;
+
+    if (IS_SMALL(aLen, mLen, zLen)) {
+      sealSmall(pKey, pN, pA, aLen, pM, mLen, pZ, zLen, pC, outT, false);
+    }
+    else {
+      initialiseKey(pKey, pN, S);
+      absorb(S, pA, aLen, HEADER_DOMAIN);
+      branch(S, Sbar, mLen, BRANCH_DOMAIN);
+      encrypt(Sbar, pM, mLen, PAYLOAD_DOMAIN, pC);
+      merge(Sbar, S, mLen, MERGE_DOMAIN);
+      absorb(S, pZ, zLen, TRAILER_DOMAIN);
+      finalise(S, pKey->K, FINAL_DOMAIN, outT);
+    }
+
+    for (i = 0; i < TAG_WORDS; i++) {
+      storeWord(pT + i * WORD_BYTES, outT[i]);
+    }
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKeyDec
+// Purpose -> NORXDec() with a key schedule set up by NORXKeyInit()
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           The rest as NORXDec()
+// Returns -> true if the tag matches
+//
+//*****************************************************************************
+bool
+NORXKeyDec(const norx_key_t* pKey, const uint8_t* pN,
+           const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+           const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM) {
+    word_t S[16];                 // State, 4x4 matrix of words
+    word_t Sbar[LANES_WORDS];     // State bar, one 4x4 matrix per lane
+    word_t outT[TAG_WORDS];       // Tag words
+
+    if (IS_SMALL(aLen, cLen, zLen)) {
+      sealSmall(pKey, pN, pA, aLen, pC, cLen, pZ, zLen, pM, outT, true);
+      return tagMatch(outT, pT);
+    }
+
+    initialiseKey(pKey, pN, S);
+    absorb(S, pA, aLen, HEADER_DOMAIN);
+    branch(S, Sbar, cLen, BRANCH_DOMAIN);
+    decrypt(Sbar, pC, cLen, PAYLOAD_DOMAIN, pM);
+    merge(Sbar, S, cLen, MERGE_DOMAIN);
+    absorb(S, pZ, zLen, TRAILER_DOMAIN);
+    finalise(S, pKey->K, FINAL_DOMAIN, outT);
+
+    return tagMatch(outT, pT);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKeyDecVerify
+// Purpose -> NORXKeyDec() in two passes. The first runs the state over the
+//            cipher text with verify(), which writes nothing, and checks the
+//            tag. Only if it matches does the second run decrypt() from the
+//            state after the header, so a forged message costs no writes to
+//            pM and never shows its plain text. A small message is opened
+//            by sealSmall() in one pass into a block on the stack, which is
+//            only copied to pM once the tag matches.
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           The rest as NORXDec()
+// Returns -> true if the tag matches, pM is untouched otherwise
+//
+//*****************************************************************************
+bool
+NORXKeyDecVerify(const norx_key_t* pKey, const uint8_t* pN,
+                 const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+                 const uint8_t* pZ, size_t zLen, const uint8_t* pT,
+                 uint8_t* pM) {
+    word_t S[16];                 // State, 4x4 matrix of words
+    word_t SA[16];                // State after the header
+    word_t Sbar[LANES_WORDS];     // State bar, one 4x4 matrix per lane
+    word_t outT[TAG_WORDS];       // Tag words
+    uint8_t blk[RATE_BYTES];      // Plain text of a small message
+    bool ok;
+
+    if (IS_SMALL(aLen, cLen, zLen)) {
+      sealSmall(pKey, pN, pA, aLen, pC, cLen, pZ, zLen, blk, outT, true);
+      ok = tagMatch(outT, pT);
+      if (ok && cLen > 0) {
+        memcpy(pM, blk, cLen);
+      }
+      wipe(blk, sizeof(blk));
+      return ok;
+    }
+
+    initialiseKey(pKey, pN, S);
+    absorb(S, pA, aLen, HEADER_DOMAIN);
+    memcpy(SA, S, sizeof(SA));
+    branch(S, Sbar, cLen, BRANCH_DOMAIN);
+    verify(Sbar, pC, cLen, PAYLOAD_DOMAIN);
+    merge(Sbar, S, cLen, MERGE_DOMAIN);
+    absorb(S, pZ, zLen, TRAILER_DOMAIN);
+    finalise(S, pKey->K, FINAL_DOMAIN, outT);
+
+    if (!tagMatch(outT, pT)) {
+      return false;
+    }
+
+    //
+    // The cipher text moves the state the same way again, only the plain
+    // text is new
+    //
+    branch(SA, Sbar, cLen, BRANCH_DOMAIN);
+    decrypt(Sbar, pC, cLen, PAYLOAD_DOMAIN, pM);
+
+    return true;
+}
+
+//*****************************************************************************
+//
+// Function -> initialise
+// Purpose -> 
+// Inputs -> word_t* pwKIni - Key value
+//           word_t* pwNIni - Nonce value
+//           word_t* pwSIni[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+void
+initialise(word_t* pwKIni, word_t* pwNIni, word_t* pwSIni) {
+  STATS_START(t0);
+
+  //
+  // S = N, K, U8 - U15
+  //
+  pwSIni[0] = pwNIni[0];  
+  pwSIni[1] = pwNIni[1];
+  pwSIni[2] = pwNIni[2];
+  pwSIni[3] = pwNIni[3];
+  pwSIni[4] = pwKIni[0];
+  pwSIni[5] = pwKIni[1];
+  pwSIni[6] = pwKIni[2];
+  pwSIni[7] = pwKIni[3];
+  pwSIni[8] = U8;
+  pwSIni[9] = U9;
+  pwSIni[10] = U10;
+  pwSIni[11] = U11;
+  pwSIni[12] = U12;
+  pwSIni[13] = U13;
+  pwSIni[14] = U14;
+  pwSIni[15] = U15;
+
+  //
+  // (12, 13, 14, 15) ^ w, l, p, t
+  //
+  pwSIni[12] ^= WORD_LEN;
+  pwSIni[13] ^= RND_NUM; 
+  pwSIni[14] ^= PARALLEL;
+  pwSIni[15] ^= TAG_LEN;
+
+  //
+  // Run F permutation on S
+  //
+  F(pwSIni);
+  
+  //
+  // (12, 13, 14, 15) ^ K
+  //
+  pwSIni[12] ^= pwKIni[0];
+  pwSIni[13] ^= pwKIni[1]; 
+  pwSIni[14] ^= pwKIni[2];
+  pwSIni[15] ^= pwKIni[3];
+
+  STATS_PHASE(STAT_INIT, 1, t0);
+}
+
+//*****************************************************************************
+//
+// Function -> initialiseKey
+// Purpose -> initialise() from a key schedule, only the nonce is loaded
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce value, NONCE_BYTES
+//           word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+void
+initialiseKey(const norx_key_t* pKey, const uint8_t* pN, word_t* pwS) {
+  uint32_t i;
+  STATS_START(t0);
+
+  for (i = 0; i < 4; i++) {
+    pwS[i] = loadWord(pN + i * WORD_BYTES);
+  }
+  memcpy(pwS + 4, pKey->S, sizeof(pKey->S));
+
+  F(pwS);
+
+  for (i = 0; i < 4; i++) {
+    pwS[12 + i] ^= pKey->K[i];
+  }
+
+  STATS_PHASE(STAT_INIT, 1, t0);
+}
+
+//*****************************************************************************
+//
+// Function -> absorb
+// Purpose -> Absorb a header or trailer straight from the caller's bytes.
+//            Whole blocks go through absorbBlocks(), the last partial block
+//            is XORed into the rate and padded in place.
+// Inputs -> word_t* pwSAbs[] - Pointer to State, 4x4 matrix of words
+//           const uint8_t* pAZ - Pointer to Either the Header or Footer
+//           size_t AZSize - Bytes in the Header or Footer
+//           uint32_t absDomain - Domain Constant for Absorb
+//
+//*****************************************************************************
+void 
+absorb(word_t* pwSAbs, const uint8_t* pAZ, size_t AZSize, uint32_t absDomain) {
+  size_t blocks = AZSize / RATE_BYTES;
+  uint32_t len = (uint32_t)(AZSize % RATE_BYTES);
+  uint32_t words = len / WORD_BYTES;
+  uint32_t i;
+
+  if (AZSize == 0) {
+    return;
+  } 
+
+  STATS_START(t0);
+  absorbBlocks(pwSAbs, pAZ, blocks, absDomain);
+  pAZ += blocks * RATE_BYTES;
+
+  //
+  // Last block, XOR with domain and run F then XOR in what is left
+  //
+  pwSAbs[15] ^= absDomain; 
+  F(pwSAbs); 
+
+  for (i = 0; i < words; i++) {
+    pwSAbs[i] ^= loadWord(pAZ + i * WORD_BYTES);
+  }
+  for (i = words * WORD_BYTES; i < len; i++) {
+    pwSAbs[words] ^= (word_t)pAZ[i] << (8 * (i % WORD_BYTES));
+  }
+  pad(pwSAbs, len);
+
+  STATS_DOMAIN(absDomain, 1, 1, len);
+  STATS_PHASE(STAT_ABSORB, blocks + 1, t0);
+}
+
+//*****************************************************************************
+//
+// Function -> branch
+// Purpose -> Split the state into PARALLEL lane states. Each lane is S run
+//            through F under the branch domain with its lane index XORed
+//            into the rate words, so no two lanes see the same key stream.
+// Inputs -> word_t* pwSBrch[] - Pointer to State, 4x4 matrix of words
+//           word_t* pwSBar[] - Pointer to PARALLEL lane states
+//           size_t msgSize - Size of Message
+//           uint32_t brchDomain - Domain Constant for Branch
+//
+//*****************************************************************************
+void 
+branch(const word_t* pwSBrch, word_t* pwSBar, size_t msgSize, uint32_t brchDomain) {
+  uint32_t lane;
+  uint32_t i;
+
+  //
+  // If only one lane of parallelism, or nothing to encrypt, Sbar is S
+  //
+  if (PARALLEL == 1 || msgSize == 0) {
+    memmove(pwSBar, pwSBrch, 16 * sizeof(word_t));
+    return;
+  } 
+
+  STATS_START(t0);
+  for (lane = 0; lane < PARALLEL; lane++) {
+    memcpy(pwSBar + 16 * lane, pwSBrch, 16 * sizeof(word_t));
+    pwSBar[16 * lane + 15] ^= brchDomain;
+  } 
+  FLanes(pwSBar, PARALLEL);
+
+  //
+  // Inject the lane index
+  //
+  for (lane = 0; lane < PARALLEL; lane++) {
+    for (i = 0; i < RATE_WORDS; i++) {
+      pwSBar[16 * lane + i] ^= lane;
+    }
+  }
+
+  STATS_DOMAIN(brchDomain, PARALLEL, 0, 0);
+  STATS_PHASE(STAT_BRANCH, PARALLEL, t0);
+} 
+
+//*****************************************************************************
+//
+// Function -> streamWord / streamFence
+// Purpose -> storeWord() as a non temporal store where there is one, and
+//            the fence that orders such stores before anything after them
+//
+//*****************************************************************************
+static inline void
+streamWord(uint8_t* pOut, word_t w) {
+#if defined(NT_STORES) && WORD_LEN == 32
+  _mm_stream_si32((int*)(void*)pOut, (int)w);
+#elif defined(NT_STORES) && defined(__x86_64__)
+  _mm_stream_si64((long long*)(void*)pOut, (long long)w);
+#else
+  storeWord(pOut, w);
+#endif
+}
+
+static inline void
+streamFence(void) {
+#ifdef NT_STORES
+  _mm_sfence();
+#endif
+}
+
+//*****************************************************************************
+//
+// Function -> cryptBlocksNt
+// Purpose -> encryptBlocks()/decryptBlocks() from block 0 with non temporal
+//            output. Blocks are written in order, PARALLEL at a time through
+//            FLanes(), so each output line fills up in one write combining
+//            buffer. The scalar kernel gives up its fused loop here, which
+//            writes a lane's blocks a stride apart.
+// Inputs -> word_t* pwSbar[] - Pointer to PARALLEL lane states
+//           const uint8_t* pIn - blocks * RATE_BYTES bytes in
+//           size_t blocks - Number of blocks
+//           uint32_t domain - Domain Constant for the payload
+//           uint8_t* pOut - blocks * RATE_BYTES bytes out, may be pIn
+//           bool dec - Decrypt rather than encrypt
+//
+//*****************************************************************************
+static void
+cryptBlocksNt(word_t* pwSbar, const uint8_t* pIn, size_t blocks,
+              uint32_t domain, uint8_t* pOut, bool dec) {
+  uint32_t lanes;
+  uint32_t lane;
+  uint32_t i;
+  word_t* pwS;
+  word_t c;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  while (blocks > 0) {
+    lanes = (blocks >= PARALLEL) ? PARALLEL : (uint32_t)blocks;
+
+    //
+    // Only lines still inside the input, pIn + NT_AHEAD may already be past
+    // its end
+    //
+    for (i = 0; i < lanes * RATE_BYTES &&
+                NT_AHEAD + (size_t)i < blocks * RATE_BYTES; i += 64) {
+      __builtin_prefetch(pIn + NT_AHEAD + i, 0, 0);
+    }
+
+    for (lane = 0; lane < lanes; lane++) {
+      pwSbar[16 * lane + 15] ^= domain;
+    }
+    FLanes(pwSbar, lanes);
+
+    for (lane = 0; lane < lanes; lane++) {
+      pwS = pwSbar + 16 * lane;
+      if (dec) {
+        for (i = 0; i < RATE_WORDS; i++) {
+          c = loadWord(pIn + i * WORD_BYTES);
+          streamWord(pOut + i * WORD_BYTES, pwS[i] ^ c);
+          pwS[i] = c;
+        }
+      }
+      else {
+        for (i = 0; i < RATE_WORDS; i++) {
+          pwS[i] ^= loadWord(pIn + i * WORD_BYTES);
+          streamWord(pOut + i * WORD_BYTES, pwS[i]);
+        }
+      }
+      pIn += RATE_BYTES;
+      pOut += RATE_BYTES;
+    }
+    blocks -= lanes;
+  }
+  streamFence();
+}
+
+//*****************************************************************************
+//
+// Function -> encrypt
+// Purpose -> Encrypt the message straight from M into C. Block i goes to
+//            lane i % PARALLEL, whole blocks through encryptBlocks(), and the
+//            last block, empty when the size is a multiple of the rate, is
+//            padded in the lane state. C may be the same buffer as M.
+// Inputs -> word_t* pwSbarEnc[] - Pointer to PARALLEL lane states
+//           const uint8_t* pM - Pointer to message
+//           size_t msgSize - Bytes in the message
+//           uint32_t encDomain - Domain Constant for Encrypt
+//           uint8_t* pC - Pointer to cipher text, msgSize bytes
+//
+//*****************************************************************************
+void
+encrypt(word_t* pwSbarEnc, const uint8_t* pM, size_t msgSize, uint32_t encDomain, uint8_t* pC) {
+  size_t blocks = msgSize / RATE_BYTES;
+  uint32_t len = (uint32_t)(msgSize % RATE_BYTES);
+
+  if (msgSize == 0) {
+    return;
+  }
+
+  STATS_START(t0);
+  if (ntBytes > 0 && msgSize >= ntBytes) {
+    cryptBlocksNt(pwSbarEnc, pM, blocks, encDomain, pC, false);
+  }
+  else {
+    encryptBlocks(pwSbarEnc, 0, pM, blocks, encDomain, pC);
+  }
+  pM += blocks * RATE_BYTES;
+  pC += blocks * RATE_BYTES;
+
+  //
+  // Last block on the next lane in turn
+  //
+  encryptLast(pwSbarEnc + 16 * (blocks % PARALLEL), pM, len, encDomain, pC);
+
+  STATS_PHASE(STAT_ENCRYPT, blocks + 1, t0);
+}
+
+//*****************************************************************************
+//
+// Function -> decrypt
+// Purpose -> Decrypt the cipher text straight from C into M, lanes are used
+//            the same way as in encrypt(). M may be the same buffer as C.
+// Inputs -> word_t* pwSbarDec[] - Pointer to PARALLEL lane states
+//           const uint8_t* pC - Pointer to cipher text
+//           size_t msgSize - Bytes in the cipher text
+//           uint32_t decDomain - Domain Constant for Decrypt
+//           uint8_t* pM - Pointer to message, msgSize bytes
+//
+//*****************************************************************************
+void
+decrypt(word_t* pwSbarDec, const uint8_t* pC, size_t msgSize, uint32_t decDomain, uint8_t* pM) {
+  size_t blocks = msgSize / RATE_BYTES;
+  uint32_t len = (uint32_t)(msgSize % RATE_BYTES);
+
+  if (msgSize == 0) {
+    return;
+  }
+
+  STATS_START(t0);
+  if (ntBytes > 0 && msgSize >= ntBytes) {
+    cryptBlocksNt(pwSbarDec, pC, blocks, decDomain, pM, true);
+  }
+  else {
+    decryptBlocks(pwSbarDec, 0, pC, blocks, decDomain, pM);
+  }
+  pC += blocks * RATE_BYTES;
+  pM += blocks * RATE_BYTES;
+
+  decryptLast(pwSbarDec + 16 * (blocks % PARALLEL), pC, len, decDomain, pM);
+
+  STATS_PHASE(STAT_DECRYPT, blocks + 1, t0);
+}
+
+//*****************************************************************************
+//
+// Function -> verify
+// Purpose -> Move the lane states over the cipher text the way decrypt()
+//            does without producing the message. Decryption puts the
+//            cipher text in the rate, so the state never needs the plain
+//            text and nothing is written. Counted as decrypt().
+// Inputs -> word_t* pwSbarVer[] - Pointer to PARALLEL lane states
+//           const uint8_t* pC - Pointer to cipher text
+//           size_t msgSize - Bytes in the cipher text
+//           uint32_t verDomain - Domain Constant for Decrypt
+//
+//*****************************************************************************
+void
+verify(word_t* pwSbarVer, const uint8_t* pC, size_t msgSize, uint32_t verDomain) {
+  size_t blocks = msgSize / RATE_BYTES;
+  uint32_t len = (uint32_t)(msgSize % RATE_BYTES);
+
+  if (msgSize == 0) {
+    return;
+  }
+
+  STATS_START(t0);
+  verifyBlocks(pwSbarVer, 0, pC, blocks, verDomain);
+  pC += blocks * RATE_BYTES;
+
+  verifyLast(pwSbarVer + 16 * (blocks % PARALLEL), pC, len, verDomain);
+
+  STATS_PHASE(STAT_DECRYPT, blocks + 1, t0);
+}
+
+//*****************************************************************************
+// Fused scalar block loops. The state sits in the locals s0..s15 for a whole
+// run of blocks instead of going through F() -> col()/diag() -> G() per block,
+// so the compiler can keep it in registers between blocks.
+//*****************************************************************************
+#define FUSED_ROT(x, n)   (((x) >> (n)) | ((x) << (WORD_LEN - (n))))
+#define FUSED_H(x, y)     (((x) ^ (y)) ^ (((x) & (y)) << 1))
+
+#define FUSED_G(a, b, c, d)                \
+  do {                                     \
+    a = FUSED_H(a, b);                     \
+    d = FUSED_ROT(a ^ d, R0);              \
+    c = FUSED_H(c, d);                     \
+    b = FUSED_ROT(b ^ c, R1);              \
+    a = FUSED_H(a, b);                     \
+    d = FUSED_ROT(a ^ d, R2);              \
+    c = FUSED_H(c, d);                     \
+    b = FUSED_ROT(b ^ c, R3);              \
+  } while (0)
+
+#define FUSED_F()                          \
+  do {                                     \
+    uint32_t rnd;                          \
+    for (rnd = 0; rnd < RND_NUM; rnd++) {  \
+      FUSED_G(s0, s4, s8, s12);            \
+      FUSED_G(s1, s5, s9, s13);            \
+      FUSED_G(s2, s6, s10, s14);           \
+      FUSED_G(s3, s7, s11, s15);           \
+      FUSED_G(s0, s5, s10, s15);           \
+      FUSED_G(s1, s6, s11, s12);           \
+      FUSED_G(s2, s7, s8, s13);            \
+      FUSED_G(s3, s4, s9, s14);            \
+    }                                      \
+  } while (0)
+
+#define FUSED_LOAD(pwS)                                                  \
+  word_t s0 = (pwS)[0], s1 = (pwS)[1], s2 = (pwS)[2], s3 = (pwS)[3];     \
+  word_t s4 = (pwS)[4], s5 = (pwS)[5], s6 = (pwS)[6], s7 = (pwS)[7];     \
+  word_t s8 = (pwS)[8], s9 = (pwS)[9], s10 = (pwS)[10], s11 = (pwS)[11]; \
+  word_t s12 = (pwS)[12], s13 = (pwS)[13], s14 = (pwS)[14];              \
+  word_t s15 = (pwS)[15]
+
+#define FUSED_STORE(pwS)                                                 \
+  do {                                                                   \
+    (pwS)[0] = s0; (pwS)[1] = s1; (pwS)[2] = s2; (pwS)[3] = s3;          \
+    (pwS)[4] = s4; (pwS)[5] = s5; (pwS)[6] = s6; (pwS)[7] = s7;          \
+    (pwS)[8] = s8; (pwS)[9] = s9; (pwS)[10] = s10; (pwS)[11] = s11;      \
+    (pwS)[12] = s12; (pwS)[13] = s13; (pwS)[14] = s14; (pwS)[15] = s15;  \
+  } while (0)
+
+//
+// Run OP(i, si) over the RATE_WORDS = 12 rate words
+//
+#define FUSED_RATE(OP)                                                   \
+  do {                                                                   \
+    OP(0, s0); OP(1, s1); OP(2, s2); OP(3, s3);                          \
+    OP(4, s4); OP(5, s5); OP(6, s6); OP(7, s7);                          \
+    OP(8, s8); OP(9, s9); OP(10, s10); OP(11, s11);                      \
+  } while (0)
+
+#define FUSED_ABSORB(i, s)   s ^= loadWord(pIn + (i) * WORD_BYTES)
+#define FUSED_ENCRYPT(i, s)                                              \
+  do {                                                                   \
+    s ^= loadWord(pIn + (i) * WORD_BYTES);                               \
+    storeWord(pOut + (i) * WORD_BYTES, s);                               \
+  } while (0)
+#define FUSED_DECRYPT(i, s)                                              \
+  do {                                                                   \
+    word_t c = loadWord(pIn + (i) * WORD_BYTES);                         \
+    storeWord(pOut + (i) * WORD_BYTES, s ^ c);                           \
+    s = c;                                                               \
+  } while (0)
+#define FUSED_VERIFY(i, s)   s = loadWord(pIn + (i) * WORD_BYTES)
+
+#if RATE_WORDS != 12
+  #error "FUSED_RATE() is written out for 12 rate words"
+#endif
+
+//*****************************************************************************
+//
+// Function -> absorbFused
+// Purpose -> absorbBlocks() for the scalar kernel, state held in locals
+// Inputs -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//           const uint8_t* pIn - blocks * RATE_BYTES bytes
+//           size_t blocks - Number of blocks
+//           uint32_t domain - Domain Constant for Absorb
+//
+//*****************************************************************************
+static void
+absorbFused(word_t* pwS, const uint8_t* pIn, size_t blocks, uint32_t domain) {
+  FUSED_LOAD(pwS);
+
+  for (; blocks > 0; blocks--) {
+    s15 ^= domain;
+    FUSED_F();
+    FUSED_RATE(FUSED_ABSORB);
+    pIn += RATE_BYTES;
+  }
+  FUSED_STORE(pwS);
+}
+
+//*****************************************************************************
+//
+// Function -> encryptFused
+// Purpose -> Encrypt blocks on one lane for the scalar kernel, state held in
+//            locals. Blocks are stride bytes apart so a lane can take every
+//            PARALLEL'th block of the payload in one go.
+// Inputs -> word_t* pwS[] - Pointer to the lane's State
+//           const uint8_t* pIn - First block of message
+//           size_t blocks - Number of blocks
+//           size_t stride - Bytes from one block of the lane to the next
+//           uint32_t domain - Domain Constant for Encrypt
+//           uint8_t* pOut - First block of cipher text
+//
+//*****************************************************************************
+static void
+encryptFused(word_t* pwS, const uint8_t* pIn, size_t blocks, size_t stride,
+             uint32_t domain, uint8_t* pOut) {
+  FUSED_LOAD(pwS);
+
+  for (; blocks > 0; blocks--) {
+    s15 ^= domain;
+    FUSED_F();
+    FUSED_RATE(FUSED_ENCRYPT);
+    pIn += stride;
+    pOut += stride;
+  }
+  FUSED_STORE(pwS);
+}
+
+//*****************************************************************************
+//
+// Function -> decryptFused
+// Purpose -> Inverse of encryptFused()
+// Inputs -> Same as encryptFused() with cipher text in and message out
+//
+//*****************************************************************************
+static void
+decryptFused(word_t* pwS, const uint8_t* pIn, size_t blocks, size_t stride,
+             uint32_t domain, uint8_t* pOut) {
+  FUSED_LOAD(pwS);
+
+  for (; blocks > 0; blocks--) {
+    s15 ^= domain;
+    FUSED_F();
+    FUSED_RATE(FUSED_DECRYPT);
+    pIn += stride;
+    pOut += stride;
+  }
+  FUSED_STORE(pwS);
+}
+
+//*****************************************************************************
+//
+// Function -> verifyFused
+// Purpose -> decryptFused() without the message, the rate is just replaced
+// Inputs -> Same as decryptFused() less the output
+//
+//*****************************************************************************
+static void
+verifyFused(word_t* pwS, const uint8_t* pIn, size_t blocks, size_t stride,
+            uint32_t domain) {
+  FUSED_LOAD(pwS);
+
+  for (; blocks > 0; blocks--) {
+    s15 ^= domain;
+    FUSED_F();
+    FUSED_RATE(FUSED_VERIFY);
+    pIn += stride;
+  }
+  FUSED_STORE(pwS);
+}
+
+//*****************************************************************************
+//
+// Function -> absorbBlocks
+// Purpose -> Absorb whole rate blocks read straight from the caller's bytes,
+//            no padding, the caller deals with the last block. The scalar
+//            kernel goes through the fused loop in absorbFused().
+// Inputs -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//           const uint8_t* pIn - blocks * RATE_BYTES bytes
+//           size_t blocks - Number of blocks
+//           uint32_t domain - Domain Constant for Absorb
+//
+//*****************************************************************************
+void
+absorbBlocks(word_t* pwS, const uint8_t* pIn, size_t blocks, uint32_t domain) {
+  uint32_t i;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  if (pfnPermute == FScalar) {
+    absorbFused(pwS, pIn, blocks, domain);
+    return;
+  }
+
+  for (; blocks > 0; blocks--) {
+    pwS[15] ^= domain;
+    F(pwS);
+    for (i = 0; i < RATE_WORDS; i++) {
+      pwS[i] ^= loadWord(pIn + i * WORD_BYTES);
+    }
+    pIn += RATE_BYTES;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> encryptBlocks
+// Purpose -> Encrypt whole rate blocks from and to the caller's bytes. Block
+//            n goes to lane n % PARALLEL, and a run of PARALLEL blocks
+//            starting on lane 0 shares one FLanes() call. pOut may be pIn.
+//            The scalar kernel runs each lane's blocks through encryptFused()
+//            instead, lanes never touch each other between branch and merge.
+// Inputs -> word_t* pwSbar[] - Pointer to PARALLEL lane states
+//           uint64_t first - Index of the first block in the payload
+//           const uint8_t* pIn - blocks * RATE_BYTES bytes of message
+//           size_t blocks - Number of blocks
+//           uint32_t domain - Domain Constant for Encrypt
+//           uint8_t* pOut - blocks * RATE_BYTES bytes of cipher text
+//
+//*****************************************************************************
+void
+encryptBlocks(word_t* pwSbar, uint64_t first, const uint8_t* pIn,
+              size_t blocks, uint32_t domain, uint8_t* pOut) {
+  uint32_t lanes;
+  uint32_t lane;
+  uint32_t i;
+  word_t* pwS;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  if (pfnPermute == FScalar) {
+    for (i = 0; i < PARALLEL && i < blocks; i++) {
+      encryptFused(pwSbar + 16 * ((first + i) % PARALLEL), pIn + i * RATE_BYTES,
+           (blocks - i + PARALLEL - 1) / PARALLEL, PARALLEL * RATE_BYTES,
+           domain, pOut + i * RATE_BYTES);
+    }
+    return;
+  }
+
+  while (blocks > 0) {
+    lane = (uint32_t)(first % PARALLEL);
+    lanes = (lane == 0 && blocks >= PARALLEL) ? PARALLEL : 1;
+
+    for (i = 0; i < lanes; i++) {
+      pwSbar[16 * (lane + i) + 15] ^= domain;
+    }
+    FLanes(pwSbar + 16 * lane, lanes);
+
+    for (; lanes > 0; lanes--) {
+      pwS = pwSbar + 16 * lane;
+      for (i = 0; i < RATE_WORDS; i++) {
+        pwS[i] ^= loadWord(pIn + i * WORD_BYTES);
+        storeWord(pOut + i * WORD_BYTES, pwS[i]);
+      }
+      pIn += RATE_BYTES;
+      pOut += RATE_BYTES;
+      lane++;
+      first++;
+      blocks--;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> decryptBlocks
+// Purpose -> Inverse of encryptBlocks(), pOut may be pIn, the scalar kernel
+//            goes through decryptFused()
+// Inputs -> Same as encryptBlocks() with cipher text in and message out
+//
+//*****************************************************************************
+void
+decryptBlocks(word_t* pwSbar, uint64_t first, const uint8_t* pIn,
+              size_t blocks, uint32_t domain, uint8_t* pOut) {
+  uint32_t lanes;
+  uint32_t lane;
+  uint32_t i;
+  word_t* pwS;
+  word_t c;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  if (pfnPermute == FScalar) {
+    for (i = 0; i < PARALLEL && i < blocks; i++) {
+      decryptFused(pwSbar + 16 * ((first + i) % PARALLEL), pIn + i * RATE_BYTES,
+           (blocks - i + PARALLEL - 1) / PARALLEL, PARALLEL * RATE_BYTES,
+           domain, pOut + i * RATE_BYTES);
+    }
+    return;
+  }
+
+  while (blocks > 0) {
+    lane = (uint32_t)(first % PARALLEL);
+    lanes = (lane == 0 && blocks >= PARALLEL) ? PARALLEL : 1;
+
+    for (i = 0; i < lanes; i++) {
+      pwSbar[16 * (lane + i) + 15] ^= domain;
+    }
+    FLanes(pwSbar + 16 * lane, lanes);
+
+    for (; lanes > 0; lanes--) {
+      pwS = pwSbar + 16 * lane;
+      for (i = 0; i < RATE_WORDS; i++) {
+        c = loadWord(pIn + i * WORD_BYTES);
+        storeWord(pOut + i * WORD_BYTES, pwS[i] ^ c);
+        pwS[i] = c;
+      }
+      pIn += RATE_BYTES;
+      pOut += RATE_BYTES;
+      lane++;
+      first++;
+      blocks--;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> verifyBlocks
+// Purpose -> decryptBlocks() without the message: the cipher text words
+//            replace the rate and nothing is written, the scalar kernel goes
+//            through verifyFused()
+// Inputs -> Same as decryptBlocks() less the output
+//
+//*****************************************************************************
+void
+verifyBlocks(word_t* pwSbar, uint64_t first, const uint8_t* pIn,
+             size_t blocks, uint32_t domain) {
+  uint32_t lanes;
+  uint32_t lane;
+  uint32_t i;
+  word_t* pwS;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  if (pfnPermute == FScalar) {
+    for (i = 0; i < PARALLEL && i < blocks; i++) {
+      verifyFused(pwSbar + 16 * ((first + i) % PARALLEL), pIn + i * RATE_BYTES,
+           (blocks - i + PARALLEL - 1) / PARALLEL, PARALLEL * RATE_BYTES,
+           domain);
+    }
+    return;
+  }
+
+  while (blocks > 0) {
+    lane = (uint32_t)(first % PARALLEL);
+    lanes = (lane == 0 && blocks >= PARALLEL) ? PARALLEL : 1;
+
+    for (i = 0; i < lanes; i++) {
+      pwSbar[16 * (lane + i) + 15] ^= domain;
+    }
+    FLanes(pwSbar + 16 * lane, lanes);
+
+    for (; lanes > 0; lanes--) {
+      pwS = pwSbar + 16 * lane;
+      for (i = 0; i < RATE_WORDS; i++) {
+        pwS[i] = loadWord(pIn + i * WORD_BYTES);
+      }
+      pIn += RATE_BYTES;
+      lane++;
+      first++;
+      blocks--;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> encryptLast
+// Purpose -> Encrypt the last block of a lane, XOR with the domain, run F,
+//            XOR in the len bytes left and pad
+// Inputs -> word_t* pwS[] - Pointer to the lane's State
+//           const uint8_t* pM - Pointer to message, len bytes
+//           uint32_t len - Bytes left, less than RATE_BYTES
+//           uint32_t domain - Domain Constant for Encrypt
+//           uint8_t* pC - Pointer to cipher text, len bytes
+//
+//*****************************************************************************
+void
+encryptLast(word_t* pwS, const uint8_t* pM, uint32_t len, uint32_t domain,
+            uint8_t* pC) {
+  uint32_t words = len / WORD_BYTES;
+  uint32_t i;
+
+  STATS_DOMAIN(domain, 1, 1, len);
+  pwS[15] ^= domain;
+  F(pwS);
+
+  for (i = 0; i < words; i++) {
+    pwS[i] ^= loadWord(pM + i * WORD_BYTES);
+    storeWord(pC + i * WORD_BYTES, pwS[i]);
+  }
+  for (i = words * WORD_BYTES; i < len; i++) {
+    pwS[words] ^= (word_t)pM[i] << (8 * (i % WORD_BYTES));
+    pC[i] = (uint8_t)(pwS[words] >> (8 * (i % WORD_BYTES)));
+  }
+  pad(pwS, len);
+}
+
+//*****************************************************************************
+//
+// Function -> decryptLast
+// Purpose -> Inverse of encryptLast()
+// Inputs -> Same as encryptLast() with cipher text in and message out
+//
+//*****************************************************************************
+void
+decryptLast(word_t* pwS, const uint8_t* pC, uint32_t len, uint32_t domain,
+            uint8_t* pM) {
+  uint32_t words = len / WORD_BYTES;
+  uint32_t i;
+  word_t c;
+  uint8_t m;
+
+  STATS_DOMAIN(domain, 1, 1, len);
+  pwS[15] ^= domain;
+  F(pwS);
+
+  //
+  // The cipher text takes the place of the rate it covers
+  //
+  for (i = 0; i < words; i++) {
+    c = loadWord(pC + i * WORD_BYTES);
+    storeWord(pM + i * WORD_BYTES, pwS[i] ^ c);
+    pwS[i] = c;
+  }
+  for (i = words * WORD_BYTES; i < len; i++) {
+    m = pC[i] ^ (uint8_t)(pwS[words] >> (8 * (i % WORD_BYTES)));
+    pM[i] = m;
+    pwS[words] ^= (word_t)m << (8 * (i % WORD_BYTES));
+  }
+  pad(pwS, len);
+}
+
+//*****************************************************************************
+//
+// Function -> verifyLast
+// Purpose -> decryptLast() without the message, the len cipher text bytes
+//            take the place of the rate bytes they cover
+// Inputs -> Same as decryptLast() less the output
+//
+//*****************************************************************************
+void
+verifyLast(word_t* pwS, const uint8_t* pC, uint32_t len, uint32_t domain) {
+  uint32_t words = len / WORD_BYTES;
+  uint32_t shift;
+  uint32_t i;
+
+  STATS_DOMAIN(domain, 1, 1, len);
+  pwS[15] ^= domain;
+  F(pwS);
+
+  for (i = 0; i < words; i++) {
+    pwS[i] = loadWord(pC + i * WORD_BYTES);
+  }
+  for (i = words * WORD_BYTES; i < len; i++) {
+    shift = 8 * (i % WORD_BYTES);
+    pwS[words] = (pwS[words] & ~((word_t)0xff << shift)) |
+                 ((word_t)pC[i] << shift);
+  }
+  pad(pwS, len);
+}
+
+//*****************************************************************************
+//
+// Function -> encryptLane
+// Purpose -> Encrypt a whole payload on one lane state, whatever PARALLEL
+//            is. Used by the chunked lanes in NORX_pool.c, where every chunk
+//            of the payload is its own lane.
+// Inputs -> word_t* pwS[] - Pointer to the lane's State
+//           const uint8_t* pM - Pointer to message
+//           size_t msgSize - Bytes in the message, not 0
+//           uint32_t domain - Domain Constant for Encrypt
+//           uint8_t* pC - Pointer to cipher text, msgSize bytes, may be pM
+//
+//*****************************************************************************
+void
+encryptLane(word_t* pwS, const uint8_t* pM, size_t msgSize, uint32_t domain,
+            uint8_t* pC) {
+  size_t blocks = msgSize / RATE_BYTES;
+  uint32_t i;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  if (pfnPermute == FScalar) {
+    encryptFused(pwS, pM, blocks, RATE_BYTES, domain, pC);
+    pM += blocks * RATE_BYTES;
+    pC += blocks * RATE_BYTES;
+  }
+  else {
+    for (; blocks > 0; blocks--) {
+      pwS[15] ^= domain;
+      F(pwS);
+      for (i = 0; i < RATE_WORDS; i++) {
+        pwS[i] ^= loadWord(pM + i * WORD_BYTES);
+        storeWord(pC + i * WORD_BYTES, pwS[i]);
+      }
+      pM += RATE_BYTES;
+      pC += RATE_BYTES;
+    }
+  }
+  encryptLast(pwS, pM, (uint32_t)(msgSize % RATE_BYTES), domain, pC);
+}
+
+//*****************************************************************************
+//
+// Function -> decryptLane
+// Purpose -> Inverse of encryptLane()
+// Inputs -> Same as encryptLane() with cipher text in and message out
+//
+//*****************************************************************************
+void
+decryptLane(word_t* pwS, const uint8_t* pC, size_t msgSize, uint32_t domain,
+            uint8_t* pM) {
+  size_t blocks = msgSize / RATE_BYTES;
+  uint32_t i;
+  word_t c;
+
+  STATS_DOMAIN(domain, blocks, blocks, blocks * RATE_BYTES);
+  if (pfnPermute == FScalar) {
+    decryptFused(pwS, pC, blocks, RATE_BYTES, domain, pM);
+    pC += blocks * RATE_BYTES;
+    pM += blocks * RATE_BYTES;
+  }
+  else {
+    for (; blocks > 0; blocks--) {
+      pwS[15] ^= domain;
+      F(pwS);
+      for (i = 0; i < RATE_WORDS; i++) {
+        c = loadWord(pC + i * WORD_BYTES);
+        storeWord(pM + i * WORD_BYTES, pwS[i] ^ c);
+        pwS[i] = c;
+      }
+      pC += RATE_BYTES;
+      pM += RATE_BYTES;
+    }
+  }
+  decryptLast(pwS, pC, (uint32_t)(msgSize % RATE_BYTES), domain, pM);
+}
+
+//*****************************************************************************
+//
+// Function -> F
+// Purpose -> Run F perumtation on given text through the kernel picked by
+//            NORXSelectKernel() for this CPU
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+void
+F(word_t* pwS) {
+  pfnPermute(pwS);
+}
+
+//*****************************************************************************
+//
+// Function -> FScalar
+// Purpose -> Portable F permutation, used when no SIMD kernel fits the CPU
+//            and as the reference the SIMD kernels must match
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+void
+FScalar(word_t* pwS) {
+  int i;
+  for (i = 0; i < RND_NUM; i++) { 
+    col(pwS);
+    diag(pwS);
+  } 
+}
+
+//*****************************************************************************
+//
+// Function -> diag
+// Purpose -> Run G function on words diaganol from each other 
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+void 
+diag(word_t* pwS) {
+    G(pwS, 0, 5, 10, 15);
+    G(pwS, 1, 6, 11, 12);
+    G(pwS, 2, 7, 8, 13);
+    G(pwS, 3, 4, 9, 14);	
+}
+
+//*****************************************************************************
+//
+// Function -> col
+// Purpose -> Run G function on words in a collumn 
+// Input -> word_t* pwS[] -> Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+void 
+col(word_t* pwS) {
+    G(pwS, 0, 4, 8, 12);
+    G(pwS, 1, 5, 9, 13);
+    G(pwS, 2, 6, 10, 14);
+    G(pwS, 3, 7, 11, 15);
+}
+
+//*****************************************************************************
+//
+// Function -> G
+// Purpose -> G function of NORX
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//          uint32_t sX - Index in state of 4 words that will be operated on
+//
+//*****************************************************************************
+void 
+G(word_t* pwS, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3) {
+    pwS[s0] = H(pwS[s0], pwS[s1]);        
+    pwS[s3] = rightRot((pwS[s0] ^ pwS[s3]), R0);  
+    pwS[s2] = H(pwS[s2], pwS[s3]);        
+    pwS[s1] = rightRot((pwS[s1] ^ pwS[s2]), R1); 
+    pwS[s0] = H(pwS[s0], pwS[s1]);        
+    pwS[s3] = rightRot((pwS[s0] ^ pwS[s3]), R2);
+    pwS[s2] = H(pwS[s2], pwS[s3]);
+    pwS[s1] = rightRot((pwS[s1] ^ pwS[s2]), R3);
+}
+
+//*****************************************************************************
+//
+// Function -> Rot()
+// Purpose -> Rotate the given value by a set shift
+// Input -> 
+//
+//*****************************************************************************
+word_t  
+rightRot(word_t value, uint32_t shift) {
+  return ((value >> shift) | (value << (WORD_LEN - shift)));
+} 
+
+//*****************************************************************************
+//
+// Function -> H
+// Purpose -> H function of NORX permutation
+// Input -> word_t x,y - Words to be operated on
+//
+//*****************************************************************************
+word_t
+H(word_t x, word_t y) {
+    return (x ^ y) ^ ((x & y) << 1);
+}
+
+//*****************************************************************************
+//
+// Function -> merge
+// Purpose -> Fold the lane states back into one. Each lane is run through F
+//            under the merge domain and the results are XORed together.
+// Inputs -> word_t* pwSbarMrg[] - Pointer to PARALLEL lane states
+//           word_t* pwSMrg[] - Pointer to State, 4x4 matrix of words
+//           size_t msgSize - Size of Message
+//           uint32_t mrgDomain - Domain Constant for Merge
+//
+//*****************************************************************************
+void 
+merge(word_t* pwSbarMrg, word_t* pwSMrg, size_t msgSize, uint32_t mrgDomain) {
+  uint32_t lane;
+  uint32_t i;
+
+  if (PARALLEL == 1 || msgSize == 0) {
+    memmove(pwSMrg, pwSbarMrg, 16 * sizeof(word_t));
+    return;
+  }
+
+  STATS_START(t0);
+  for (lane = 0; lane < PARALLEL; lane++) {
+    pwSbarMrg[16 * lane + 15] ^= mrgDomain;
+  }
+  FLanes(pwSbarMrg, PARALLEL);
+
+  for (i = 0; i < 16; i++) {
+    pwSMrg[i] = 0;
+    for (lane = 0; lane < PARALLEL; lane++) {
+      pwSMrg[i] ^= pwSbarMrg[16 * lane + i];
+    }
+  }
+
+  STATS_DOMAIN(mrgDomain, PARALLEL, 0, 0);
+  STATS_PHASE(STAT_MERGE, PARALLEL, t0);
+}
+
+//*****************************************************************************
+//
+// Function -> finalise()
+// Purpose -> 
+// Inputs -> word_t* pwSfin[] - Pointer to State; 4x4 matrix of words
+//           nkey_t K - Key
+//           uint32_t finDomain - Domain constant for finalise 
+//           word_t*  pTag[4] - Hash value of message
+//
+//*****************************************************************************
+void
+finalise(word_t* pwSFin, const word_t* K, uint32_t finDomain, word_t* outTag) {
+  STATS_START(t0);
+
+  pwSFin[15] ^= finDomain;
+  F(pwSFin);
+
+  // (s12, s13, s14, s15) ^= k0, k1, k2, k3
+  pwSFin[12] ^= K[0];
+  pwSFin[13] ^= K[1];
+  pwSFin[14] ^= K[2];
+  pwSFin[15] ^= K[3];
+
+  F(pwSFin);
+
+  // (s12, s13, s14, s15) ^= k0, k1, k2, k3
+  pwSFin[12] ^= K[0];
+  pwSFin[13] ^= K[1];
+  pwSFin[14] ^= K[2];
+  pwSFin[15] ^= K[3];
+
+  right(pwSFin, outTag, TAG_WORDS);
+
+  STATS_DOMAIN(finDomain, 2, 0, TAG_BYTES);
+  STATS_PHASE(STAT_FINALISE, 2, t0);
+}
+
+//***************************************************************************
+//
+// Function -> pad()
+// Purpose -> 10*1 padding of the last block, XORed into the rate in place:
+//            0x01 on the byte after the data, 0x80 on the last rate byte
+// Inputs -> word_t* pwS[] - Pointer to State the block was XORed into
+//           uint32_t len - Bytes of data in the block, less than RATE_BYTES
+//
+//***************************************************************************
+void
+pad(word_t* pwS, uint32_t len) {
+  pwS[len / WORD_BYTES] ^= (word_t)0x01 << (8 * (len % WORD_BYTES));
+  pwS[RATE_WORDS - 1] ^= (word_t)0x80 << (WORD_LEN - 8);
+} 
+
+//***************************************************************************
+//
+// Function -> left
+// Purpose -> Truncation of bitstring x to its r left-most bits.
+// Inputs
+// 
+//***************************************************************************
+void 
+left(word_t* pwSL, word_t* retVal, uint32_t len) {
+  uint32_t i;
+  for (i = 0; i < len; i++) {
+    retVal[i] = pwSL[i];
+  } 
+}
+
+//***************************************************************************
+//
+// Function -> right
+// Purpose -> Truncation of bitstring x to its r right-most bits.
+// Inputs
+// 
+//***************************************************************************
+void
+right(word_t* pwSR, word_t* retVal, uint32_t len) {
+  uint32_t i;
+  for (i = 0; i < len; i++) {
+    retVal[i] = pwSR[16 - len + i];
+  } 
+}
+
+//***************************************************************************
+//
+// Function -> wipe
+// Purpose -> Clear key material in a way the compiler can not drop
+// Inputs -> void* p - Memory to clear
+//           size_t len - Bytes to clear
+//
+//***************************************************************************
+void
+wipe(void* p, size_t len) {
+  volatile uint8_t* pV = (volatile uint8_t*)p;
+
+  while (len-- > 0) {
+    *pV++ = 0;
+  }
+}
+
+//***************************************************************************
+//
+// Function -> tagMatch
+// Purpose -> Compare a computed tag with the one given in constant time:
+//            every word is looked at and the differences are ORed together
+//            through a volatile, so there is no early exit for the compiler
+//            to put back
+// Inputs -> const word_t* pwT - Tag words from finalise()
+//           const uint8_t* pT - Tag to check, TAG_BYTES
+// Returns -> true if they match
+//
+//***************************************************************************
+bool
+tagMatch(const word_t* pwT, const uint8_t* pT) {
+  volatile word_t diff = 0;
+  uint32_t i;
+
+  for (i = 0; i < TAG_WORDS; i++) {
+    diff |= pwT[i] ^ loadWord(pT + i * WORD_BYTES);
+  }
+  return diff == 0;
+}
+
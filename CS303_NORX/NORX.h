@@ -1,155 +1,373 @@
-/******************************************************************************
-*                                                                             *
-* File -> NORX.h                                                              *
-* Purpose -> Header file to encrypt and decrypt the NORX algoritm             *
-* Author -> Joseph Kroeker                                                    *
-* Version -> 1.0 03/10/2018 - Setting Up Core Permutation, and Defining       *
-*                             Constants (3 hours)                             *
-*            2.0 03/11/2018 - Adding High Level Prototypes/Functions          * 
-*                                                                             *
-******************************************************************************/
-
-//TODO check constants (I don't trust me)
-//TODO Add ifdef for 32 bit words and constants for 64 bit
-
-#include <stdint.h>
-
-//*****************************************************************************
-//
-// If flag for 32 bit words is defined go through 32 bit defines
-//
-//*****************************************************************************
-#ifdef WORD_32
-  //***************************************************************************
-  // Define Overall Parameters
-  //***************************************************************************
-  #define WORD_LEN  32              // Word size of 32 bits  
-  #define RND_NUM   4               // 4 rounds to be run
-  #define PARALLEL  1               // Parallelism degree of 1
-  #define TAG_LEN   4 * WORD_LEN    // Tag size of 4 words
-
-
-  //***************************************************************************
-  // Defines for block length and rate for 32 bits
-  //***************************************************************************
-  #define WIDTH    512
-  #define RATE     384
-  #define CAP      128
-
-  //***************************************************************************
-  // Define Shifts for G Function for 32 Bits
-  //***************************************************************************
-  #define R0        8   
-  #define R1        11
-  #define R2        16
-  #define R3        31
-
-  //***************************************************************************
-  // Define Initialisation Constants for 32 Bits
-  //***************************************************************************
-  #define U0        0x0454edab
-  #define U1        0xac6851cc
-  #define U2        0xb707322f
-  #define U3        0xa0c7c90d
-  #define U4        0x99ab09ac
-  #define U5        0xa643466d
-  #define U6        0x21c22362
-  #define U7        0x1230c950
-  #define U8        0xa3d8d930
-  #define U9        0x3fa8b72c
-  #define U10       0xed84eb49
-  #define U11       0xedca4787
-  #define U12       0x335463eb
-  #define U13       0xf994220b
-  #define U14       0xbe0bf5c9
-  #define U15       0xd7c49104
-
-  //***************************************************************************
-  // Define Word Type for 32 Bits
-  //***************************************************************************
-  typedef uint32_t word_t;     // 32 bit words 
-
-//*****************************************************************************
-//
-// If flag for 32 bit words is not set then go through 64 bit set up
-//
-//*****************************************************************************
-#else 
-  //***************************************************************************
-  // Define Overall Parameters
-  //***************************************************************************
-  #define WORD_LEN  64              // Word size of 32 bits  
-  #define RND_NUM   4               // 4 rounds to be run
-  #define PARALLEL  1               // Parallelism degree of 1
-  #define TAG_LEN   4               // Tag size of 4 words
-
-  //***************************************************************************
-  // Define Shifts for G Function for 64 Bits
-  //***************************************************************************
-  #define R0        8   
-  #define R1        19
-  #define R2        40
-  #define R3        63
-
-  //***************************************************************************
-  // Define Initialisation Constants for 64 Bits
-  //***************************************************************************
-  #define U0        0xe4d324772b91df79
-  #define U1        0x3aec9abaaeb02ccb
-  #define U2        0x9dfba13db4289311
-  #define U3        0xef9eb4bf5a97f2c8
-  #define U4        0x3f466e92c1532034
-  #define U5        0xe6e986626cc405c1
-  #define U6        0xace40f3b549184e1
-  #define U7        0xd9cfd35762614477
-  #define U8        0xb15e641748de5e6b
-  #define U9        0xaa95e955e10f8410
-  #define U10       0x28d1034441a9dd40
-  #define U11       0x7f31bbf964e93bf5
-  #define U12       0xb5e9e22493dffb96
-  #define U13       0xb980c852479fafbd
-  #define U14       0xda24516bf55eafd4
-  #define U15       0x86026ae8536f1501
-
-  //***************************************************************************
-  // Define Word Type for 64 Bits
-  //***************************************************************************
-  typedef uint64_t word_t;     // 64 bit words 
-
-#endif
-
-//*****************************************************************************
-// Main Algorithm Prototypes
-//*****************************************************************************
-extern void NORXEnc(word_t K[], word_t N[], word_t A[], word_t M[], word_t Z[], word_t C[]);
-extern void NORXDec(word_t K[], word_t N[], word_t A[], word_t C[], word_t Z[], word_t T[], word_t M[]);
-
-//***************************************************************************
-// High Level Function Prototypes
-//***************************************************************************
-extern void initialise(word_t* pwKIni, word_t* pwNIni, word_t* pwSIni);
-extern void absorb(word_t* pwSAbs, word_t* pwAZ, uint32_t AZSize, uint32_t absDomain);
-extern void branch(const word_t* pwSBrch, word_t* pwSBar, 
-                   uint32_t msgSize, uint32_t brchDomain);
-extern void encrypt(word_t* pwSbarEnc, word_t* pwM, uint32_t msgSize, uint32_t encDomain, word_t* pwC);
-extern void decrypt(word_t* pwSbarDec, word_t* pwC, uint32_t msgSize, uint32_t decDomain, word_t* pwM);
-extern void merge(word_t* pwSbarMrg, word_t* pwSMrg, uint32_t msgSize, uint32_t mrgDomain);
-extern void finalise(word_t* pwSFin, word_t* K, uint32_t finDomain, word_t* outTag);
-
-//***************************************************************************
-// Permutation Function Prototypes
-//***************************************************************************
-extern void F(word_t* pwS);
-extern void diag(word_t* pwS);
-extern void col(word_t* pwS);
-extern void G(word_t* pwS, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3);
-extern word_t rightRot(word_t value, uint32_t shift);
-extern word_t H(word_t x, word_t y);
-
-//**************************************************************************
-// Prototypes for misc. lower level functions 
-//**************************************************************************
-extern word_t pad(word_t input);
-extern void right(word_t* pwSR, word_t* retVal, uint32_t len);
-extern void left(word_t* pwSL, word_t* retVal, uint32_t len);
-
+/******************************************************************************
+*                                                                             *
+* File -> NORX.h                                                              *
+* Purpose -> Header file to encrypt and decrypt the NORX algoritm             *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 03/10/2018 - Setting Up Core Permutation, and Defining       *
+*                             Constants (3 hours)                             *
+*            2.0 03/11/2018 - Adding High Level Prototypes/Functions          * 
+*            6.0 10/17/2026 - SIMD Permutation Kernels Selected at Startup    *
+*                             by cpuid, Scalar Path Kept as Fallback          *
+*            7.0 10/17/2026 - Parallel Lanes for P = 2 and P = 4              *
+*            8.0 10/17/2026 - 64 Bit Tag Size in Bits Like 32 Bit, Other      *
+*                             Variants Live in NORX_engine.h                  *
+*            9.0 10/17/2026 - Byte Sizes, Domain Constants and Byte Based     *
+*                             NORXEnc()/NORXDec() over the Stream API         *
+*           10.0 10/17/2026 - absorb()/encrypt()/decrypt() on Bytes in Place, *
+*                             NORXEnc()/NORXDec() Back on the Core Steps      *
+*           11.0 10/17/2026 - Shared wipe() for the Stream and Batch APIs     *
+*           12.0 10/17/2026 - Constants Checked by NORXSelfTest()             *
+*           13.0 10/17/2026 - Reusable Key Schedule norx_key_t                *
+*           14.0 10/17/2026 - Single Lane Helpers for the P = 0 Pool          *
+*           15.0 10/17/2026 - Verify First Decryption, verify() Phase         *
+*           16.0 10/17/2026 - Non Temporal Payload Stores above NORX_NT_BYTES *
+*                                                                             *
+******************************************************************************/
+
+//
+// The U constants are checked against F by NORXSelfTest(), see
+// NORX_selftest.h.
+//
+
+//
+// This header sets up one variant for the whole build. To run several in
+// one program use the variants stamped out of NORX_engine.h, see
+// NORX_variants.h.
+//
+
+#ifndef NORX_H
+#define NORX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//*****************************************************************************
+//
+// Default to 32 bit words so every file built against this header agrees
+//
+//*****************************************************************************
+#if !defined(WORD_32) && !defined(WORD_64)
+  #define WORD_32 0x1
+#endif
+
+//*****************************************************************************
+//
+// If flag for 32 bit words is defined go through 32 bit defines
+//
+//*****************************************************************************
+#ifdef WORD_32
+  //***************************************************************************
+  // Define Overall Parameters
+  //***************************************************************************
+  #define WORD_LEN  32              // Word size of 32 bits  
+  #define RND_NUM   4               // 4 rounds to be run
+  #define TAG_LEN   4 * WORD_LEN    // Tag size of 4 words
+
+
+  //***************************************************************************
+  // Defines for block length and rate for 32 bits
+  //***************************************************************************
+  #define WIDTH    512
+  #define RATE     384
+  #define CAP      128
+
+  //***************************************************************************
+  // Define Shifts for G Function for 32 Bits
+  //***************************************************************************
+  #define R0        8   
+  #define R1        11
+  #define R2        16
+  #define R3        31
+
+  //***************************************************************************
+  // Define Initialisation Constants for 32 Bits
+  //***************************************************************************
+  #define U0        0x0454edab
+  #define U1        0xac6851cc
+  #define U2        0xb707322f
+  #define U3        0xa0c7c90d
+  #define U4        0x99ab09ac
+  #define U5        0xa643466d
+  #define U6        0x21c22362
+  #define U7        0x1230c950
+  #define U8        0xa3d8d930
+  #define U9        0x3fa8b72c
+  #define U10       0xed84eb49
+  #define U11       0xedca4787
+  #define U12       0x335463eb
+  #define U13       0xf994220b
+  #define U14       0xbe0bf5c9
+  #define U15       0xd7c49104
+
+  //***************************************************************************
+  // Define Word Type for 32 Bits
+  //***************************************************************************
+  typedef uint32_t word_t;     // 32 bit words 
+
+//*****************************************************************************
+//
+// If flag for 32 bit words is not set then go through 64 bit set up
+//
+//*****************************************************************************
+#else 
+  //***************************************************************************
+  // Define Overall Parameters
+  //***************************************************************************
+  #define WORD_LEN  64              // Word size of 64 bits  
+  #define RND_NUM   4               // 4 rounds to be run
+  #define TAG_LEN   4 * WORD_LEN    // Tag size of 4 words
+
+  //***************************************************************************
+  // Defines for block length and rate for 64 bits
+  //***************************************************************************
+  #define WIDTH    1024
+  #define RATE     768
+  #define CAP      256
+
+  //***************************************************************************
+  // Define Shifts for G Function for 64 Bits
+  //***************************************************************************
+  #define R0        8   
+  #define R1        19
+  #define R2        40
+  #define R3        63
+
+  //***************************************************************************
+  // Define Initialisation Constants for 64 Bits
+  //***************************************************************************
+  #define U0        0xe4d324772b91df79
+  #define U1        0x3aec9abaaeb02ccb
+  #define U2        0x9dfba13db4289311
+  #define U3        0xef9eb4bf5a97f2c8
+  #define U4        0x3f466e92c1532034
+  #define U5        0xe6e986626cc405c1
+  #define U6        0xace40f3b549184e1
+  #define U7        0xd9cfd35762614477
+  #define U8        0xb15e641748de5e6b
+  #define U9        0xaa95e955e10f8410
+  #define U10       0x28d1034441a9dd40
+  #define U11       0x7f31bbf964e93bf5
+  #define U12       0xb5e9e22493dffb96
+  #define U13       0xb980c852479fafbd
+  #define U14       0xda24516bf55eafd4
+  #define U15       0x86026ae8536f1501
+
+  //***************************************************************************
+  // Define Word Type for 64 Bits
+  //***************************************************************************
+  typedef uint64_t word_t;     // 64 bit words 
+
+#endif
+
+//*****************************************************************************
+// Parallelism degree, 1 unless given on the command line as 2 or 4
+//*****************************************************************************
+#ifndef PARALLEL
+  #define PARALLEL  1
+#endif
+
+#if PARALLEL != 1 && PARALLEL != 2 && PARALLEL != 4
+  #error "PARALLEL must be 1, 2 or 4"
+#endif
+
+//*****************************************************************************
+// Payload size from which encrypt()/decrypt() write their output with non
+// temporal stores, 0 for never. Can be changed at run time with
+// NORXSetNtBytes().
+//*****************************************************************************
+#ifndef NORX_NT_BYTES
+  #define NORX_NT_BYTES  0
+#endif
+
+//*****************************************************************************
+// Words of message taken per block, and the size of all lane states
+//*****************************************************************************
+#define RATE_WORDS   (RATE / WORD_LEN)
+#define LANES_WORDS  (16 * PARALLEL)
+#define TAG_WORDS    ((TAG_LEN) / WORD_LEN)
+
+//*****************************************************************************
+// Sizes in bytes for the byte oriented functions
+//*****************************************************************************
+#define WORD_BYTES   (WORD_LEN / 8)
+#define RATE_BYTES   (RATE / 8)
+#define KEY_BYTES    (4 * WORD_BYTES)
+#define NONCE_BYTES  (4 * WORD_BYTES)
+#define TAG_BYTES    (TAG_WORDS * WORD_BYTES)
+
+//*****************************************************************************
+// Domain Constants
+//*****************************************************************************
+#define HEADER_DOMAIN   0x01
+#define PAYLOAD_DOMAIN  0x02
+#define TRAILER_DOMAIN  0x04
+#define FINAL_DOMAIN    0x08
+#define BRANCH_DOMAIN   0x10
+#define MERGE_DOMAIN    0x20
+
+//*****************************************************************************
+// Little endian word access on bytes with any alignment. Inline here so the
+// block loops in every file get a plain load or store out of them: on little
+// endian hosts that is a memcpy, GCC does not merge the byte loops by itself.
+//*****************************************************************************
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+static inline word_t
+loadWord(const uint8_t* pIn) {
+  word_t w;
+
+  memcpy(&w, pIn, sizeof(w));
+  return w;
+}
+
+static inline void
+storeWord(uint8_t* pOut, word_t w) {
+  memcpy(pOut, &w, sizeof(w));
+}
+#else
+static inline word_t
+loadWord(const uint8_t* pIn) {
+  word_t w = 0;
+  int i;
+
+  for (i = WORD_BYTES - 1; i >= 0; i--) {
+    w = (w << 8) | pIn[i];
+  }
+  return w;
+}
+
+static inline void
+storeWord(uint8_t* pOut, word_t w) {
+  int i;
+
+  for (i = 0; i < WORD_BYTES; i++) {
+    pOut[i] = (uint8_t)(w >> (8 * i));
+  }
+}
+#endif
+
+//*****************************************************************************
+// 64 byte alignment for data the hot path loads as whole vectors
+//*****************************************************************************
+#if defined(__GNUC__)
+  #define NORX_ALIGN  __attribute__((aligned(64)))
+#else
+  #define NORX_ALIGN
+#endif
+
+//*****************************************************************************
+// Key schedule, set up once per key. S holds state words 4 - 15 as they are
+// before the first F: the key and U8 - U15 with W, L, P and T folded in,
+// so a message only has to add its nonce.
+//*****************************************************************************
+typedef struct {
+  word_t S[12];               // State words 4 - 15 before initialise()'s F
+  word_t K[4];                // Key words, finalise() needs them again
+} NORX_ALIGN norx_key_t;
+
+//*****************************************************************************
+// Main Algorithm Prototypes
+//*****************************************************************************
+extern void NORXEnc(const uint8_t* pK, const uint8_t* pN,
+                    const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t mLen,
+                    const uint8_t* pZ, size_t zLen, uint8_t* pC, uint8_t* pT);
+extern bool NORXDec(const uint8_t* pK, const uint8_t* pN,
+                    const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+                    const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM);
+
+//
+// NORXDecVerify()/NORXKeyDecVerify() check the tag before writing any plain
+// text, pM is left untouched for a forged message. They take about one more
+// payload pass than NORXDec() when the tag matches.
+//
+extern bool NORXDecVerify(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pC, size_t cLen,
+                          const uint8_t* pZ, size_t zLen,
+                          const uint8_t* pT, uint8_t* pM);
+
+extern void NORXKeyInit(norx_key_t* pKey, const uint8_t* pK);
+extern void NORXKeyWipe(norx_key_t* pKey);
+extern void NORXKeyEnc(const norx_key_t* pKey, const uint8_t* pN,
+                       const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t mLen,
+                       const uint8_t* pZ, size_t zLen, uint8_t* pC, uint8_t* pT);
+extern bool NORXKeyDec(const norx_key_t* pKey, const uint8_t* pN,
+                       const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+                       const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM);
+extern bool NORXKeyDecVerify(const norx_key_t* pKey, const uint8_t* pN,
+                             const uint8_t* pA, size_t aLen,
+                             const uint8_t* pC, size_t cLen,
+                             const uint8_t* pZ, size_t zLen,
+                             const uint8_t* pT, uint8_t* pM);
+
+//
+// Payloads of at least NORXSetNtBytes() bytes, 0 for none, are written with
+// non temporal stores that go around the cache, for buffers too big to be
+// read back while still cached. NORXNtBytes() gives the current setting.
+//
+extern void NORXSetNtBytes(size_t bytes);
+extern size_t NORXNtBytes(void);
+
+//***************************************************************************
+// High Level Function Prototypes
+//***************************************************************************
+extern void initialise(word_t* pwKIni, word_t* pwNIni, word_t* pwSIni);
+extern void initialiseKey(const norx_key_t* pKey, const uint8_t* pN, word_t* pwS);
+extern void absorb(word_t* pwSAbs, const uint8_t* pAZ, size_t AZSize, uint32_t absDomain);
+extern void branch(const word_t* pwSBrch, word_t* pwSBar, 
+                   size_t msgSize, uint32_t brchDomain);
+extern void encrypt(word_t* pwSbarEnc, const uint8_t* pM, size_t msgSize, uint32_t encDomain, uint8_t* pC);
+extern void decrypt(word_t* pwSbarDec, const uint8_t* pC, size_t msgSize, uint32_t decDomain, uint8_t* pM);
+extern void verify(word_t* pwSbarVer, const uint8_t* pC, size_t msgSize, uint32_t verDomain);
+extern void merge(word_t* pwSbarMrg, word_t* pwSMrg, size_t msgSize, uint32_t mrgDomain);
+extern void finalise(word_t* pwSFin, const word_t* K, uint32_t finDomain, word_t* outTag);
+
+//***************************************************************************
+// Whole Block Prototypes, bytes straight from and to the caller's buffers
+//***************************************************************************
+extern void absorbBlocks(word_t* pwS, const uint8_t* pIn, size_t blocks,
+                         uint32_t domain);
+extern void encryptBlocks(word_t* pwSbar, uint64_t first, const uint8_t* pIn,
+                          size_t blocks, uint32_t domain, uint8_t* pOut);
+extern void decryptBlocks(word_t* pwSbar, uint64_t first, const uint8_t* pIn,
+                          size_t blocks, uint32_t domain, uint8_t* pOut);
+extern void verifyBlocks(word_t* pwSbar, uint64_t first, const uint8_t* pIn,
+                         size_t blocks, uint32_t domain);
+
+//***************************************************************************
+// Single Lane Prototypes. The last block of a lane with its padding, and a
+// whole payload on one lane state for the chunked lanes in NORX_pool.c
+//***************************************************************************
+extern void encryptLast(word_t* pwS, const uint8_t* pM, uint32_t len,
+                        uint32_t domain, uint8_t* pC);
+extern void decryptLast(word_t* pwS, const uint8_t* pC, uint32_t len,
+                        uint32_t domain, uint8_t* pM);
+extern void verifyLast(word_t* pwS, const uint8_t* pC, uint32_t len,
+                       uint32_t domain);
+extern void encryptLane(word_t* pwS, const uint8_t* pM, size_t msgSize,
+                        uint32_t domain, uint8_t* pC);
+extern void decryptLane(word_t* pwS, const uint8_t* pC, size_t msgSize,
+                        uint32_t domain, uint8_t* pM);
+
+//***************************************************************************
+// Permutation Function Prototypes
+//***************************************************************************
+extern void F(word_t* pwS);
+extern void FScalar(word_t* pwS);
+extern void diag(word_t* pwS);
+extern void col(word_t* pwS);
+extern void G(word_t* pwS, uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3);
+extern word_t rightRot(word_t value, uint32_t shift);
+extern word_t H(word_t x, word_t y);
+
+//**************************************************************************
+// Prototypes for misc. lower level functions 
+//**************************************************************************
+extern void pad(word_t* pwS, uint32_t len);
+extern void right(word_t* pwSR, word_t* retVal, uint32_t len);
+extern void left(word_t* pwSL, word_t* retVal, uint32_t len);
+extern void wipe(void* p, size_t len);
+extern bool tagMatch(const word_t* pwT, const uint8_t* pT);
+
+#endif // NORX_H
@@ -0,0 +1,436 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_batch.c                                                        *
+* Purpose -> Multi buffer NORX, BATCH_LANES independent messages share each   *
+*            call of the batch F kernel                                       *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Multi Buffer Batch Seal/Open                    *
+*            2.0 10/17/2026 - NORX_STATS Counts per Lane Step                 *
+*                                                                             *
+* Every message is a fixed run of F calls: one for initialise, one per block  *
+* of each non empty phase and two for finalise. Each lane keeps its own step  *
+* in that run, so one batch F can move lanes that are in different phases.    *
+* Before F a lane XORs in the domain of its step, after F it takes its block  *
+* or the key. A lane that has finished is refilled with the next message,     *
+* and once the queue is empty it is masked out: F still runs over it but      *
+* nothing reads it.                                                           *
+*                                                                             *
+* Branching needs P states per message, so for P > 1 the batch calls just     *
+* run NORXEnc()/NORXDec() on each message in turn.                            *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_stats.h" // Domain counters
+#include "NORX_simd.h"  // Batch kernel and BATCH_LANES
+#include "NORX_batch.h" // Message type and prototypes
+
+#if PARALLEL == 1
+
+//*****************************************************************************
+// Steps a lane moves through, in order. Empty header, payload and trailer
+// phases are skipped.
+//*****************************************************************************
+#define STEP_INIT      0
+#define STEP_HEADER    1
+#define STEP_PAYLOAD   2
+#define STEP_TRAILER   3
+#define STEP_FINAL     4   // First F of finalise
+#define STEP_TAG       5   // Second F of finalise, the tag comes out
+#define STEP_IDLE      6   // Nothing left to load, lane is masked
+
+//*****************************************************************************
+// Word i of lane j of a batch
+//*****************************************************************************
+#define BATCH_WORD(pwB, i, j)  ((pwB)[(i) * BATCH_LANES + (j)])
+
+//*****************************************************************************
+// Domain XORed into word 15 before the F of each step
+//*****************************************************************************
+static const uint32_t stepDomain[STEP_IDLE + 1] = {
+  0, HEADER_DOMAIN, PAYLOAD_DOMAIN, TRAILER_DOMAIN, FINAL_DOMAIN, 0, 0
+};
+
+//*****************************************************************************
+// What a lane is working on
+//*****************************************************************************
+typedef struct {
+  const norx_msg_t* pMsg;     // Message in the lane
+  size_t idx;                 // Index of pMsg in the batch
+  word_t K[4];                // Key words, finalise() needs them again
+  uint32_t step;              // STEP_xxx
+  size_t pos;                 // Bytes of the current phase done
+} lane_t;
+
+//*****************************************************************************
+//
+// Function -> phaseLen
+// Purpose -> Bytes the message has in the phase of a step
+//
+//*****************************************************************************
+static size_t
+phaseLen(const norx_msg_t* pMsg, uint32_t step) {
+  switch (step) {
+    case STEP_HEADER:
+      return pMsg->aLen;
+    case STEP_PAYLOAD:
+      return pMsg->inLen;
+    case STEP_TRAILER:
+      return pMsg->zLen;
+    default:
+      return 0;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> nextPhase
+// Purpose -> Move the lane past step, skipping phases with no bytes
+//
+//*****************************************************************************
+static void
+nextPhase(lane_t* pLane, uint32_t step) {
+  step++;
+  while (step <= STEP_TRAILER && phaseLen(pLane->pMsg, step) == 0) {
+    step++;
+  }
+  pLane->step = step;
+  pLane->pos = 0;
+}
+
+//*****************************************************************************
+//
+// Function -> startLane
+// Purpose -> Load the initial state of a message into its lane, the F of
+//            initialise runs with the rest of the batch
+//
+//*****************************************************************************
+static void
+startLane(word_t* pwB, lane_t* pLane, uint32_t j, const norx_msg_t* pMsg,
+          size_t idx) {
+  static const word_t U[8] = { U8, U9, U10, U11, U12, U13, U14, U15 };
+  uint32_t i;
+
+  pLane->pMsg = pMsg;
+  pLane->idx = idx;
+  pLane->step = STEP_INIT;
+  pLane->pos = 0;
+
+  for (i = 0; i < 4; i++) {
+    pLane->K[i] = loadWord(pMsg->pK + i * WORD_BYTES);
+    BATCH_WORD(pwB, i, j) = loadWord(pMsg->pN + i * WORD_BYTES);
+    BATCH_WORD(pwB, i + 4, j) = pLane->K[i];
+  }
+  for (i = 0; i < 8; i++) {
+    BATCH_WORD(pwB, i + 8, j) = U[i];
+  }
+  BATCH_WORD(pwB, 12, j) ^= WORD_LEN;
+  BATCH_WORD(pwB, 13, j) ^= RND_NUM;
+  BATCH_WORD(pwB, 14, j) ^= PARALLEL;
+  BATCH_WORD(pwB, 15, j) ^= TAG_LEN;
+}
+
+//*****************************************************************************
+//
+// Function -> takeBlock
+// Purpose -> Run one header, payload or trailer block through the rate of
+//            a lane. The rate is copied out of the batch so the same word
+//            and byte loops as absorb()/encrypt()/decrypt() can be used.
+// Inputs -> word_t* pwB[] - Batch
+//           uint32_t j - Lane
+//           const uint8_t* pIn - Block in
+//           uint32_t len - Bytes in the block, short means last
+//           uint32_t step - STEP_xxx, what to do with the block
+//           bool open - Decrypt rather than encrypt the payload
+//           uint8_t* pOut - Payload block out
+//
+//*****************************************************************************
+static void
+takeBlock(word_t* pwB, uint32_t j, const uint8_t* pIn, uint32_t len,
+          uint32_t step, bool open, uint8_t* pOut) {
+  word_t r[RATE_WORDS];
+  uint32_t words = len / WORD_BYTES;
+  uint32_t i;
+  uint32_t sh;
+  word_t c;
+  uint8_t m;
+
+  for (i = 0; i < RATE_WORDS; i++) {
+    r[i] = BATCH_WORD(pwB, i, j);
+  }
+
+  if (step != STEP_PAYLOAD) {
+    for (i = 0; i < words; i++) {
+      r[i] ^= loadWord(pIn + i * WORD_BYTES);
+    }
+    for (i = words * WORD_BYTES; i < len; i++) {
+      r[words] ^= (word_t)pIn[i] << (8 * (i % WORD_BYTES));
+    }
+  }
+  else if (!open) {
+    for (i = 0; i < words; i++) {
+      r[i] ^= loadWord(pIn + i * WORD_BYTES);
+      storeWord(pOut + i * WORD_BYTES, r[i]);
+    }
+    for (i = words * WORD_BYTES; i < len; i++) {
+      sh = 8 * (i % WORD_BYTES);
+      r[words] ^= (word_t)pIn[i] << sh;
+      pOut[i] = (uint8_t)(r[words] >> sh);
+    }
+  }
+  else {
+    for (i = 0; i < words; i++) {
+      c = loadWord(pIn + i * WORD_BYTES);
+      storeWord(pOut + i * WORD_BYTES, r[i] ^ c);
+      r[i] = c;
+    }
+    for (i = words * WORD_BYTES; i < len; i++) {
+      sh = 8 * (i % WORD_BYTES);
+      m = pIn[i] ^ (uint8_t)(r[words] >> sh);
+      pOut[i] = m;
+      r[words] ^= (word_t)m << sh;
+    }
+  }
+
+  if (len < RATE_BYTES) {
+    pad(r, len);
+  }
+  for (i = 0; i < RATE_WORDS; i++) {
+    BATCH_WORD(pwB, i, j) = r[i];
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> beforeF
+// Purpose -> Domain of the lane's step into word 15
+//
+//*****************************************************************************
+static void
+beforeF(word_t* pwB, const lane_t* pLane, uint32_t j) {
+  BATCH_WORD(pwB, 15, j) ^= stepDomain[pLane->step];
+}
+
+//*****************************************************************************
+//
+// Function -> afterF
+// Purpose -> Finish the lane's step once F has run and move it on
+// Returns -> true when the message is done, its tag is written or checked
+//
+//*****************************************************************************
+static bool
+afterF(word_t* pwB, lane_t* pLane, uint32_t j, bool open, word_t* pwDiff) {
+  const norx_msg_t* pMsg = pLane->pMsg;
+  const uint8_t* pIn;
+  uint8_t* pOut = NULL;
+  size_t left;
+  uint32_t len;
+  uint32_t i;
+
+  switch (pLane->step) {
+    case STEP_INIT:
+      for (i = 0; i < 4; i++) {
+        BATCH_WORD(pwB, 12 + i, j) ^= pLane->K[i];
+      }
+      nextPhase(pLane, STEP_INIT);
+      return false;
+
+    case STEP_HEADER:
+    case STEP_PAYLOAD:
+    case STEP_TRAILER:
+      if (pLane->step == STEP_HEADER) {
+        pIn = pMsg->pA;
+      }
+      else if (pLane->step == STEP_PAYLOAD) {
+        pIn = pMsg->pIn;
+        pOut = pMsg->pOut + pLane->pos;
+      }
+      else {
+        pIn = pMsg->pZ;
+      }
+      left = phaseLen(pMsg, pLane->step) - pLane->pos;
+      len = (left < RATE_BYTES) ? (uint32_t)left : RATE_BYTES;
+
+      STATS_DOMAIN(stepDomain[pLane->step], 1, 1, len);
+      takeBlock(pwB, j, pIn + pLane->pos, len, pLane->step, open, pOut);
+      pLane->pos += len;
+      if (len < RATE_BYTES) {
+        nextPhase(pLane, pLane->step);
+      }
+      return false;
+
+    case STEP_FINAL:
+      for (i = 0; i < 4; i++) {
+        BATCH_WORD(pwB, 12 + i, j) ^= pLane->K[i];
+      }
+      pLane->step = STEP_TAG;
+      return false;
+
+    case STEP_TAG:
+      STATS_DOMAIN(FINAL_DOMAIN, 2, 0, TAG_BYTES);
+      *pwDiff = 0;
+      for (i = 0; i < TAG_WORDS; i++) {
+        BATCH_WORD(pwB, 12 + i, j) ^= pLane->K[i];
+        if (open) {
+          *pwDiff |= BATCH_WORD(pwB, 16 - TAG_WORDS + i, j) ^
+                     loadWord(pMsg->pT + i * WORD_BYTES);
+        }
+        else {
+          storeWord(pMsg->pT + i * WORD_BYTES,
+                    BATCH_WORD(pwB, 16 - TAG_WORDS + i, j));
+        }
+      }
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> runBatch
+// Purpose -> Push every message through the lanes of one batch state
+// Inputs -> const norx_msg_t* pMsgs - Messages
+//           size_t count - Number of messages
+//           bool open - Decrypt and check tags rather than seal
+//           bool* pOk - Tag result per message, may be NULL
+// Returns -> Number of tags that matched when opening
+//
+//*****************************************************************************
+static size_t
+runBatch(const norx_msg_t* pMsgs, size_t count, bool open, bool* pOk) {
+  word_t B[BATCH_WORDS] = { 0 };  // Batch state, word per row
+  lane_t lanes[BATCH_LANES];
+  size_t next = 0;
+  size_t good = 0;
+  uint32_t active = 0;
+  uint32_t j;
+  word_t diff;
+
+  for (j = 0; j < BATCH_LANES; j++) {
+    if (next < count) {
+      startLane(B, &lanes[j], j, &pMsgs[next], next);
+      next++;
+      active++;
+    }
+    else {
+      lanes[j].step = STEP_IDLE;
+    }
+  }
+
+  while (active > 0) {
+    for (j = 0; j < BATCH_LANES; j++) {
+      if (lanes[j].step != STEP_IDLE) {
+        beforeF(B, &lanes[j], j);
+      }
+    }
+
+    pfnPermuteBatch(B);
+
+    for (j = 0; j < BATCH_LANES; j++) {
+      if (lanes[j].step == STEP_IDLE ||
+          !afterF(B, &lanes[j], j, open, &diff)) {
+        continue;
+      }
+
+      //
+      // Message done, hand the lane the next one or mask it
+      //
+      if (open) {
+        good += (diff == 0);
+        if (pOk != NULL) {
+          pOk[lanes[j].idx] = (diff == 0);
+        }
+      }
+      if (next < count) {
+        startLane(B, &lanes[j], j, &pMsgs[next], next);
+        next++;
+      }
+      else {
+        lanes[j].step = STEP_IDLE;
+        active--;
+      }
+    }
+  }
+
+  wipe(B, sizeof(B));
+  wipe(lanes, sizeof(lanes));
+
+  return good;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXBatchSeal
+// Purpose -> Encrypt and tag every message of the batch
+// Inputs -> const norx_msg_t* pMsgs - Messages
+//           size_t count - Number of messages
+//
+//*****************************************************************************
+void
+NORXBatchSeal(const norx_msg_t* pMsgs, size_t count) {
+  runBatch(pMsgs, count, false, NULL);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXBatchOpen
+// Purpose -> Decrypt every message of the batch and check its tag
+// Inputs -> const norx_msg_t* pMsgs - Messages
+//           size_t count - Number of messages
+//           bool* pOk - Tag result per message, may be NULL
+// Returns -> Number of tags that matched
+//
+//*****************************************************************************
+size_t
+NORXBatchOpen(const norx_msg_t* pMsgs, size_t count, bool* pOk) {
+  return runBatch(pMsgs, count, true, pOk);
+}
+
+#else
+
+//*****************************************************************************
+//
+// Function -> NORXBatchSeal / NORXBatchOpen
+// Purpose -> One message after the other, each already on P lanes
+//
+//*****************************************************************************
+void
+NORXBatchSeal(const norx_msg_t* pMsgs, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    NORXEnc(pMsgs[i].pK, pMsgs[i].pN, pMsgs[i].pA, pMsgs[i].aLen,
+            pMsgs[i].pIn, pMsgs[i].inLen, pMsgs[i].pZ, pMsgs[i].zLen,
+            pMsgs[i].pOut, pMsgs[i].pT);
+  }
+}
+
+size_t
+NORXBatchOpen(const norx_msg_t* pMsgs, size_t count, bool* pOk) {
+  size_t good = 0;
+  size_t i;
+  bool ok;
+
+  for (i = 0; i < count; i++) {
+    ok = NORXDec(pMsgs[i].pK, pMsgs[i].pN, pMsgs[i].pA, pMsgs[i].aLen,
+                 pMsgs[i].pIn, pMsgs[i].inLen, pMsgs[i].pZ, pMsgs[i].zLen,
+                 pMsgs[i].pT, pMsgs[i].pOut);
+    good += ok;
+    if (pOk != NULL) {
+      pOk[i] = ok;
+    }
+  }
+
+  return good;
+}
+
+#endif // PARALLEL == 1
@@ -0,0 +1,45 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_batch.h                                                        *
+* Purpose -> Seal or open many independent messages at once, one message per  *
+*            SIMD lane so small packets are not bound by the latency of F     *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Multi Buffer Batch Seal/Open                    *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_BATCH_H
+#define NORX_BATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// One message of a batch. Seal reads pIn as message text, writes pOut as
+// cipher text and pT as the tag. Open reads pIn as cipher text and checks
+// pT, writing the message text to pOut. pOut may be pIn.
+//*****************************************************************************
+typedef struct {
+  const uint8_t* pK;          // Key, KEY_BYTES
+  const uint8_t* pN;          // Nonce, NONCE_BYTES
+  const uint8_t* pA;          // Header
+  size_t aLen;
+  const uint8_t* pIn;         // Payload in
+  size_t inLen;
+  const uint8_t* pZ;          // Trailer
+  size_t zLen;
+  uint8_t* pOut;              // Payload out, inLen bytes
+  uint8_t* pT;                // Tag, TAG_BYTES
+} norx_msg_t;
+
+//*****************************************************************************
+// Batch Prototypes. NORXBatchOpen() returns how many tags matched, pOk gets
+// the result per message when it is not NULL.
+//*****************************************************************************
+extern void NORXBatchSeal(const norx_msg_t* pMsgs, size_t count);
+extern size_t NORXBatchOpen(const norx_msg_t* pMsgs, size_t count, bool* pOk);
+
+#endif // NORX_BATCH_H
@@ -0,0 +1,479 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_bench.c                                                        *
+* Purpose -> Throughput and latency benchmark of every NORX path, results     *
+*            are written to stdout as JSON so runs can be compared            *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Replaces the printf harness in NORX.c           *
+*            2.0 10/17/2026 - Refuses to run unless NORXSelfTest() passes     *
+*            3.0 10/17/2026 - Keyed target, NORXKeyEnc() on one key schedule  *
+*            4.0 10/17/2026 - Pool target, chunked lanes on every core        *
+*            5.0 10/17/2026 - NORX_STATS phase and domain totals at the end   *
+*                                                                             *
+* Build -> gcc -O2 -pthread NORX.c NORX_simd.c NORX_stream.c NORX_batch.c     *
+*              NORX_pool.c NORX_seg.c NORX_uring.c NORX_pipe.c NORX_stats.c   *
+*              NORX_iov.c NORX_sess.c NORX_mac.c NORX_drbg.c                  *
+*              NORX_variants.c NORX_selftest.c NORX_bench.c -o NORX_bench     *
+*          add -DWORD_64 and/or -DPARALLEL=n for the other core builds,       *
+*          -DNORX_STATS for the phase counters of the whole run, and          *
+*          -DNORX_BENCH_FLAGS="\"...\"" to record the flags in the output     *
+* Usage -> NORX_bench [ms per point]                                          *
+*                                                                             *
+* Every point runs one target on one message shape and size. The run is       *
+* repeated until it fills its share of the time, BENCH_TRIALS times over,     *
+* and the fastest trial is kept. Cycles are TSC reference cycles, so they     *
+* only match core cycles with turbo and frequency scaling off.                *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdio.h>     // printf
+#include <stdlib.h>    // malloc, strtoul
+#include <string.h>    // memset
+#include <time.h>      // clock_gettime
+
+#include "NORX.h"          // NORX defines and prototypes
+#include "NORX_simd.h"     // Kernel dispatch
+#include "NORX_batch.h"    // Multi buffer seal
+#include "NORX_pool.h"     // Chunked lanes on a thread pool
+#include "NORX_stats.h"    // Phase counters
+#include "NORX_variants.h" // Include instantiated variants
+#include "NORX_selftest.h" // Gate before timing anything
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <x86intrin.h>
+  #define BENCH_TSC  0x1
+#endif
+
+#ifndef NORX_BENCH_FLAGS
+  #define NORX_BENCH_FLAGS  ""
+#endif
+
+//*****************************************************************************
+// Sweep settings
+//*****************************************************************************
+#define BENCH_MAX_BYTES   ((size_t)16 << 20)
+#define BENCH_BATCH_MAX   ((size_t)64 << 10)   // Largest batch message
+#define BENCH_BATCH_MSGS  (4 * BATCH_LANES)    // Messages per batch call
+#define BENCH_TRIALS      5
+#define BENCH_DEFAULT_MS  50
+
+static const size_t benchSizes[] = {
+  0, 16, 64, 256, 1024, 4096, (size_t)64 << 10, (size_t)1 << 20, BENCH_MAX_BYTES
+};
+
+//*****************************************************************************
+// Message shapes, each splits size bytes over header, payload and trailer
+//*****************************************************************************
+#define SHAPE_HEADER    0   // All header, AD only
+#define SHAPE_PAYLOAD   1   // All payload
+#define SHAPE_MIXED     2   // Quarter header, half payload, quarter trailer
+#define SHAPE_COUNT     3
+
+static const char* shapeNames[SHAPE_COUNT] = { "header", "payload", "mixed" };
+
+//*****************************************************************************
+// What one point runs
+//*****************************************************************************
+#define TARGET_CORE     0   // NORXEnc() through the dispatched kernel
+#define TARGET_BATCH    1   // NORXBatchSeal() through the dispatched kernel
+#define TARGET_ENGINE   2   // A NORX_engine.h instance, own unrolled F
+#define TARGET_KEYED    3   // NORXKeyEnc() on a key schedule set up once
+#define TARGET_POOL     4   // NORXPoolEnc(), chunked lanes on every core
+
+typedef struct {
+  uint32_t type;            // TARGET_xxx
+  const char* variant;      // Variant name
+  const char* kernel;       // Kernel name or "engine"
+  variant_enc_t pfnEnc;     // Encrypt for TARGET_CORE and TARGET_ENGINE
+} target_t;
+
+typedef struct {
+  size_t aLen;
+  size_t mLen;
+  size_t zLen;
+} shape_t;
+
+//*****************************************************************************
+// Buffers shared by every point
+//*****************************************************************************
+static uint8_t* pIn;
+static uint8_t* pOut;
+static uint8_t key[64];
+static uint8_t nonce[64];
+static norx_key_t keySched;
+static norx_pool_t* pPool;
+static uint8_t tag[BENCH_BATCH_MSGS][64];
+static norx_msg_t msgs[BENCH_BATCH_MSGS];
+
+//*****************************************************************************
+//
+// Function -> nowNs / nowCycles
+// Purpose -> Monotonic time in ns and the TSC, 0 where there is none
+//
+//*****************************************************************************
+static uint64_t
+nowNs(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t
+nowCycles(void) {
+#ifdef BENCH_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+//*****************************************************************************
+//
+// Function -> makeShape
+// Purpose -> Split size bytes the way the shape says
+//
+//*****************************************************************************
+static shape_t
+makeShape(uint32_t shape, size_t size) {
+  shape_t s = { 0, 0, 0 };
+
+  switch (shape) {
+    case SHAPE_HEADER:
+      s.aLen = size;
+      break;
+    case SHAPE_PAYLOAD:
+      s.mLen = size;
+      break;
+    default:
+      s.aLen = size / 4;
+      s.zLen = size / 4;
+      s.mLen = size - s.aLen - s.zLen;
+      break;
+  }
+  return s;
+}
+
+//*****************************************************************************
+//
+// Function -> runOnce
+// Purpose -> One call of the target on the shape, returns messages done
+//
+//*****************************************************************************
+static size_t
+runOnce(const target_t* pTgt, const shape_t* pShape) {
+  size_t total = pShape->aLen + pShape->mLen + pShape->zLen;
+  size_t i;
+
+  if (pTgt->type == TARGET_KEYED) {
+    NORXKeyEnc(&keySched, nonce, pIn, pShape->aLen,
+               pIn + pShape->aLen, pShape->mLen,
+               pIn + pShape->aLen + pShape->mLen, pShape->zLen,
+               pOut, tag[0]);
+    return 1;
+  }
+  if (pTgt->type == TARGET_POOL) {
+    NORXPoolEnc(pPool, &keySched, nonce, pIn, pShape->aLen,
+                pIn + pShape->aLen, pShape->mLen,
+                pIn + pShape->aLen + pShape->mLen, pShape->zLen,
+                pOut, tag[0]);
+    return 1;
+  }
+  if (pTgt->type != TARGET_BATCH) {
+    pTgt->pfnEnc(key, nonce, pIn, pShape->aLen,
+                 pIn + pShape->aLen, pShape->mLen,
+                 pIn + pShape->aLen + pShape->mLen, pShape->zLen,
+                 pOut, tag[0]);
+    return 1;
+  }
+
+  for (i = 0; i < BENCH_BATCH_MSGS; i++) {
+    msgs[i].pK = key;
+    msgs[i].pN = nonce;
+    msgs[i].pA = pIn + i * total;
+    msgs[i].aLen = pShape->aLen;
+    msgs[i].pIn = msgs[i].pA + pShape->aLen;
+    msgs[i].inLen = pShape->mLen;
+    msgs[i].pZ = msgs[i].pIn + pShape->mLen;
+    msgs[i].zLen = pShape->zLen;
+    msgs[i].pOut = pOut + i * total;
+    msgs[i].pT = tag[i];
+  }
+  NORXBatchSeal(msgs, BENCH_BATCH_MSGS);
+  return BENCH_BATCH_MSGS;
+}
+
+//*****************************************************************************
+//
+// Function -> benchPoint
+// Purpose -> Time one target on one shape and size, print it as JSON
+// Inputs -> const target_t* pTgt - What to run
+//           uint32_t shape - SHAPE_xxx
+//           size_t size - Bytes per message over all three parts
+//           uint64_t budgetNs - Time to spend on the point
+//           bool first - No comma before this entry
+//
+//*****************************************************************************
+static void
+benchPoint(const target_t* pTgt, uint32_t shape, size_t size, uint64_t budgetNs,
+           bool first) {
+  shape_t s = makeShape(shape, size);
+  uint64_t t0;
+  uint64_t c0;
+  uint64_t ns;
+  uint64_t cyc;
+  uint64_t bestNs = UINT64_MAX;
+  uint64_t bestCyc = 0;
+  size_t iters;
+  size_t msgsPerCall;
+  size_t n;
+  size_t i;
+  uint32_t trial;
+  double nsPerMsg;
+
+  //
+  // One warm up call sizes the trials
+  //
+  t0 = nowNs();
+  msgsPerCall = runOnce(pTgt, &s);
+  ns = nowNs() - t0;
+  iters = (ns == 0) ? 1000 : (size_t)(budgetNs / BENCH_TRIALS / ns);
+  if (iters == 0) {
+    iters = 1;
+  }
+
+  for (trial = 0; trial < BENCH_TRIALS; trial++) {
+    c0 = nowCycles();
+    t0 = nowNs();
+    for (i = 0; i < iters; i++) {
+      runOnce(pTgt, &s);
+    }
+    ns = nowNs() - t0;
+    cyc = nowCycles() - c0;
+    if (ns < bestNs) {
+      bestNs = ns;
+      bestCyc = cyc;
+    }
+  }
+
+  n = iters * msgsPerCall;
+  nsPerMsg = (double)bestNs / (double)n;
+
+  printf("%s    {\"target\": \"%s\", \"variant\": \"%s\", \"kernel\": \"%s\", "
+         "\"shape\": \"%s\", \"bytes\": %zu, \"header\": %zu, "
+         "\"payload\": %zu, \"trailer\": %zu, \"messages\": %zu, "
+         "\"ns_per_msg\": %.1f, ",
+         first ? "" : ",\n",
+         (pTgt->type == TARGET_CORE) ? "core" :
+         (pTgt->type == TARGET_BATCH) ? "batch" :
+         (pTgt->type == TARGET_KEYED) ? "keyed" :
+         (pTgt->type == TARGET_POOL) ? "pool" : "engine",
+         pTgt->variant, pTgt->kernel, shapeNames[shape], size,
+         s.aLen, s.mLen, s.zLen, n, nsPerMsg);
+  if (size > 0) {
+    printf("\"mb_per_s\": %.1f, ", (double)size * 1e3 / nsPerMsg);
+  }
+  else {
+    printf("\"mb_per_s\": null, ");
+  }
+#ifdef BENCH_TSC
+  if (size > 0) {
+    printf("\"cycles_per_byte\": %.2f, ",
+           (double)bestCyc / ((double)n * (double)size));
+  }
+  else {
+    printf("\"cycles_per_byte\": null, ");
+  }
+  printf("\"cycles_per_msg\": %.0f}", (double)bestCyc / (double)n);
+#else
+  (void)bestCyc;
+  printf("\"cycles_per_byte\": null, \"cycles_per_msg\": null}");
+#endif
+  fflush(stdout);
+}
+
+//*****************************************************************************
+//
+// Function -> benchTarget
+// Purpose -> Sweep every shape and size over one target
+//
+//*****************************************************************************
+static void
+benchTarget(const target_t* pTgt, uint64_t budgetNs, bool* pFirst) {
+  uint32_t shape;
+  uint32_t i;
+
+  for (shape = 0; shape < SHAPE_COUNT; shape++) {
+    for (i = 0; i < sizeof(benchSizes) / sizeof(benchSizes[0]); i++) {
+      if (pTgt->type == TARGET_BATCH && benchSizes[i] > BENCH_BATCH_MAX) {
+        continue;
+      }
+      benchPoint(pTgt, shape, benchSizes[i], budgetNs, *pFirst);
+      *pFirst = false;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> printStats
+// Purpose -> Phase and domain totals over the whole sweep, null unless built
+//            with NORX_STATS
+//
+//*****************************************************************************
+static void
+printStats(void) {
+  norx_stats_t st;
+  uint32_t i;
+
+  if (!NORXStatsSnapshot(&st)) {
+    printf("  \"stats\": null\n");
+    return;
+  }
+
+  printf("  \"stats\": {\n    \"ticks\": \"%s\",\n    \"phases\": {",
+         st.tsc ? "tsc" : "ns");
+  for (i = 0; i < STAT_PHASES; i++) {
+    printf("%s\n      \"%s\": {\"calls\": %llu, \"perms\": %llu, "
+           "\"ticks\": %llu}", (i == 0) ? "" : ",", NORXStatsPhaseName(i),
+           (unsigned long long)st.phase[i].calls,
+           (unsigned long long)st.phase[i].perms,
+           (unsigned long long)st.phase[i].ticks);
+  }
+  printf("\n    },\n    \"domains\": {");
+  for (i = 0; i < STAT_DOMAINS; i++) {
+    printf("%s\n      \"%s\": {\"perms\": %llu, \"blocks\": %llu, "
+           "\"bytes\": %llu}", (i == 0) ? "" : ",", NORXStatsDomainName(i),
+           (unsigned long long)st.domain[i].perms,
+           (unsigned long long)st.domain[i].blocks,
+           (unsigned long long)st.domain[i].bytes);
+  }
+  printf("\n    }\n  }\n");
+}
+
+//*****************************************************************************
+//
+// Function -> main
+// Purpose -> Run the whole sweep: the core build and the batch API on every
+//            kernel this CPU has, then each include instantiated variant
+// Inputs -> argv[1] - Optional ms to spend on each point
+//
+//*****************************************************************************
+int
+main(int argc, char** argv) {
+  char coreName[32];
+  char poolName[32];
+  uint64_t budgetNs = (uint64_t)BENCH_DEFAULT_MS * 1000000u;
+  uint32_t kernel;
+  uint32_t i;
+  target_t tgt;
+  bool first = true;
+
+  if (argc > 1) {
+    budgetNs = (uint64_t)strtoul(argv[1], NULL, 10) * 1000000u;
+  }
+
+  //
+  // The batch lays its messages out side by side, BENCH_MAX_BYTES covers
+  // BENCH_BATCH_MSGS of BENCH_BATCH_MAX
+  //
+  pIn = (uint8_t*)malloc(BENCH_MAX_BYTES);
+  pOut = (uint8_t*)malloc(BENCH_MAX_BYTES);
+  if (pIn == NULL || pOut == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+  for (i = 0; i < BENCH_MAX_BYTES; i++) {
+    pIn[i] = (uint8_t)(i * 131 + 7);
+  }
+  memset(pOut, 0, BENCH_MAX_BYTES);
+  for (i = 0; i < sizeof(key); i++) {
+    key[i] = (uint8_t)i;
+    nonce[i] = (uint8_t)(0x80 + i);
+  }
+
+  //
+  // Numbers for a build that gets the wrong answer are no use
+  //
+  if (NORXSelfTest(stderr) != 0) {
+    fprintf(stderr, "self test failed, not benchmarking\n");
+    return 1;
+  }
+  NORXStatsReset();
+
+  NORXKeyInit(&keySched, key);
+  pPool = NORXPoolCreate(0, 0);
+  if (pPool == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  snprintf(coreName, sizeof(coreName), "NORX%u-%u-%u",
+           (unsigned)WORD_LEN, (unsigned)RND_NUM, (unsigned)PARALLEL);
+  snprintf(poolName, sizeof(poolName), "NORX%u-%u-chunked",
+           (unsigned)WORD_LEN, (unsigned)RND_NUM);
+
+  printf("{\n  \"core\": \"%s\",\n  \"compiler\": \"%s\",\n"
+         "  \"flags\": \"%s\",\n  \"selftest\": true,\n  \"tsc\": %s,\n  \"ms_per_point\": %llu,\n"
+         "  \"pool_threads\": %u,\n  \"pool_lane_bytes\": %zu,\n"
+         "  \"results\": [\n",
+         coreName,
+#ifdef __VERSION__
+         __VERSION__,
+#else
+         "unknown",
+#endif
+         NORX_BENCH_FLAGS,
+#ifdef BENCH_TSC
+         "true",
+#else
+         "false",
+#endif
+         (unsigned long long)(budgetNs / 1000000u),
+         (unsigned)NORXPoolThreads(pPool), NORXPoolLaneBytes(pPool));
+
+  for (kernel = 0; kernel < KERNEL_COUNT; kernel++) {
+    if (!NORXSetKernel(kernel)) {
+      continue;
+    }
+    tgt.variant = coreName;
+    tgt.kernel = NORXKernelName(kernel);
+    tgt.pfnEnc = NORXEnc;
+
+    tgt.type = TARGET_CORE;
+    benchTarget(&tgt, budgetNs, &first);
+    tgt.type = TARGET_KEYED;
+    benchTarget(&tgt, budgetNs, &first);
+    tgt.type = TARGET_BATCH;
+    benchTarget(&tgt, budgetNs, &first);
+    tgt.type = TARGET_POOL;
+    tgt.variant = poolName;
+    benchTarget(&tgt, budgetNs, &first);
+  }
+  NORXSelectKernel();
+
+  for (i = 0; i < NORXVariantCount; i++) {
+    tgt.type = TARGET_ENGINE;
+    tgt.variant = NORXVariants[i].name;
+    tgt.kernel = "engine";
+    tgt.pfnEnc = NORXVariants[i].pfnEnc;
+    benchTarget(&tgt, budgetNs, &first);
+  }
+
+  printf("\n  ],\n");
+  printStats();
+  printf("}\n");
+
+  NORXKeyWipe(&keySched);
+  NORXPoolDestroy(pPool);
+  free(pIn);
+  free(pOut);
+
+  return 0;
+}
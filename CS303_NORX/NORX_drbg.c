@@ -0,0 +1,246 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_drbg.c                                                         *
+* Purpose -> Deterministic random bit generator on the NORX permutation       *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Seed/Reseed/Fill, Bulk Fill on the Batch F      *
+*                                                                             *
+* The state starts as NORX initialise() would with an all zero key and        *
+* nonce, minus the P parameter so every build gives the same bytes. Seeds     *
+* are absorbed like a header under DRBG_SEED_DOMAIN. Each squeeze XORs        *
+* DRBG_OUT_DOMAIN into word 15, runs F and hands out the rate; a fill takes   *
+* what is left of the last squeeze first.                                     *
+*                                                                             *
+* One state is one F per rate block, and every F waits on the one before.     *
+* A long fill instead forks BATCH_LANES lanes off the state, lane j being     *
+* the state with j + 1 XORed into each rate word, and squeezes them all with  *
+* one batch F under DRBG_BULK_DOMAIN. Block n of the run comes from lane      *
+* n % BATCH_LANES. The main state is then squeezed once and that block        *
+* thrown away, so the next fork starts from a new state.                      *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdio.h>     // fopen, fread
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_simd.h"  // Batch kernel and BATCH_LANES
+#include "NORX_drbg.h"  // Generator and prototypes
+
+//*****************************************************************************
+// Word i of lane j in a batch buffer, see NORX_simd.h
+//*****************************************************************************
+#define BATCH_WORD(pwB, i, j)  ((pwB)[(i) * BATCH_LANES + (j)])
+
+//*****************************************************************************
+// Seed bytes NORXDrbgLocal() reads from the OS
+//*****************************************************************************
+#define DRBG_LOCAL_SEED   64
+
+//*****************************************************************************
+//
+// Function -> squeeze
+// Purpose -> Run the main state on to its next rate block
+//
+//*****************************************************************************
+static void
+squeeze(norx_drbg_t* pCtx) {
+  pCtx->S[15] ^= DRBG_OUT_DOMAIN;
+  F(pCtx->S);
+  pCtx->pos = 0;
+}
+
+//*****************************************************************************
+//
+// Function -> bulkFill
+// Purpose -> Squeeze blocks whole rate blocks from lanes forked off the main
+//            state, then move the main state on
+// Inputs -> norx_drbg_t* pCtx - Generator
+//           uint8_t* pOut - blocks * RATE_BYTES bytes out
+//           size_t blocks - Number of blocks
+//
+//*****************************************************************************
+static void
+bulkFill(norx_drbg_t* pCtx, uint8_t* pOut, size_t blocks) {
+  word_t B[BATCH_WORDS];
+  uint32_t n;
+  uint32_t i;
+  uint32_t j;
+
+  for (j = 0; j < BATCH_LANES; j++) {
+    for (i = 0; i < 16; i++) {
+      BATCH_WORD(B, i, j) = pCtx->S[i];
+    }
+    for (i = 0; i < RATE_WORDS; i++) {
+      BATCH_WORD(B, i, j) ^= (word_t)(j + 1);
+    }
+  }
+
+  while (blocks > 0) {
+    for (j = 0; j < BATCH_LANES; j++) {
+      BATCH_WORD(B, 15, j) ^= DRBG_BULK_DOMAIN;
+    }
+    pfnPermuteBatch(B);
+
+    n = (blocks < BATCH_LANES) ? (uint32_t)blocks : BATCH_LANES;
+    for (j = 0; j < n; j++) {
+      for (i = 0; i < RATE_WORDS; i++) {
+        storeWord(pOut + i * WORD_BYTES, BATCH_WORD(B, i, j));
+      }
+      pOut += RATE_BYTES;
+    }
+    blocks -= n;
+  }
+  wipe(B, sizeof(B));
+
+  squeeze(pCtx);
+  pCtx->pos = RATE_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDrbgSeed
+// Purpose -> Start a generator from a seed
+// Inputs -> norx_drbg_t* pCtx - Generator
+//           const uint8_t* pSeed - Seed bytes
+//           size_t len - Bytes in the seed
+//
+//*****************************************************************************
+void
+NORXDrbgSeed(norx_drbg_t* pCtx, const uint8_t* pSeed, size_t len) {
+  static const word_t U[8] = { U8, U9, U10, U11, U12, U13, U14, U15 };
+  uint32_t i;
+
+  for (i = 0; i < 8; i++) {
+    pCtx->S[i] = 0;
+    pCtx->S[i + 8] = U[i];
+  }
+  pCtx->S[12] ^= WORD_LEN;
+  pCtx->S[13] ^= RND_NUM;
+  pCtx->S[15] ^= TAG_LEN;
+  F(pCtx->S);
+
+  absorb(pCtx->S, pSeed, len, DRBG_SEED_DOMAIN);
+  pCtx->pos = RATE_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDrbgReseed
+// Purpose -> Mix more seed into a running generator, what was left of the
+//            last squeeze is dropped
+// Inputs -> As NORXDrbgSeed()
+//
+//*****************************************************************************
+void
+NORXDrbgReseed(norx_drbg_t* pCtx, const uint8_t* pSeed, size_t len) {
+  absorb(pCtx->S, pSeed, len, DRBG_SEED_DOMAIN);
+  pCtx->pos = RATE_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDrbgFill
+// Purpose -> Next len bytes of the generator
+// Inputs -> norx_drbg_t* pCtx - Generator
+//           uint8_t* pOut - Bytes out
+//           size_t len - How many
+//
+//*****************************************************************************
+void
+NORXDrbgFill(norx_drbg_t* pCtx, uint8_t* pOut, size_t len) {
+  size_t blocks;
+  size_t n;
+  uint32_t i;
+
+  //
+  // What is left of the last squeeze
+  //
+  while (len > 0 && pCtx->pos < RATE_BYTES) {
+    *pOut++ = (uint8_t)(pCtx->S[pCtx->pos / WORD_BYTES] >>
+                        (8 * (pCtx->pos % WORD_BYTES)));
+    pCtx->pos++;
+    len--;
+  }
+
+  //
+  // Whole blocks, forked across the batch lanes when there are enough
+  //
+  blocks = len / RATE_BYTES;
+  if (blocks >= DRBG_BULK_BLOCKS) {
+    bulkFill(pCtx, pOut, blocks);
+  }
+  else if (blocks > 0) {
+    for (n = 0; n < blocks; n++) {
+      squeeze(pCtx);
+      for (i = 0; i < RATE_WORDS; i++) {
+        storeWord(pOut + n * RATE_BYTES + i * WORD_BYTES, pCtx->S[i]);
+      }
+    }
+    pCtx->pos = RATE_BYTES;
+  }
+  pOut += blocks * RATE_BYTES;
+  len -= blocks * RATE_BYTES;
+
+  //
+  // Start of one more block
+  //
+  if (len > 0) {
+    squeeze(pCtx);
+    while (len > 0) {
+      *pOut++ = (uint8_t)(pCtx->S[pCtx->pos / WORD_BYTES] >>
+                          (8 * (pCtx->pos % WORD_BYTES)));
+      pCtx->pos++;
+      len--;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDrbgWipe
+// Purpose -> Clear a generator once it is no longer needed
+//
+//*****************************************************************************
+void
+NORXDrbgWipe(norx_drbg_t* pCtx) {
+  wipe(pCtx, sizeof(*pCtx));
+}
+
+//*****************************************************************************
+//
+// Function -> NORXDrbgLocal
+// Purpose -> The calling thread's generator, seeded from the OS the first
+//            time a thread asks
+// Returns -> The generator, NULL if /dev/urandom could not be read
+//
+//*****************************************************************************
+norx_drbg_t*
+NORXDrbgLocal(void) {
+  static _Thread_local norx_drbg_t local;
+  static _Thread_local bool seeded;
+  uint8_t seed[DRBG_LOCAL_SEED];
+  FILE* pF;
+  size_t got;
+
+  if (!seeded) {
+    pF = fopen("/dev/urandom", "rb");
+    if (pF == NULL) {
+      return NULL;
+    }
+    got = fread(seed, 1, sizeof(seed), pF);
+    fclose(pF);
+    if (got != sizeof(seed)) {
+      return NULL;
+    }
+    NORXDrbgSeed(&local, seed, sizeof(seed));
+    wipe(seed, sizeof(seed));
+    seeded = true;
+  }
+  return &local;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_drbg.h                                                         *
+* Purpose -> Deterministic random bit generator, a sponge on F that squeezes  *
+*            the rate after each call                                         *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Seed/Reseed/Fill, Bulk Fill on the Batch F      *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_DRBG_H
+#define NORX_DRBG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+#include "NORX_simd.h"
+
+//*****************************************************************************
+// Domains, above the AEAD ones so no generator state is ever an AEAD state
+//*****************************************************************************
+#define DRBG_SEED_DOMAIN   0x40    // Absorbing seed bytes
+#define DRBG_OUT_DOMAIN    0x80    // Squeezing the main state
+#define DRBG_BULK_DOMAIN   0x100   // Squeezing the lanes of a bulk fill
+
+//*****************************************************************************
+// Whole rate blocks a fill must ask for before it goes through the batch F
+//*****************************************************************************
+#define DRBG_BULK_BLOCKS   (2 * BATCH_LANES)
+
+//*****************************************************************************
+// Generator. Not shared between threads: give each thread its own, or use
+// NORXDrbgLocal().
+//*****************************************************************************
+typedef struct {
+  word_t S[16];               // State, 4x4 matrix of words
+  uint32_t pos;               // Rate bytes of the last squeeze handed out
+} norx_drbg_t;
+
+//*****************************************************************************
+// DRBG Prototypes
+//
+// The output is fixed by the seed and the lengths of the fill calls: the
+// same seed and the same calls give the same bytes on every kernel and
+// every PARALLEL build.
+//
+// NORXDrbgSeed() - Start from the seed, any length
+// NORXDrbgReseed() - Mix more seed into the state
+// NORXDrbgFill() - Next len bytes. Runs of at least DRBG_BULK_BLOCKS whole
+//                  blocks are squeezed from BATCH_LANES lanes forked off the
+//                  state, one batch F for every BATCH_LANES blocks.
+// NORXDrbgWipe() - Clear the state
+// NORXDrbgLocal() - This thread's generator, seeded from /dev/urandom on
+//                   first use. NULL if that fails.
+//*****************************************************************************
+extern void NORXDrbgSeed(norx_drbg_t* pCtx, const uint8_t* pSeed, size_t len);
+extern void NORXDrbgReseed(norx_drbg_t* pCtx, const uint8_t* pSeed, size_t len);
+extern void NORXDrbgFill(norx_drbg_t* pCtx, uint8_t* pOut, size_t len);
+extern void NORXDrbgWipe(norx_drbg_t* pCtx);
+extern norx_drbg_t* NORXDrbgLocal(void);
+
+#endif // NORX_DRBG_H
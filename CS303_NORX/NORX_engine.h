@@ -0,0 +1,542 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_engine.h                                                       *
+* Purpose -> NORX engine written once and stamped out per variant. Include    *
+*            it with the parameters below defined and it emits a full byte    *
+*            oriented NORX with every name prefixed by ENGINE_NAME.           *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Word Size, Rounds and Parallelism as Include    *
+*                             Parameters                                      *
+*            2.0 10/17/2026 - Tag Compared through a volatile, State Wiped    *
+*                                                                             *
+* Parameters, all undefined again at the end of this file:                    *
+*   ENGINE_NAME - prefix for the emitted names, e.g. NORX64_4_1               *
+*   ENGINE_W    - word size, 32 or 64                                         *
+*   ENGINE_L    - rounds, 4, 6 or 8                                           *
+*   ENGINE_P    - parallelism, 1, 2 or 4                                      *
+*                                                                             *
+* Emits ENGINE_NAME##Enc() and ENGINE_NAME##Dec(), everything else is static. *
+* Rotations and constants are macros of the parameters and F is unrolled      *
+* over locals, so each copy folds down to straight line code for its word     *
+* size and round count.                                                       *
+*                                                                             *
+******************************************************************************/
+
+//
+// No include guard, this file is meant to be included once per variant
+//
+#if !defined(ENGINE_NAME) || !defined(ENGINE_W) || !defined(ENGINE_L) || \
+    !defined(ENGINE_P)
+  #error "define ENGINE_NAME, ENGINE_W, ENGINE_L and ENGINE_P first"
+#endif
+
+#if ENGINE_L != 4 && ENGINE_L != 6 && ENGINE_L != 8
+  #error "ENGINE_L must be 4, 6 or 8"
+#endif
+
+#if ENGINE_P != 1 && ENGINE_P != 2 && ENGINE_P != 4
+  #error "ENGINE_P must be 1, 2 or 4"
+#endif
+
+//*****************************************************************************
+// Name pasting, ENG(Enc) becomes NORX64_4_1Enc
+//*****************************************************************************
+#ifndef ENG_CAT
+  #define ENG_CAT2(a, b)  a##b
+  #define ENG_CAT(a, b)   ENG_CAT2(a, b)
+#endif
+#define ENG(x)          ENG_CAT(ENGINE_NAME, x)
+
+//*****************************************************************************
+// Word type, rotations and initialisation constants for the word size
+//*****************************************************************************
+#if ENGINE_W == 32
+  #define ENG_WORD  uint32_t
+  #define ENG_R0    8
+  #define ENG_R1    11
+  #define ENG_R2    16
+  #define ENG_R3    31
+  #define ENG_U8    0xa3d8d930
+  #define ENG_U9    0x3fa8b72c
+  #define ENG_U10   0xed84eb49
+  #define ENG_U11   0xedca4787
+  #define ENG_U12   0x335463eb
+  #define ENG_U13   0xf994220b
+  #define ENG_U14   0xbe0bf5c9
+  #define ENG_U15   0xd7c49104
+#elif ENGINE_W == 64
+  #define ENG_WORD  uint64_t
+  #define ENG_R0    8
+  #define ENG_R1    19
+  #define ENG_R2    40
+  #define ENG_R3    63
+  #define ENG_U8    0xb15e641748de5e6b
+  #define ENG_U9    0xaa95e955e10f8410
+  #define ENG_U10   0x28d1034441a9dd40
+  #define ENG_U11   0x7f31bbf964e93bf5
+  #define ENG_U12   0xb5e9e22493dffb96
+  #define ENG_U13   0xb980c852479fafbd
+  #define ENG_U14   0xda24516bf55eafd4
+  #define ENG_U15   0x86026ae8536f1501
+#else
+  #error "ENGINE_W must be 32 or 64"
+#endif
+
+//*****************************************************************************
+// Sizes in bytes
+//*****************************************************************************
+#define ENG_WORD_BYTES  (ENGINE_W / 8)
+#define ENG_RATE_BYTES  (12 * ENG_WORD_BYTES)
+#define ENG_TAG_BYTES   (4 * ENG_WORD_BYTES)
+
+//*****************************************************************************
+// Permutation pieces on named words
+//*****************************************************************************
+#define ENG_ROT(x, n)   (((x) >> (n)) | ((x) << (ENGINE_W - (n))))
+#define ENG_H(x, y)     (((x) ^ (y)) ^ (((x) & (y)) << 1))
+
+#define ENG_G(a, b, c, d)               \
+  do {                                  \
+    a = ENG_H(a, b);                    \
+    d = ENG_ROT(a ^ d, ENG_R0);         \
+    c = ENG_H(c, d);                    \
+    b = ENG_ROT(b ^ c, ENG_R1);         \
+    a = ENG_H(a, b);                    \
+    d = ENG_ROT(a ^ d, ENG_R2);         \
+    c = ENG_H(c, d);                    \
+    b = ENG_ROT(b ^ c, ENG_R3);         \
+  } while (0)
+
+#define ENG_ROUND()                     \
+  do {                                  \
+    ENG_G(s0, s4, s8, s12);             \
+    ENG_G(s1, s5, s9, s13);             \
+    ENG_G(s2, s6, s10, s14);            \
+    ENG_G(s3, s7, s11, s15);            \
+    ENG_G(s0, s5, s10, s15);            \
+    ENG_G(s1, s6, s11, s12);            \
+    ENG_G(s2, s7, s8, s13);             \
+    ENG_G(s3, s4, s9, s14);             \
+  } while (0)
+
+//*****************************************************************************
+//
+// Function -> Permute
+// Purpose -> F over all ENGINE_L rounds, unrolled with the state in locals
+// Input -> ENG_WORD* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+static inline void
+ENG(Permute)(ENG_WORD* pwS) {
+  ENG_WORD s0 = pwS[0];
+  ENG_WORD s1 = pwS[1];
+  ENG_WORD s2 = pwS[2];
+  ENG_WORD s3 = pwS[3];
+  ENG_WORD s4 = pwS[4];
+  ENG_WORD s5 = pwS[5];
+  ENG_WORD s6 = pwS[6];
+  ENG_WORD s7 = pwS[7];
+  ENG_WORD s8 = pwS[8];
+  ENG_WORD s9 = pwS[9];
+  ENG_WORD s10 = pwS[10];
+  ENG_WORD s11 = pwS[11];
+  ENG_WORD s12 = pwS[12];
+  ENG_WORD s13 = pwS[13];
+  ENG_WORD s14 = pwS[14];
+  ENG_WORD s15 = pwS[15];
+
+  ENG_ROUND();
+  ENG_ROUND();
+  ENG_ROUND();
+  ENG_ROUND();
+#if ENGINE_L >= 6
+  ENG_ROUND();
+  ENG_ROUND();
+#endif
+#if ENGINE_L >= 8
+  ENG_ROUND();
+  ENG_ROUND();
+#endif
+
+  pwS[0] = s0;
+  pwS[1] = s1;
+  pwS[2] = s2;
+  pwS[3] = s3;
+  pwS[4] = s4;
+  pwS[5] = s5;
+  pwS[6] = s6;
+  pwS[7] = s7;
+  pwS[8] = s8;
+  pwS[9] = s9;
+  pwS[10] = s10;
+  pwS[11] = s11;
+  pwS[12] = s12;
+  pwS[13] = s13;
+  pwS[14] = s14;
+  pwS[15] = s15;
+}
+
+//*****************************************************************************
+//
+// Function -> Load / Store
+// Purpose -> Little endian word access on unaligned bytes
+//
+//*****************************************************************************
+static inline ENG_WORD
+ENG(Load)(const uint8_t* pIn) {
+  ENG_WORD w = 0;
+  int i;
+
+  for (i = ENG_WORD_BYTES - 1; i >= 0; i--) {
+    w = (w << 8) | pIn[i];
+  }
+  return w;
+}
+
+static inline void
+ENG(Store)(uint8_t* pOut, ENG_WORD w) {
+  int i;
+
+  for (i = 0; i < ENG_WORD_BYTES; i++) {
+    pOut[i] = (uint8_t)(w >> (8 * i));
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> Pad
+// Purpose -> Copy a short last block into a full one with 10*1 padding
+//
+//*****************************************************************************
+static inline void
+ENG(Pad)(uint8_t* pBlock, const uint8_t* pIn, size_t len) {
+  memset(pBlock, 0, ENG_RATE_BYTES);
+  memcpy(pBlock, pIn, len);
+  pBlock[len] = 0x01;
+  pBlock[ENG_RATE_BYTES - 1] |= 0x80;
+}
+
+//*****************************************************************************
+//
+// Function -> Wipe
+// Purpose -> Clear state and tag bytes in a way the compiler can not drop,
+//            like wipe() in NORX.c, which a variant does not link against
+//
+//*****************************************************************************
+static inline void
+ENG(Wipe)(void* p, size_t len) {
+  volatile uint8_t* pV = (volatile uint8_t*)p;
+
+  while (len-- > 0) {
+    *pV++ = 0;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> Initialise
+// Purpose -> Load nonce, key and constants, fold in the parameters and run F
+//
+//*****************************************************************************
+static void
+ENG(Initialise)(ENG_WORD* pwS, const uint8_t* pK, const uint8_t* pN) {
+  int i;
+
+  for (i = 0; i < 4; i++) {
+    pwS[i] = ENG(Load)(pN + i * ENG_WORD_BYTES);
+    pwS[4 + i] = ENG(Load)(pK + i * ENG_WORD_BYTES);
+  }
+  pwS[8] = ENG_U8;
+  pwS[9] = ENG_U9;
+  pwS[10] = ENG_U10;
+  pwS[11] = ENG_U11;
+  pwS[12] = ENG_U12 ^ ENGINE_W;
+  pwS[13] = ENG_U13 ^ ENGINE_L;
+  pwS[14] = ENG_U14 ^ ENGINE_P;
+  pwS[15] = ENG_U15 ^ (4 * ENGINE_W);
+
+  ENG(Permute)(pwS);
+
+  for (i = 0; i < 4; i++) {
+    pwS[12 + i] ^= ENG(Load)(pK + i * ENG_WORD_BYTES);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> Absorb
+// Purpose -> Absorb header or trailer bytes under the given domain
+//
+//*****************************************************************************
+static inline void
+ENG(AbsorbBlock)(ENG_WORD* pwS, const uint8_t* pIn, ENG_WORD domain) {
+  int i;
+
+  pwS[15] ^= domain;
+  ENG(Permute)(pwS);
+  for (i = 0; i < 12; i++) {
+    pwS[i] ^= ENG(Load)(pIn + i * ENG_WORD_BYTES);
+  }
+}
+
+static void
+ENG(Absorb)(ENG_WORD* pwS, const uint8_t* pIn, size_t len, ENG_WORD domain) {
+  uint8_t block[ENG_RATE_BYTES];
+
+  if (len == 0) {
+    return;
+  }
+  for (; len >= ENG_RATE_BYTES; len -= ENG_RATE_BYTES) {
+    ENG(AbsorbBlock)(pwS, pIn, domain);
+    pIn += ENG_RATE_BYTES;
+  }
+  ENG(Pad)(block, pIn, len);
+  ENG(AbsorbBlock)(pwS, block, domain);
+}
+
+//*****************************************************************************
+//
+// Function -> EncryptBlock / DecryptBlock
+// Purpose -> One payload block on one lane, the last block goes through a
+//            padded copy
+//
+//*****************************************************************************
+static inline void
+ENG(EncryptBlock)(ENG_WORD* pwS, uint8_t* pOut, const uint8_t* pIn) {
+  int i;
+
+  pwS[15] ^= 0x02;
+  ENG(Permute)(pwS);
+  for (i = 0; i < 12; i++) {
+    pwS[i] ^= ENG(Load)(pIn + i * ENG_WORD_BYTES);
+    ENG(Store)(pOut + i * ENG_WORD_BYTES, pwS[i]);
+  }
+}
+
+static void
+ENG(EncryptLast)(ENG_WORD* pwS, uint8_t* pOut, const uint8_t* pIn, size_t len) {
+  uint8_t block[ENG_RATE_BYTES];
+
+  ENG(Pad)(block, pIn, len);
+  ENG(EncryptBlock)(pwS, block, block);
+  memcpy(pOut, block, len);
+}
+
+static inline void
+ENG(DecryptBlock)(ENG_WORD* pwS, uint8_t* pOut, const uint8_t* pIn) {
+  ENG_WORD c;
+  int i;
+
+  pwS[15] ^= 0x02;
+  ENG(Permute)(pwS);
+  for (i = 0; i < 12; i++) {
+    c = ENG(Load)(pIn + i * ENG_WORD_BYTES);
+    ENG(Store)(pOut + i * ENG_WORD_BYTES, pwS[i] ^ c);
+    pwS[i] = c;
+  }
+}
+
+static void
+ENG(DecryptLast)(ENG_WORD* pwS, uint8_t* pOut, const uint8_t* pIn, size_t len) {
+  uint8_t block[ENG_RATE_BYTES];
+  ENG_WORD c;
+  int i;
+
+  pwS[15] ^= 0x02;
+  ENG(Permute)(pwS);
+
+  //
+  // Key stream with the cipher text laid over it, then the padding bits
+  //
+  for (i = 0; i < 12; i++) {
+    ENG(Store)(block + i * ENG_WORD_BYTES, pwS[i]);
+  }
+  memcpy(block, pIn, len);
+  block[len] ^= 0x01;
+  block[ENG_RATE_BYTES - 1] ^= 0x80;
+
+  for (i = 0; i < 12; i++) {
+    c = ENG(Load)(block + i * ENG_WORD_BYTES);
+    ENG(Store)(block + i * ENG_WORD_BYTES, pwS[i] ^ c);
+    pwS[i] = c;
+  }
+  memcpy(pOut, block, len);
+}
+
+//*****************************************************************************
+//
+// Function -> Payload
+// Purpose -> Encrypt or decrypt the payload. With ENGINE_P lanes the state
+//            is branched, block i goes to lane i % ENGINE_P and the lanes
+//            are merged back at the end.
+//
+//*****************************************************************************
+static void
+ENG(Payload)(ENG_WORD* pwS, uint8_t* pOut, const uint8_t* pIn, size_t len,
+             bool dec) {
+  ENG_WORD lanes[ENGINE_P][16];
+  size_t block;
+  int lane;
+  int i;
+
+  if (len == 0) {
+    return;
+  }
+
+#if ENGINE_P > 1
+  for (lane = 0; lane < ENGINE_P; lane++) {
+    memcpy(lanes[lane], pwS, sizeof(lanes[lane]));
+    lanes[lane][15] ^= 0x10;
+    ENG(Permute)(lanes[lane]);
+    for (i = 0; i < 12; i++) {
+      lanes[lane][i] ^= (ENG_WORD)lane;
+    }
+  }
+#else
+  memcpy(lanes[0], pwS, sizeof(lanes[0]));
+#endif
+
+  for (block = 0; len >= ENG_RATE_BYTES; block++) {
+    if (dec) {
+      ENG(DecryptBlock)(lanes[block % ENGINE_P], pOut, pIn);
+    }
+    else {
+      ENG(EncryptBlock)(lanes[block % ENGINE_P], pOut, pIn);
+    }
+    len -= ENG_RATE_BYTES;
+    pIn += ENG_RATE_BYTES;
+    pOut += ENG_RATE_BYTES;
+  }
+  if (dec) {
+    ENG(DecryptLast)(lanes[block % ENGINE_P], pOut, pIn, len);
+  }
+  else {
+    ENG(EncryptLast)(lanes[block % ENGINE_P], pOut, pIn, len);
+  }
+
+#if ENGINE_P > 1
+  memset(pwS, 0, 16 * sizeof(ENG_WORD));
+  for (lane = 0; lane < ENGINE_P; lane++) {
+    lanes[lane][15] ^= 0x20;
+    ENG(Permute)(lanes[lane]);
+    for (i = 0; i < 16; i++) {
+      pwS[i] ^= lanes[lane][i];
+    }
+  }
+#else
+  (void)lane;
+  (void)i;
+  memcpy(pwS, lanes[0], sizeof(lanes[0]));
+#endif
+  ENG(Wipe)(lanes, sizeof(lanes));
+}
+
+//*****************************************************************************
+//
+// Function -> Finalise
+// Purpose -> Two keyed F calls under the final domain, tag is s12 - s15
+//
+//*****************************************************************************
+static void
+ENG(Finalise)(ENG_WORD* pwS, uint8_t* pTag, const uint8_t* pK) {
+  int i;
+
+  pwS[15] ^= 0x08;
+  ENG(Permute)(pwS);
+  for (i = 0; i < 4; i++) {
+    pwS[12 + i] ^= ENG(Load)(pK + i * ENG_WORD_BYTES);
+  }
+  ENG(Permute)(pwS);
+  for (i = 0; i < 4; i++) {
+    pwS[12 + i] ^= ENG(Load)(pK + i * ENG_WORD_BYTES);
+    ENG(Store)(pTag + i * ENG_WORD_BYTES, pwS[12 + i]);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> Enc
+// Purpose -> Full NORX encryption of byte strings
+// Inputs -> const uint8_t* pK - Key, 4 words
+//           const uint8_t* pN - Nonce, 4 words
+//           const uint8_t* pA, aLen - Header
+//           const uint8_t* pM, mLen - Message
+//           const uint8_t* pZ, zLen - Trailer
+//           uint8_t* pC - Cipher text, mLen bytes
+//           uint8_t* pT - Tag, 4 words
+//
+//*****************************************************************************
+void
+ENG(Enc)(const uint8_t* pK, const uint8_t* pN,
+         const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t mLen,
+         const uint8_t* pZ, size_t zLen, uint8_t* pC, uint8_t* pT) {
+  ENG_WORD S[16];
+
+  ENG(Initialise)(S, pK, pN);
+  ENG(Absorb)(S, pA, aLen, 0x01);
+  ENG(Payload)(S, pC, pM, mLen, false);
+  ENG(Absorb)(S, pZ, zLen, 0x04);
+  ENG(Finalise)(S, pT, pK);
+  ENG(Wipe)(S, sizeof(S));
+}
+
+//*****************************************************************************
+//
+// Function -> Dec
+// Purpose -> Full NORX decryption of byte strings
+// Inputs -> Same as Enc with pC, cLen the cipher text and pM the message out
+// Returns -> true if the tag matches, the message is only good then. The
+//            tags are compared in constant time, like tagMatch() does.
+//
+//*****************************************************************************
+bool
+ENG(Dec)(const uint8_t* pK, const uint8_t* pN,
+         const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+         const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM) {
+  ENG_WORD S[16];
+  uint8_t tag[ENG_TAG_BYTES];
+  volatile uint8_t diff = 0;
+  int i;
+
+  ENG(Initialise)(S, pK, pN);
+  ENG(Absorb)(S, pA, aLen, 0x01);
+  ENG(Payload)(S, pM, pC, cLen, true);
+  ENG(Absorb)(S, pZ, zLen, 0x04);
+  ENG(Finalise)(S, tag, pK);
+
+  for (i = 0; i < ENG_TAG_BYTES; i++) {
+    diff |= tag[i] ^ pT[i];
+  }
+  ENG(Wipe)(S, sizeof(S));
+  ENG(Wipe)(tag, sizeof(tag));
+  return diff == 0;
+}
+
+//*****************************************************************************
+// Clear the parameters so the next variant can be stamped out
+//*****************************************************************************
+#undef ENG
+#undef ENG_WORD
+#undef ENG_R0
+#undef ENG_R1
+#undef ENG_R2
+#undef ENG_R3
+#undef ENG_U8
+#undef ENG_U9
+#undef ENG_U10
+#undef ENG_U11
+#undef ENG_U12
+#undef ENG_U13
+#undef ENG_U14
+#undef ENG_U15
+#undef ENG_WORD_BYTES
+#undef ENG_RATE_BYTES
+#undef ENG_TAG_BYTES
+#undef ENG_ROT
+#undef ENG_H
+#undef ENG_G
+#undef ENG_ROUND
+#undef ENGINE_NAME
+#undef ENGINE_W
+#undef ENGINE_L
+#undef ENGINE_P
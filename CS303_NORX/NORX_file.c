@@ -0,0 +1,471 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_file.c                                                         *
+* Purpose -> Encrypt and decrypt files through mmap, the file is cut into     *
+*            chunks that are sealed as messages of their own on every core    *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Memory Mapped File Tool                         *
+*            2.0 10/17/2026 - Refuses Input as Output, Output Preallocated    *
+*            3.0 10/17/2026 - Header Size Checked without Overflow            *
+*                                                                             *
+* Build -> gcc -O2 -pthread NORX.c NORX_simd.c NORX_file.c -o NORX_file       *
+* Usage -> NORX_file -e|-d -k keyfile [-t threads] [-c chunk KiB] in out      *
+*                                                                             *
+* The key file holds KEY_BYTES raw bytes. The output file is sized up front   *
+* and mapped writable, so cipher text goes straight from the kernel's page    *
+* cache for the input to the one for the output, nothing is on the heap.      *
+*                                                                             *
+* Layout of an encrypted file, numbers little endian:                         *
+*   magic "NORXFILE", W, L, P, 0, chunk size (4 bytes), plain size (8 bytes), *
+*   base nonce (NONCE_BYTES), then per chunk its cipher text and its tag.     *
+* Chunk n uses the base nonce with n XORed into its first 8 bytes, and has    *
+* the whole file header as its header A, so chunks can not be moved, dropped  *
+* or taken from another file. An empty file still has one empty chunk.        *
+*                                                                             *
+* The output may not be the input file, however it is named. Its blocks are   *
+* allocated with posix_fallocate() before it is mapped, so a full disk fails  *
+* up front. On any error once the output is created, a failed tag included,   *
+* the output file is removed again.                                           *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <errno.h>     // errno
+#include <fcntl.h>     // open, posix_fallocate
+#include <pthread.h>   // Worker threads
+#include <stdatomic.h> // Chunk counter
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdio.h>     // fprintf
+#include <stdlib.h>    // strtoul
+#include <string.h>    // memcpy, memcmp
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <time.h>      // clock_gettime
+#include <unistd.h>    // getopt, ftruncate, sysconf
+
+#include "NORX.h"      // NORX defines and prototypes
+#include "NORX_simd.h" // NORXSelectKernel()
+
+//*****************************************************************************
+// Settings
+//*****************************************************************************
+#define FILE_MAGIC          "NORXFILE"
+#define FILE_HEADER_BYTES   (8 + 4 + 4 + 8 + NONCE_BYTES)
+#define FILE_CHUNK_KIB      1024
+#define FILE_MAX_THREADS    64
+
+//*****************************************************************************
+// One run of the tool, shared by every worker
+//*****************************************************************************
+typedef struct {
+  norx_key_t key;             // Key schedule
+  uint8_t hdr[FILE_HEADER_BYTES];  // File header, header A of every chunk
+  const uint8_t* pIn;         // Mapped input, past the header when decrypting
+  uint8_t* pOut;              // Mapped output, past the header when encrypting
+  uint64_t size;              // Plain text bytes
+  size_t chunk;               // Plain text bytes per chunk
+  uint64_t chunks;            // Chunks in the file, at least 1
+  bool dec;                   // Decrypt rather than encrypt
+  atomic_uint_fast64_t next;  // Next chunk to hand out
+  atomic_bool bad;            // A tag did not match
+} job_t;
+
+//*****************************************************************************
+//
+// Function -> put32 / put64 / get32 / get64
+// Purpose -> Little endian integers in the file header
+//
+//*****************************************************************************
+static void
+put32(uint8_t* p, uint32_t x) {
+  int i;
+
+  for (i = 0; i < 4; i++) {
+    p[i] = (uint8_t)(x >> (8 * i));
+  }
+}
+
+static void
+put64(uint8_t* p, uint64_t x) {
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    p[i] = (uint8_t)(x >> (8 * i));
+  }
+}
+
+static uint32_t
+get32(const uint8_t* p) {
+  uint32_t x = 0;
+  int i;
+
+  for (i = 3; i >= 0; i--) {
+    x = (x << 8) | p[i];
+  }
+  return x;
+}
+
+static uint64_t
+get64(const uint8_t* p) {
+  uint64_t x = 0;
+  int i;
+
+  for (i = 7; i >= 0; i--) {
+    x = (x << 8) | p[i];
+  }
+  return x;
+}
+
+//*****************************************************************************
+//
+// Function -> chunkNonce
+// Purpose -> Base nonce from the header with n XORed into its first 8 bytes
+//
+//*****************************************************************************
+static void
+chunkNonce(const job_t* pJob, uint64_t n, uint8_t* pN) {
+  int i;
+
+  memcpy(pN, pJob->hdr + FILE_HEADER_BYTES - NONCE_BYTES, NONCE_BYTES);
+  for (i = 0; i < 8; i++) {
+    pN[i] ^= (uint8_t)(n >> (8 * i));
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> workerMain
+// Purpose -> Seal or open chunks off the shared counter until none are left
+//
+//*****************************************************************************
+static void*
+workerMain(void* pArg) {
+  job_t* pJob = (job_t*)pArg;
+  uint8_t nonce[NONCE_BYTES];
+  const uint8_t* pIn;
+  uint8_t* pOut;
+  uint64_t n;
+  size_t len;
+
+  while ((n = atomic_fetch_add(&pJob->next, 1)) < pJob->chunks) {
+    len = (size_t)(pJob->size - n * pJob->chunk);
+    len = (len < pJob->chunk) ? len : pJob->chunk;
+    chunkNonce(pJob, n, nonce);
+
+    //
+    // The chunk's tag follows its cipher text
+    //
+    if (pJob->dec) {
+      pIn = pJob->pIn + n * (pJob->chunk + TAG_BYTES);
+      pOut = pJob->pOut + n * pJob->chunk;
+      if (!NORXKeyDec(&pJob->key, nonce, pJob->hdr, FILE_HEADER_BYTES,
+                      pIn, len, NULL, 0, pIn + len, pOut)) {
+        atomic_store(&pJob->bad, true);
+      }
+    }
+    else {
+      pIn = pJob->pIn + n * pJob->chunk;
+      pOut = pJob->pOut + n * (pJob->chunk + TAG_BYTES);
+      NORXKeyEnc(&pJob->key, nonce, pJob->hdr, FILE_HEADER_BYTES,
+                 pIn, len, NULL, 0, pOut, pOut + len);
+    }
+  }
+
+  return NULL;
+}
+
+//*****************************************************************************
+//
+// Function -> readKey
+// Purpose -> Load KEY_BYTES raw bytes from a file
+// Returns -> false if the file is missing or short
+//
+//*****************************************************************************
+static bool
+readKey(const char* pPath, uint8_t* pK) {
+  FILE* pF = fopen(pPath, "rb");
+  size_t got;
+
+  if (pF == NULL) {
+    return false;
+  }
+  got = fread(pK, 1, KEY_BYTES, pF);
+  fclose(pF);
+
+  return got == KEY_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> randomNonce
+// Purpose -> Fresh base nonce from the OS
+//
+//*****************************************************************************
+static bool
+randomNonce(uint8_t* pN) {
+  FILE* pF = fopen("/dev/urandom", "rb");
+  size_t got;
+
+  if (pF == NULL) {
+    return false;
+  }
+  got = fread(pN, 1, NONCE_BYTES, pF);
+  fclose(pF);
+
+  return got == NONCE_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> usage
+//
+//*****************************************************************************
+static int
+usage(void) {
+  fprintf(stderr, "usage: NORX_file -e|-d -k keyfile [-t threads] "
+                  "[-c chunk KiB] in out\n");
+  return 2;
+}
+
+//*****************************************************************************
+//
+// Function -> main
+// Purpose -> Map both files, run the chunks on the worker threads and say
+//            how fast it went
+//
+//*****************************************************************************
+int
+main(int argc, char** argv) {
+  static job_t job;
+  pthread_t threads[FILE_MAX_THREADS];
+  uint8_t k[KEY_BYTES];
+  const char* pKeyPath = NULL;
+  const uint8_t* pMapIn = NULL;
+  uint8_t* pMapOut = NULL;
+  struct stat st;
+  struct stat stOut;
+  struct timespec t0;
+  struct timespec t1;
+  uint64_t inBytes;
+  uint64_t outBytes;
+  uint32_t count = 0;
+  uint32_t started;
+  uint32_t i;
+  double secs;
+  long cpus;
+  int mode = 0;
+  int fdIn;
+  int fdOut;
+  int opt;
+  int err;
+
+  job.chunk = (size_t)FILE_CHUNK_KIB << 10;
+  while ((opt = getopt(argc, argv, "edk:t:c:")) != -1) {
+    switch (opt) {
+      case 'e':
+      case 'd':
+        mode = opt;
+        break;
+      case 'k':
+        pKeyPath = optarg;
+        break;
+      case 't':
+        count = (uint32_t)strtoul(optarg, NULL, 10);
+        break;
+      case 'c':
+        job.chunk = (size_t)strtoul(optarg, NULL, 10) << 10;
+        break;
+      default:
+        return usage();
+    }
+  }
+  if (mode == 0 || pKeyPath == NULL || optind + 2 != argc ||
+      job.chunk == 0 || job.chunk > UINT32_MAX) {
+    return usage();
+  }
+  if (count == 0) {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    count = (cpus > 0) ? (uint32_t)cpus : 1;
+  }
+  if (count > FILE_MAX_THREADS) {
+    count = FILE_MAX_THREADS;
+  }
+  job.dec = (mode == 'd');
+
+  if (!readKey(pKeyPath, k)) {
+    fprintf(stderr, "%s: need %d key bytes\n", pKeyPath, KEY_BYTES);
+    return 1;
+  }
+  NORXSelectKernel();
+  NORXKeyInit(&job.key, k);
+  wipe(k, sizeof(k));
+
+  fdIn = open(argv[optind], O_RDONLY);
+  if (fdIn < 0 || fstat(fdIn, &st) != 0) {
+    perror(argv[optind]);
+    return 1;
+  }
+  inBytes = (uint64_t)st.st_size;
+  if (inBytes > 0) {
+    pMapIn = (const uint8_t*)mmap(NULL, inBytes, PROT_READ, MAP_SHARED,
+                                  fdIn, 0);
+    if (pMapIn == MAP_FAILED) {
+      perror("mmap");
+      return 1;
+    }
+    madvise((void*)pMapIn, inBytes, MADV_SEQUENTIAL);
+  }
+
+  //
+  // Header: new when encrypting, read and checked when decrypting
+  //
+  if (!job.dec) {
+    memcpy(job.hdr, FILE_MAGIC, 8);
+    job.hdr[8] = WORD_LEN;
+    job.hdr[9] = RND_NUM;
+    job.hdr[10] = PARALLEL;
+    job.hdr[11] = 0;
+    put32(job.hdr + 12, (uint32_t)job.chunk);
+    put64(job.hdr + 16, inBytes);
+    if (!randomNonce(job.hdr + 24)) {
+      fprintf(stderr, "no random nonce\n");
+      return 1;
+    }
+    job.size = inBytes;
+    job.pIn = pMapIn;
+  }
+  else {
+    if (inBytes < FILE_HEADER_BYTES || memcmp(pMapIn, FILE_MAGIC, 8) != 0 ||
+        pMapIn[8] != WORD_LEN || pMapIn[9] != RND_NUM ||
+        pMapIn[10] != PARALLEL || get32(pMapIn + 12) == 0) {
+      fprintf(stderr, "%s: not a file for this NORX build\n", argv[optind]);
+      return 1;
+    }
+    memcpy(job.hdr, pMapIn, FILE_HEADER_BYTES);
+    job.chunk = get32(job.hdr + 12);
+    job.size = get64(job.hdr + 16);
+    job.pIn = pMapIn + FILE_HEADER_BYTES;
+  }
+
+  //
+  // The plain size of a file being decrypted comes from its header, so it
+  // must fit in the file before anything is worked out from it, and the
+  // chunk count and sealed size are worked out so they can not wrap
+  //
+  if (job.dec && job.size > inBytes - FILE_HEADER_BYTES) {
+    fprintf(stderr, "%s: size does not match its header\n", argv[optind]);
+    return 1;
+  }
+  job.chunks = job.size / job.chunk + (job.size % job.chunk != 0);
+  if (job.chunks == 0) {
+    job.chunks = 1;
+  }
+  if (job.chunks > (UINT64_MAX - FILE_HEADER_BYTES - job.size) / TAG_BYTES) {
+    fprintf(stderr, "%s: too large\n", argv[optind]);
+    return 1;
+  }
+
+  outBytes = job.size + job.chunks * TAG_BYTES + FILE_HEADER_BYTES;
+  if (job.dec) {
+    if (outBytes != inBytes) {
+      fprintf(stderr, "%s: size does not match its header\n", argv[optind]);
+      return 1;
+    }
+    outBytes = job.size;
+  }
+
+  //
+  // Not truncated until it is known not to be the input. The blocks are
+  // allocated up front, so a full disk is an error here and not a SIGBUS
+  // on a store into the map
+  //
+  fdOut = open(argv[optind + 1], O_RDWR | O_CREAT, 0600);
+  if (fdOut < 0) {
+    perror(argv[optind + 1]);
+    return 1;
+  }
+  if (fstat(fdOut, &stOut) != 0) {
+    perror(argv[optind + 1]);
+    unlink(argv[optind + 1]);
+    return 1;
+  }
+  if (stOut.st_dev == st.st_dev && stOut.st_ino == st.st_ino) {
+    fprintf(stderr, "%s: same file as the input\n", argv[optind + 1]);
+    return 1;
+  }
+  if (ftruncate(fdOut, 0) != 0) {
+    perror(argv[optind + 1]);
+    unlink(argv[optind + 1]);
+    return 1;
+  }
+  if (outBytes > 0) {
+    err = posix_fallocate(fdOut, 0, (off_t)outBytes);
+    if (err != 0) {
+      errno = err;
+      perror(argv[optind + 1]);
+      unlink(argv[optind + 1]);
+      return 1;
+    }
+    pMapOut = (uint8_t*)mmap(NULL, outBytes, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fdOut, 0);
+    if (pMapOut == MAP_FAILED) {
+      perror("mmap");
+      unlink(argv[optind + 1]);
+      return 1;
+    }
+  }
+  if (job.dec) {
+    job.pOut = pMapOut;
+  }
+  else {
+    memcpy(pMapOut, job.hdr, FILE_HEADER_BYTES);
+    job.pOut = pMapOut + FILE_HEADER_BYTES;
+  }
+
+  //
+  // The main thread is worker 0
+  //
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  atomic_init(&job.next, 0);
+  atomic_init(&job.bad, false);
+  for (started = 1; started < count; started++) {
+    if (pthread_create(&threads[started], NULL, workerMain, &job) != 0) {
+      break;
+    }
+  }
+  workerMain(&job);
+  for (i = 1; i < started; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  if (pMapOut != NULL) {
+    munmap(pMapOut, outBytes);
+  }
+  if (pMapIn != NULL) {
+    munmap((void*)pMapIn, inBytes);
+  }
+  close(fdOut);
+  close(fdIn);
+  NORXKeyWipe(&job.key);
+
+  if (atomic_load(&job.bad)) {
+    fprintf(stderr, "%s: tag mismatch, output removed\n", argv[optind]);
+    unlink(argv[optind + 1]);
+    return 1;
+  }
+
+  secs = (double)(t1.tv_sec - t0.tv_sec) +
+         (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+  fprintf(stderr, "%s %llu bytes in %llu chunks on %u threads, %.3f s, "
+                  "%.1f MB/s\n",
+          job.dec ? "decrypted" : "encrypted", (unsigned long long)job.size,
+          (unsigned long long)job.chunks, (unsigned)started, secs,
+          (secs > 0) ? (double)job.size / secs / 1e6 : 0.0);
+
+  return 0;
+}
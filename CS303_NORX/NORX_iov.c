@@ -0,0 +1,190 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_iov.c                                                          *
+* Purpose -> Scatter/gather NORX over the stream API                          *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - iovec Seal and Open                             *
+*            2.0 10/17/2026 - Tag Checked by tagMatch()                       *
+*            3.0 10/17/2026 - Tag Checked by NORXStreamFinalCheck()           *
+*                                                                             *
+* The stream context already carries an open rate block from one call to      *
+* the next, so a fragment list is just a stream fed one piece at a time. On   *
+* the payload the input and output lists are walked together and each piece   *
+* is the longest run that stays inside one input and one output fragment.     *
+* Whole blocks in a piece go straight from and to the caller's buffers, only  *
+* the bytes of a block cut by a fragment edge are done one at a time.         *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <sys/uio.h>   // struct iovec
+
+#include "NORX.h"        // NORX defines and prototypes
+#include "NORX_stream.h" // Stream context
+#include "NORX_iov.h"    // Prototypes
+
+//*****************************************************************************
+//
+// Function -> iovBytes
+// Purpose -> Total bytes in a fragment list
+//
+//*****************************************************************************
+static size_t
+iovBytes(const struct iovec* pV, size_t cnt) {
+  size_t len = 0;
+  size_t i;
+
+  for (i = 0; i < cnt; i++) {
+    len += pV[i].iov_len;
+  }
+  return len;
+}
+
+//*****************************************************************************
+//
+// Function -> absorbIov
+// Purpose -> Feed a header or trailer list to the stream
+//
+//*****************************************************************************
+static void
+absorbIov(norx_stream_t* pCtx, const struct iovec* pV, size_t cnt,
+          bool trailer) {
+  size_t i;
+
+  for (i = 0; i < cnt; i++) {
+    if (trailer) {
+      NORXStreamTrailer(pCtx, (const uint8_t*)pV[i].iov_base, pV[i].iov_len);
+    }
+    else {
+      NORXStreamHeader(pCtx, (const uint8_t*)pV[i].iov_base, pV[i].iov_len);
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> cryptIov
+// Purpose -> Encrypt or decrypt the payload list into the output list
+// Inputs -> norx_stream_t* pCtx - Stream
+//           const struct iovec* pIn, inCnt - Payload fragments
+//           const struct iovec* pOut, outCnt - Output fragments, at least
+//                                              as many bytes as pIn
+//           bool dec - Decrypt rather than encrypt
+//
+//*****************************************************************************
+static void
+cryptIov(norx_stream_t* pCtx, const struct iovec* pIn, size_t inCnt,
+         const struct iovec* pOut, size_t outCnt, bool dec) {
+  size_t i = 0;
+  size_t o = 0;
+  size_t inOff = 0;
+  size_t outOff = 0;
+  size_t take;
+  const uint8_t* pSrc;
+  uint8_t* pDst;
+
+  while (i < inCnt && o < outCnt) {
+    if (inOff == pIn[i].iov_len) {
+      i++;
+      inOff = 0;
+      continue;
+    }
+    if (outOff == pOut[o].iov_len) {
+      o++;
+      outOff = 0;
+      continue;
+    }
+
+    take = pIn[i].iov_len - inOff;
+    if (take > pOut[o].iov_len - outOff) {
+      take = pOut[o].iov_len - outOff;
+    }
+    pSrc = (const uint8_t*)pIn[i].iov_base + inOff;
+    pDst = (uint8_t*)pOut[o].iov_base + outOff;
+    if (dec) {
+      NORXStreamDecrypt(pCtx, pSrc, take, pDst);
+    }
+    else {
+      NORXStreamEncrypt(pCtx, pSrc, take, pDst);
+    }
+    inOff += take;
+    outOff += take;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> NORXIovEnc
+// Purpose -> Seal a message given as fragment lists
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//           const struct iovec* pA, aCnt - Header fragments
+//           const struct iovec* pM, mCnt - Message fragments
+//           const struct iovec* pZ, zCnt - Trailer fragments
+//           const struct iovec* pC, cCnt - Cipher text fragments
+//           uint8_t* pT - Tag, TAG_BYTES
+// Returns -> false if pC holds fewer bytes than pM
+//
+//*****************************************************************************
+bool
+NORXIovEnc(const norx_key_t* pKey, const uint8_t* pN,
+           const struct iovec* pA, size_t aCnt,
+           const struct iovec* pM, size_t mCnt,
+           const struct iovec* pZ, size_t zCnt,
+           const struct iovec* pC, size_t cCnt, uint8_t* pT) {
+  norx_stream_t ctx;
+
+  if (iovBytes(pC, cCnt) < iovBytes(pM, mCnt)) {
+    return false;
+  }
+
+  NORXStreamInitKey(&ctx, pKey, pN);
+  absorbIov(&ctx, pA, aCnt, false);
+  cryptIov(&ctx, pM, mCnt, pC, cCnt, false);
+  absorbIov(&ctx, pZ, zCnt, true);
+  NORXStreamFinal(&ctx, pT);
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXIovDec
+// Purpose -> Open a message given as fragment lists
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//           const struct iovec* pA, aCnt - Header fragments
+//           const struct iovec* pC, cCnt - Cipher text fragments
+//           const struct iovec* pZ, zCnt - Trailer fragments
+//           const uint8_t* pT - Tag from encryption, TAG_BYTES
+//           const struct iovec* pM, mCnt - Message fragments
+// Returns -> true if the tag matches, false if it does not or pM holds
+//            fewer bytes than pC. On a mismatch pM holds the unauthenticated
+//            plain text
+//
+//*****************************************************************************
+bool
+NORXIovDec(const norx_key_t* pKey, const uint8_t* pN,
+           const struct iovec* pA, size_t aCnt,
+           const struct iovec* pC, size_t cCnt,
+           const struct iovec* pZ, size_t zCnt,
+           const uint8_t* pT,
+           const struct iovec* pM, size_t mCnt) {
+  norx_stream_t ctx;
+
+  if (iovBytes(pM, mCnt) < iovBytes(pC, cCnt)) {
+    return false;
+  }
+
+  NORXStreamInitKey(&ctx, pKey, pN);
+  absorbIov(&ctx, pA, aCnt, false);
+  cryptIov(&ctx, pC, cCnt, pM, mCnt, true);
+  absorbIov(&ctx, pZ, zCnt, true);
+
+  return NORXStreamFinalCheck(&ctx, pT);
+}
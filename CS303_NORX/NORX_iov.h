@@ -0,0 +1,48 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_iov.h                                                          *
+* Purpose -> Scatter/gather NORX, header, payload, trailer and output are     *
+*            each given as a list of fragments                                *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - iovec Seal and Open                             *
+*            2.0 10/17/2026 - Plain Text Left on a Failed Tag Documented      *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_IOV_H
+#define NORX_IOV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// iovec Prototypes. Fragments may have any length, 0 included, the message
+// is the fragments one after the other. The output list only has to hold at
+// least as many bytes as the input and may be cut up differently. Giving the
+// same list for both works in place.
+//
+// NORXIovEnc() - NORXKeyEnc() on fragment lists. false if pC is too short,
+//                nothing is written then.
+// NORXIovDec() - NORXKeyDec() on fragment lists. false if pM is too short or
+//                the tag does not match. The plain text is written as it is
+//                decrypted, so when the tag does not match pM still holds
+//                it, unauthenticated. The caller must discard it, there is
+//                no verify first form like NORXKeyDecVerify().
+//*****************************************************************************
+extern bool NORXIovEnc(const norx_key_t* pKey, const uint8_t* pN,
+                       const struct iovec* pA, size_t aCnt,
+                       const struct iovec* pM, size_t mCnt,
+                       const struct iovec* pZ, size_t zCnt,
+                       const struct iovec* pC, size_t cCnt, uint8_t* pT);
+extern bool NORXIovDec(const norx_key_t* pKey, const uint8_t* pN,
+                       const struct iovec* pA, size_t aCnt,
+                       const struct iovec* pC, size_t cCnt,
+                       const struct iovec* pZ, size_t zCnt,
+                       const uint8_t* pT,
+                       const struct iovec* pM, size_t mCnt);
+
+#endif // NORX_IOV_H
@@ -0,0 +1,281 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_mac.c                                                          *
+* Purpose -> Authentication only NORX: initialise, absorb the message under   *
+*            the header domain, finalise                                      *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Keyed MAC, One Shot, Streaming and Batched      *
+*            2.0 10/17/2026 - NORX_STATS Counts for the Streaming Blocks      *
+*                                                                             *
+* With no payload there is no branch, no lane states and no output buffer,    *
+* each rate block of the message is one domain XOR, one F and one rate XOR.   *
+* Whole blocks go through absorbBlocks(), the fused loop on the scalar        *
+* kernel. The streaming context is the header half of the stream context:     *
+* the open block carries over from one update to the next and is padded by    *
+* NORXMacFinal(). Batches reuse the multi buffer engine with empty payloads   *
+* and trailers, which it skips.                                               *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <string.h>    // memcpy()
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_stats.h" // Domain counters
+#include "NORX_simd.h"  // BATCH_LANES
+#include "NORX_batch.h" // Multi buffer engine
+#include "NORX_mac.h"   // MAC context and prototypes
+
+//*****************************************************************************
+// Messages handed to the batch engine per call. Each call drains its lanes
+// at the end, so a group is many times the lane count.
+//*****************************************************************************
+#define MAC_GROUP   (16 * BATCH_LANES)
+
+//*****************************************************************************
+//
+// Function -> NORXMac
+// Purpose -> Tag of a message
+// Inputs -> const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//           const uint8_t* pMsg - Message
+//           size_t len - Bytes in the message
+//           uint8_t* pT - Tag, TAG_BYTES
+//
+//*****************************************************************************
+void
+NORXMac(const norx_key_t* pKey, const uint8_t* pN,
+        const uint8_t* pMsg, size_t len, uint8_t* pT) {
+  word_t S[16];
+  word_t outT[TAG_WORDS];
+  uint32_t i;
+
+  initialiseKey(pKey, pN, S);
+  absorb(S, pMsg, len, HEADER_DOMAIN);
+  finalise(S, pKey->K, FINAL_DOMAIN, outT);
+
+  for (i = 0; i < TAG_WORDS; i++) {
+    storeWord(pT + i * WORD_BYTES, outT[i]);
+  }
+  wipe(S, sizeof(S));
+}
+
+//*****************************************************************************
+//
+// Function -> NORXMacVerify
+// Purpose -> Check the tag of a message
+// Inputs -> As NORXMac(), pT is the tag to check
+// Returns -> true if the tag matches
+//
+//*****************************************************************************
+bool
+NORXMacVerify(const norx_key_t* pKey, const uint8_t* pN,
+              const uint8_t* pMsg, size_t len, const uint8_t* pT) {
+  word_t S[16];
+  word_t outT[TAG_WORDS];
+
+  initialiseKey(pKey, pN, S);
+  absorb(S, pMsg, len, HEADER_DOMAIN);
+  finalise(S, pKey->K, FINAL_DOMAIN, outT);
+  wipe(S, sizeof(S));
+
+  return tagMatch(outT, pT);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXMacInit
+// Purpose -> Start a streaming MAC
+// Inputs -> norx_mac_t* pCtx - Context
+//           const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//
+//*****************************************************************************
+void
+NORXMacInit(norx_mac_t* pCtx, const norx_key_t* pKey, const uint8_t* pN) {
+  initialiseKey(pKey, pN, pCtx->S);
+  memcpy(pCtx->K, pKey->K, sizeof(pCtx->K));
+  pCtx->len = 0;
+  pCtx->pos = RATE_BYTES;
+  pCtx->done = false;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXMacUpdate
+// Purpose -> Absorb the next piece of the message
+// Inputs -> norx_mac_t* pCtx - Context
+//           const uint8_t* pMsg - Piece of the message
+//           size_t len - Bytes in the piece
+// Returns -> false if the MAC was finalised already
+//
+//*****************************************************************************
+bool
+NORXMacUpdate(norx_mac_t* pCtx, const uint8_t* pMsg, size_t len) {
+  size_t blocks;
+
+  if (pCtx->done) {
+    return false;
+  }
+  pCtx->len += len;
+
+  //
+  // Top up the open block
+  //
+  STATS_DOMAIN(HEADER_DOMAIN, 0, 0, (len < RATE_BYTES - pCtx->pos) ?
+               len : RATE_BYTES - pCtx->pos);
+  while (len > 0 && pCtx->pos < RATE_BYTES) {
+    pCtx->S[pCtx->pos / WORD_BYTES] ^=
+      (word_t)*pMsg++ << (8 * (pCtx->pos % WORD_BYTES));
+    pCtx->pos++;
+    len--;
+  }
+
+  //
+  // Whole blocks straight from the input
+  //
+  blocks = len / RATE_BYTES;
+  absorbBlocks(pCtx->S, pMsg, blocks, HEADER_DOMAIN);
+  pMsg += blocks * RATE_BYTES;
+  len -= blocks * RATE_BYTES;
+
+  //
+  // Open a block for what is left
+  //
+  if (len > 0) {
+    STATS_DOMAIN(HEADER_DOMAIN, 1, 1, len);
+    pCtx->S[15] ^= HEADER_DOMAIN;
+    F(pCtx->S);
+    pCtx->pos = 0;
+    while (len > 0) {
+      pCtx->S[pCtx->pos / WORD_BYTES] ^=
+        (word_t)*pMsg++ << (8 * (pCtx->pos % WORD_BYTES));
+      pCtx->pos++;
+      len--;
+    }
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXMacFinal
+// Purpose -> Pad the last block and produce the tag, the context is wiped
+// Inputs -> norx_mac_t* pCtx - Context
+//           uint8_t* pT - Tag, TAG_BYTES
+// Returns -> false if the MAC was finalised already
+//
+//*****************************************************************************
+bool
+NORXMacFinal(norx_mac_t* pCtx, uint8_t* pT) {
+  word_t tag[TAG_WORDS];
+  uint32_t i;
+
+  if (pCtx->done) {
+    return false;
+  }
+
+  //
+  // An empty message absorbs nothing, one that ended on a block boundary
+  // gets an empty padded block like absorb() gives it
+  //
+  if (pCtx->len > 0) {
+    if (pCtx->pos == RATE_BYTES) {
+      STATS_DOMAIN(HEADER_DOMAIN, 1, 1, 0);
+      pCtx->S[15] ^= HEADER_DOMAIN;
+      F(pCtx->S);
+      pCtx->pos = 0;
+    }
+    pad(pCtx->S, pCtx->pos);
+  }
+
+  finalise(pCtx->S, pCtx->K, FINAL_DOMAIN, tag);
+  for (i = 0; i < TAG_WORDS; i++) {
+    storeWord(pT + i * WORD_BYTES, tag[i]);
+  }
+
+  wipe(pCtx, sizeof(*pCtx));
+  pCtx->done = true;
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> runGroups
+// Purpose -> Hand the messages to the batch engine MAC_GROUP at a time, as
+//            headers with no payload or trailer
+// Returns -> Number of tags that matched when checking
+//
+//*****************************************************************************
+static size_t
+runGroups(const norx_mac_msg_t* pMsgs, size_t count, bool check, bool* pOk) {
+  norx_msg_t grp[MAC_GROUP];
+  size_t good = 0;
+  size_t n;
+  size_t i;
+
+  while (count > 0) {
+    n = (count < MAC_GROUP) ? count : MAC_GROUP;
+    for (i = 0; i < n; i++) {
+      grp[i].pK = pMsgs[i].pK;
+      grp[i].pN = pMsgs[i].pN;
+      grp[i].pA = pMsgs[i].pMsg;
+      grp[i].aLen = pMsgs[i].len;
+      grp[i].pIn = NULL;
+      grp[i].inLen = 0;
+      grp[i].pZ = NULL;
+      grp[i].zLen = 0;
+      grp[i].pOut = NULL;
+      grp[i].pT = pMsgs[i].pT;
+    }
+
+    if (check) {
+      good += NORXBatchOpen(grp, n, pOk);
+      if (pOk != NULL) {
+        pOk += n;
+      }
+    }
+    else {
+      NORXBatchSeal(grp, n);
+    }
+    pMsgs += n;
+    count -= n;
+  }
+
+  return good;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXMacBatch
+// Purpose -> Tag every message of the batch
+// Inputs -> const norx_mac_msg_t* pMsgs - Messages
+//           size_t count - Number of messages
+//
+//*****************************************************************************
+void
+NORXMacBatch(const norx_mac_msg_t* pMsgs, size_t count) {
+  runGroups(pMsgs, count, false, NULL);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXMacBatchCheck
+// Purpose -> Check the tag of every message of the batch
+// Inputs -> const norx_mac_msg_t* pMsgs - Messages
+//           size_t count - Number of messages
+//           bool* pOk - Tag result per message, may be NULL
+// Returns -> Number of tags that matched
+//
+//*****************************************************************************
+size_t
+NORXMacBatchCheck(const norx_mac_msg_t* pMsgs, size_t count, bool* pOk) {
+  return runGroups(pMsgs, count, true, pOk);
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_mac.h                                                          *
+* Purpose -> Authentication only NORX, the message is absorbed as a header    *
+*            and the tag is all that comes out                                *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Keyed MAC, One Shot, Streaming and Batched      *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_MAC_H
+#define NORX_MAC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// MAC context. As in the stream context the open rate block lives in the
+// state: its F has already run and pos counts how much of it is used.
+//*****************************************************************************
+typedef struct {
+  word_t S[16];               // State, 4x4 matrix of words
+  word_t K[4];                // Key words, finalise() needs them again
+  uint64_t len;               // Bytes taken
+  uint32_t pos;               // Bytes of the open block used, RATE_BYTES if none
+  bool done;                  // NORXMacFinal() has run
+} norx_mac_t;
+
+//*****************************************************************************
+// One message of a MAC batch. NORXMacBatch() writes pT, NORXMacBatchCheck()
+// checks it.
+//*****************************************************************************
+typedef struct {
+  const uint8_t* pK;          // Key, KEY_BYTES
+  const uint8_t* pN;          // Nonce, NONCE_BYTES
+  const uint8_t* pMsg;        // Message
+  size_t len;
+  uint8_t* pT;                // Tag, TAG_BYTES
+} norx_mac_msg_t;
+
+//*****************************************************************************
+// MAC Prototypes
+//
+// The tag is the NORX tag of a message whose header is the MAC message and
+// whose payload and trailer are empty, so NORXKeyEnc() with only pA gives
+// the same tag. Nothing is encrypted, so a fixed nonce may be used when the
+// tag only has to be a keyed hash of the message.
+//
+// NORXMac() / NORXMacVerify() - One shot, Verify is true if pT matches
+// NORXMacInit() / NORXMacUpdate() / NORXMacFinal() - Streaming, the message
+//                 may arrive in pieces of any length. Update and Final return
+//                 false once Final has run, Final wipes the context.
+// NORXMacBatch() / NORXMacBatchCheck() - Many messages through the batch
+//                 kernel, Check returns how many tags matched and pOk gets
+//                 the result per message when it is not NULL
+//*****************************************************************************
+extern void NORXMac(const norx_key_t* pKey, const uint8_t* pN,
+                    const uint8_t* pMsg, size_t len, uint8_t* pT);
+extern bool NORXMacVerify(const norx_key_t* pKey, const uint8_t* pN,
+                          const uint8_t* pMsg, size_t len, const uint8_t* pT);
+extern void NORXMacInit(norx_mac_t* pCtx, const norx_key_t* pKey,
+                        const uint8_t* pN);
+extern bool NORXMacUpdate(norx_mac_t* pCtx, const uint8_t* pMsg, size_t len);
+extern bool NORXMacFinal(norx_mac_t* pCtx, uint8_t* pT);
+extern void NORXMacBatch(const norx_mac_msg_t* pMsgs, size_t count);
+extern size_t NORXMacBatchCheck(const norx_mac_msg_t* pMsgs, size_t count,
+                                bool* pOk);
+
+#endif // NORX_MAC_H
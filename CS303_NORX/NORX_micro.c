@@ -0,0 +1,551 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_micro.c                                                        *
+* Purpose -> Micro benchmark of the permutation pieces, G(), col(), diag(),   *
+*            H(), rightRot() and F per kernel, with hardware counters where   *
+*            the kernel lets us read them                                     *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Latency and Throughput of the F Pieces          *
+*                                                                             *
+* Build -> gcc -O2 NORX.c NORX_simd.c NORX_micro.c -o NORX_micro              *
+*          add -DWORD_64 for NORX64                                           *
+* Usage -> NORX_micro [ms per point]                                          *
+*                                                                             *
+* Every piece is run two ways. Latency feeds each call the result of the one  *
+* before, so the time per call is the length of its dependency chain.         *
+* Throughput runs MICRO_STATES independent states round robin, so the CPU     *
+* can overlap them and the time per call is bound by the execution ports.    *
+* A piece whose two numbers are close is port bound, one whose throughput is  *
+* much better than its latency is latency bound. F also runs through the lane *
+* and batch kernels, which is throughput by construction.                     *
+*                                                                             *
+* Cycles, instructions, branch misses and L1D read misses come from one       *
+* perf_event_open() group counting user space only. Where that is not        *
+* allowed (perf_event_paranoid, containers) the counters are null and only    *
+* the clock and the TSC are reported. The scalar pieces are external calls   *
+* into NORX.c, so their numbers include the call.                            *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <linux/perf_event.h> // Hardware counter events
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdio.h>     // printf
+#include <stdlib.h>    // strtoul
+#include <string.h>    // memcpy, memcmp
+#include <sys/ioctl.h> // Counter enable and disable
+#include <sys/syscall.h> // perf_event_open
+#include <time.h>      // clock_gettime
+#include <unistd.h>    // syscall, read, close
+
+#include "NORX.h"      // NORX defines and prototypes
+#include "NORX_simd.h" // Kernels and dispatch
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <x86intrin.h>
+  #define MICRO_TSC  0x1
+#endif
+
+//*****************************************************************************
+// Settings
+//*****************************************************************************
+#define MICRO_STATES      8     // Independent states for throughput
+#define MICRO_TRIALS      5
+#define MICRO_DEFAULT_MS  20
+
+//*****************************************************************************
+// Hardware counters, in the order they sit in the group
+//*****************************************************************************
+#define CTR_CYCLES        0
+#define CTR_INSTRUCTIONS  1
+#define CTR_BRANCH_MISSES 2
+#define CTR_L1D_MISSES    3
+#define CTR_COUNT         4
+
+static const char* ctrNames[CTR_COUNT] = {
+  "cycles", "instructions", "branch_misses", "l1d_misses"
+};
+
+//*****************************************************************************
+// One point: a piece, how it runs and on which kernel
+//*****************************************************************************
+#define MODE_LATENCY      0
+#define MODE_THROUGHPUT   1
+
+typedef void (*run_t)(size_t iters);
+
+typedef struct {
+  const char* piece;
+  uint32_t mode;            // MODE_xxx
+  uint32_t states;          // States per call
+  run_t pfnRun;             // Runs iters calls
+  bool scalarOnly;          // Same code on every kernel, run it once
+} point_t;
+
+typedef struct {
+  uint64_t ns;
+  uint64_t tsc;
+  uint64_t ctr[CTR_COUNT];
+} sample_t;
+
+//*****************************************************************************
+// States, words and the counter group
+//*****************************************************************************
+static word_t states[MICRO_STATES * BATCH_WORDS];
+static word_t words[MICRO_STATES];
+static volatile word_t sink;
+static int ctrFd[CTR_COUNT] = { -1, -1, -1, -1 };
+static uint32_t ctrIndex[CTR_COUNT];   // Position of each counter in a read
+
+//*****************************************************************************
+//
+// Function -> nowNs / nowTsc
+// Purpose -> Monotonic time in ns and the TSC, 0 where there is none
+//
+//*****************************************************************************
+static uint64_t
+nowNs(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t
+nowTsc(void) {
+#ifdef MICRO_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+//*****************************************************************************
+//
+// Function -> ctrOpen
+// Purpose -> Open the counter group, cycles leading. A member the CPU does
+//            not have is left out, no leader means no counters at all.
+// Returns -> true if at least the cycle counter is open
+//
+//*****************************************************************************
+static bool
+ctrOpen(void) {
+  static const uint32_t types[CTR_COUNT] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+    PERF_TYPE_HW_CACHE
+  };
+  static const uint64_t configs[CTR_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+  };
+  struct perf_event_attr attr;
+  uint32_t opened = 0;
+  uint32_t i;
+
+  for (i = 0; i < CTR_COUNT; i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = types[i];
+    attr.config = configs[i];
+    attr.disabled = (i == CTR_CYCLES) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    ctrFd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1,
+                            ctrFd[CTR_CYCLES], 0);
+    if (ctrFd[i] >= 0) {
+      ctrIndex[i] = opened++;
+    }
+    else if (i == CTR_CYCLES) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> measure
+// Purpose -> Time iters calls of a point, counters included when open
+//
+//*****************************************************************************
+static void
+measure(const point_t* pPt, size_t iters, sample_t* pS) {
+  uint64_t buf[1 + CTR_COUNT];
+  uint32_t i;
+
+  memset(pS, 0, sizeof(*pS));
+  if (ctrFd[CTR_CYCLES] >= 0) {
+    ioctl(ctrFd[CTR_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(ctrFd[CTR_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  pS->tsc = nowTsc();
+  pS->ns = nowNs();
+
+  pPt->pfnRun(iters);
+
+  pS->ns = nowNs() - pS->ns;
+  pS->tsc = nowTsc() - pS->tsc;
+  if (ctrFd[CTR_CYCLES] >= 0) {
+    ioctl(ctrFd[CTR_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if (read(ctrFd[CTR_CYCLES], buf, sizeof(buf)) > 0) {
+      for (i = 0; i < CTR_COUNT; i++) {
+        if (ctrFd[i] >= 0 && ctrIndex[i] < buf[0]) {
+          pS->ctr[i] = buf[1 + ctrIndex[i]];
+        }
+      }
+    }
+  }
+}
+
+//*****************************************************************************
+// The pieces. Latency loops chain every call on the one before, throughput
+// loops go round MICRO_STATES independent states or words.
+//*****************************************************************************
+static void
+fLatency(size_t iters) {
+  for (; iters > 0; iters--) {
+    pfnPermute(states);
+  }
+}
+
+static void
+fThroughput(size_t iters) {
+  uint32_t j;
+
+  for (; iters > 0; iters--) {
+    for (j = 0; j < MICRO_STATES; j++) {
+      pfnPermute(states + 16 * j);
+    }
+  }
+}
+
+static void
+lanesThroughput(size_t iters) {
+  for (; iters > 0; iters--) {
+    pfnPermuteLanes(states);
+  }
+}
+
+static void
+batchThroughput(size_t iters) {
+  for (; iters > 0; iters--) {
+    pfnPermuteBatch(states);
+  }
+}
+
+static void
+gLatency(size_t iters) {
+  for (; iters > 0; iters--) {
+    G(states, 0, 4, 8, 12);
+  }
+}
+
+static void
+gThroughput(size_t iters) {
+  uint32_t j;
+
+  for (; iters > 0; iters--) {
+    for (j = 0; j < MICRO_STATES; j++) {
+      G(states + 16 * j, 0, 4, 8, 12);
+    }
+  }
+}
+
+static void
+colLatency(size_t iters) {
+  for (; iters > 0; iters--) {
+    col(states);
+  }
+}
+
+static void
+colThroughput(size_t iters) {
+  uint32_t j;
+
+  for (; iters > 0; iters--) {
+    for (j = 0; j < MICRO_STATES; j++) {
+      col(states + 16 * j);
+    }
+  }
+}
+
+static void
+diagLatency(size_t iters) {
+  for (; iters > 0; iters--) {
+    diag(states);
+  }
+}
+
+static void
+diagThroughput(size_t iters) {
+  uint32_t j;
+
+  for (; iters > 0; iters--) {
+    for (j = 0; j < MICRO_STATES; j++) {
+      diag(states + 16 * j);
+    }
+  }
+}
+
+static void
+hLatency(size_t iters) {
+  word_t x = words[0];
+
+  for (; iters > 0; iters--) {
+    x = H(x, words[1]);
+  }
+  sink = x;
+}
+
+static void
+hThroughput(size_t iters) {
+  word_t x[MICRO_STATES];
+  uint32_t j;
+
+  memcpy(x, words, sizeof(x));
+  for (; iters > 0; iters--) {
+    for (j = 0; j < MICRO_STATES; j++) {
+      x[j] = H(x[j], words[1]);
+    }
+  }
+  sink = x[0] ^ x[MICRO_STATES - 1];
+}
+
+static void
+rotLatency(size_t iters) {
+  word_t x = words[0];
+
+  for (; iters > 0; iters--) {
+    x = rightRot(x, R0);
+  }
+  sink = x;
+}
+
+static void
+rotThroughput(size_t iters) {
+  word_t x[MICRO_STATES];
+  uint32_t j;
+
+  memcpy(x, words, sizeof(x));
+  for (; iters > 0; iters--) {
+    for (j = 0; j < MICRO_STATES; j++) {
+      x[j] = rightRot(x[j], R0);
+    }
+  }
+  sink = x[0] ^ x[MICRO_STATES - 1];
+}
+
+static const point_t points[] = {
+  { "F",        MODE_LATENCY,    1,            fLatency,        false },
+  { "F",        MODE_THROUGHPUT, MICRO_STATES, fThroughput,     false },
+  { "FLanes",   MODE_THROUGHPUT, 0,            lanesThroughput, false },
+  { "FBatch",   MODE_THROUGHPUT, BATCH_LANES,  batchThroughput, false },
+  { "G",        MODE_LATENCY,    1,            gLatency,        true },
+  { "G",        MODE_THROUGHPUT, MICRO_STATES, gThroughput,     true },
+  { "col",      MODE_LATENCY,    1,            colLatency,      true },
+  { "col",      MODE_THROUGHPUT, MICRO_STATES, colThroughput,   true },
+  { "diag",     MODE_LATENCY,    1,            diagLatency,     true },
+  { "diag",     MODE_THROUGHPUT, MICRO_STATES, diagThroughput,  true },
+  { "H",        MODE_LATENCY,    1,            hLatency,        true },
+  { "H",        MODE_THROUGHPUT, MICRO_STATES, hThroughput,     true },
+  { "rightRot", MODE_LATENCY,    1,            rotLatency,      true },
+  { "rightRot", MODE_THROUGHPUT, MICRO_STATES, rotThroughput,   true }
+};
+
+//*****************************************************************************
+//
+// Function -> checkKernel
+// Purpose -> The kernel being timed must give FScalar()'s answer, for the
+//            single state, lane and batch entry points
+// Returns -> true if it does
+//
+//*****************************************************************************
+static bool
+checkKernel(uint32_t lanes) {
+  word_t want[BATCH_WORDS];
+  word_t got[BATCH_WORDS];
+  word_t one[16];
+  uint32_t i;
+  uint32_t j;
+
+  for (i = 0; i < BATCH_WORDS; i++) {
+    want[i] = (word_t)(0x9e3779b97f4a7c15u * (i + 1));
+  }
+  memcpy(got, want, sizeof(got));
+  for (i = 0; i < BATCH_LANES; i++) {
+    FScalar(want + 16 * i);
+  }
+
+  pfnPermute(got);
+  pfnPermuteLanes(got + 16);
+  if (memcmp(got, want, 16 * sizeof(word_t)) != 0 ||
+      memcmp(got + 16, want + 16, 16 * lanes * sizeof(word_t)) != 0) {
+    return false;
+  }
+
+  //
+  // The batch kernel keeps word i of every state in row i
+  //
+  for (i = 0; i < BATCH_WORDS; i++) {
+    got[i] = (word_t)(0x9e3779b97f4a7c15u * (i % 16 * BATCH_LANES + i / 16 + 1));
+  }
+  for (j = 0; j < BATCH_LANES; j++) {
+    for (i = 0; i < 16; i++) {
+      one[i] = got[i * BATCH_LANES + j];
+    }
+    FScalar(one);
+    memcpy(want + 16 * j, one, sizeof(one));
+  }
+  pfnPermuteBatch(got);
+  for (j = 0; j < BATCH_LANES; j++) {
+    for (i = 0; i < 16; i++) {
+      if (got[i * BATCH_LANES + j] != want[16 * j + i]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> runPoint
+// Purpose -> Size the loop to the budget, keep the fastest of MICRO_TRIALS
+//            and print it as one JSON entry
+//
+//*****************************************************************************
+static void
+runPoint(const point_t* pPt, const char* kernel, uint32_t states,
+         uint64_t budgetNs, bool first) {
+  sample_t best;
+  sample_t s;
+  size_t iters = 1000;
+  double calls;
+  uint32_t trial;
+  uint32_t i;
+
+  measure(pPt, iters, &s);
+  if (s.ns > 0) {
+    iters = (size_t)((double)iters * (double)budgetNs / MICRO_TRIALS /
+                     (double)s.ns);
+  }
+  iters = (iters == 0) ? 1 : iters;
+
+  memset(&best, 0, sizeof(best));
+  best.ns = UINT64_MAX;
+  for (trial = 0; trial < MICRO_TRIALS; trial++) {
+    measure(pPt, iters, &s);
+    if (s.ns < best.ns) {
+      best = s;
+    }
+  }
+
+  //
+  // Per state the call works on, so lane and batch kernels compare with F
+  //
+  calls = (double)iters * states;
+  printf("%s    {\"piece\": \"%s\", \"kernel\": \"%s\", \"mode\": \"%s\", "
+         "\"states\": %u, \"ns\": %.3f, ",
+         first ? "" : ",\n", pPt->piece, kernel,
+         (pPt->mode == MODE_LATENCY) ? "latency" : "throughput", states,
+         (double)best.ns / calls);
+#ifdef MICRO_TSC
+  printf("\"tsc\": %.2f", (double)best.tsc / calls);
+#else
+  printf("\"tsc\": null");
+#endif
+  for (i = 0; i < CTR_COUNT; i++) {
+    if (ctrFd[i] >= 0) {
+      printf(", \"%s\": %.2f", ctrNames[i], (double)best.ctr[i] / calls);
+    }
+    else {
+      printf(", \"%s\": null", ctrNames[i]);
+    }
+  }
+  if (ctrFd[CTR_INSTRUCTIONS] >= 0 && best.ctr[CTR_CYCLES] > 0) {
+    printf(", \"ipc\": %.2f}",
+           (double)best.ctr[CTR_INSTRUCTIONS] / (double)best.ctr[CTR_CYCLES]);
+  }
+  else {
+    printf(", \"ipc\": null}");
+  }
+  fflush(stdout);
+}
+
+//*****************************************************************************
+//
+// Function -> main
+// Purpose -> Every point on every kernel this CPU has, the scalar pieces
+//            once
+// Inputs -> argv[1] - Optional ms to spend on each point
+//
+//*****************************************************************************
+int
+main(int argc, char** argv) {
+  uint64_t budgetNs = (uint64_t)MICRO_DEFAULT_MS * 1000000u;
+  uint32_t startKernel = NORXKernel();
+  uint32_t kernel;
+  uint32_t perCall;
+  uint32_t i;
+  bool first = true;
+  bool perf;
+
+  if (argc > 1) {
+    budgetNs = (uint64_t)strtoul(argv[1], NULL, 10) * 1000000u;
+  }
+  for (i = 0; i < MICRO_STATES * BATCH_WORDS; i++) {
+    states[i] = (word_t)(0x9e3779b97f4a7c15u * (i + 1));
+  }
+  for (i = 0; i < MICRO_STATES; i++) {
+    words[i] = (word_t)(0xd1b54a32d192ed03u * (i + 1));
+  }
+
+  perf = ctrOpen();
+  printf("{\n  \"core\": \"NORX%u-%u-%u\",\n  \"perf\": %s,\n"
+         "  \"ms_per_point\": %llu,\n  \"results\": [\n",
+         (unsigned)WORD_LEN, (unsigned)RND_NUM, (unsigned)PARALLEL,
+         perf ? "true" : "false",
+         (unsigned long long)(budgetNs / 1000000u));
+
+  for (kernel = 0; kernel < KERNEL_COUNT; kernel++) {
+    if (!NORXSetKernel(kernel)) {
+      continue;
+    }
+    if (!checkKernel(NORXLaneWidth())) {
+      fprintf(stderr, "kernel %s does not match FScalar(), not timing it\n",
+              NORXKernelName(kernel));
+      continue;
+    }
+
+    for (i = 0; i < sizeof(points) / sizeof(points[0]); i++) {
+      if (points[i].scalarOnly && kernel != KERNEL_SCALAR) {
+        continue;
+      }
+      perCall = (points[i].states == 0) ? NORXLaneWidth() : points[i].states;
+      runPoint(&points[i], points[i].scalarOnly ? "scalar" :
+               NORXKernelName(kernel), perCall, budgetNs, first);
+      first = false;
+    }
+  }
+  NORXSetKernel(startKernel);
+
+  printf("\n  ]\n}\n");
+
+  for (i = 0; i < CTR_COUNT; i++) {
+    if (ctrFd[i] >= 0) {
+      close(ctrFd[i]);
+    }
+  }
+
+  return 0;
+}
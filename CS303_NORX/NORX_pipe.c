@@ -0,0 +1,382 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_pipe.c                                                         *
+* Purpose -> Lock free sealing pipeline on SPSC rings                         *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Lock Free SPSC Sealing Pipeline                 *
+*                                                                             *
+* Every ring is an array of preallocated slots and three counters, each      *
+* written by one thread only:                                                 *
+*   head   - records the producer has pushed                                  *
+*   sealed - records the worker has sealed, it runs behind head               *
+*   tail   - records the consumer has popped, it runs behind sealed           *
+* Slot i is record i & mask. A thread reads the counter in front of it with   *
+* acquire and publishes its own with release, so whatever was written into a  *
+* slot is seen by the next stage without a lock. The producer and consumer    *
+* keep a copy of the counter they wait on and only reload it when the copy    *
+* says the ring is full or empty, and each counter has its own cache line.    *
+*                                                                             *
+* The worker takes every record pushed since its last pass, up to             *
+* PIPE_BATCH, and seals them with one NORXBatchSeal() call so a busy ring     *
+* fills the SIMD lanes. A lone record goes through NORXKeyEnc() on the key    *
+* schedule. Records are sealed in place in their slot. An idle worker spins, *
+* then yields, then naps, so a quiet pipeline does not hold on to the CPUs.  *
+*                                                                             *
+* Build -> needs -pthread                                                     *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <pthread.h>   // Worker threads
+#include <sched.h>     // sched_yield
+#include <stdatomic.h> // Ring counters
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdlib.h>    // aligned_alloc, free
+#include <string.h>    // memcpy, memset
+#include <time.h>      // nanosleep
+#include <unistd.h>    // sysconf
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_simd.h"  // BATCH_LANES
+#include "NORX_batch.h" // Batch seal
+#include "NORX_pipe.h"  // Pipeline types and prototypes
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define CPU_RELAX()  _mm_pause()
+#else
+  #define CPU_RELAX()
+#endif
+
+//*****************************************************************************
+// Tuning
+//*****************************************************************************
+#define CACHE_LINE     64
+#define PIPE_BATCH     (4 * BATCH_LANES)  // Most records per worker pass
+#define PIPE_SPINS     256                // Idle passes spent spinning
+#define PIPE_YIELDS    64                 // then yielding, then napping
+#define PIPE_NAP_NS    50000
+
+//*****************************************************************************
+// One ring and its worker
+//*****************************************************************************
+typedef struct {
+  _Alignas(CACHE_LINE) _Atomic uint64_t head;
+  uint64_t tailSeen;          // Producer's copy of tail
+
+  _Alignas(CACHE_LINE) _Atomic uint64_t sealed;
+
+  _Alignas(CACHE_LINE) _Atomic uint64_t tail;
+  uint64_t sealedSeen;        // Consumer's copy of sealed
+
+  _Alignas(CACHE_LINE) norx_rec_t* pRecs;
+  uint8_t* pMem;              // Slot buffers, recordBytes each
+  norx_pipe_t* pPipe;
+  pthread_t thread;
+} ring_t;
+
+//*****************************************************************************
+// Pipeline
+//*****************************************************************************
+struct norx_pipe_s {
+  ring_t* pRings;
+  uint32_t count;             // Rings with a running worker
+  uint64_t mask;              // Slots - 1
+  size_t recordBytes;
+  uint8_t K[KEY_BYTES];       // Key for the batch API
+  norx_key_t key;             // Key schedule for lone records
+  atomic_bool quit;
+};
+
+//*****************************************************************************
+//
+// Function -> backoff
+// Purpose -> Wait a little longer each idle pass of a worker
+//
+//*****************************************************************************
+static void
+backoff(uint32_t* pIdle) {
+  struct timespec ts = { 0, PIPE_NAP_NS };
+
+  if (*pIdle < PIPE_SPINS) {
+    CPU_RELAX();
+    (*pIdle)++;
+  }
+  else if (*pIdle < PIPE_SPINS + PIPE_YIELDS) {
+    sched_yield();
+    (*pIdle)++;
+  }
+  else {
+    nanosleep(&ts, NULL);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> workerMain
+// Purpose -> Seal whatever the producer has pushed, until the pipeline is
+//            destroyed
+//
+//*****************************************************************************
+static void*
+workerMain(void* pArg) {
+  ring_t* pR = (ring_t*)pArg;
+  norx_pipe_t* pPipe = pR->pPipe;
+  norx_msg_t msgs[PIPE_BATCH];
+  norx_rec_t* pRec;
+  uint64_t sealed = atomic_load_explicit(&pR->sealed, memory_order_relaxed);
+  uint64_t head;
+  uint64_t n;
+  uint32_t idle = 0;
+  uint32_t i;
+
+  for (;;) {
+    head = atomic_load_explicit(&pR->head, memory_order_acquire);
+    if (head == sealed) {
+      if (atomic_load_explicit(&pPipe->quit, memory_order_relaxed)) {
+        break;
+      }
+      backoff(&idle);
+      continue;
+    }
+    idle = 0;
+
+    n = head - sealed;
+    n = (n < PIPE_BATCH) ? n : PIPE_BATCH;
+    if (n == 1) {
+      pRec = &pR->pRecs[sealed & pPipe->mask];
+      NORXKeyEnc(&pPipe->key, pRec->n, pRec->pA, pRec->aLen, pRec->pC,
+                 pRec->len, NULL, 0, pRec->pC, pRec->t);
+    }
+    else {
+      for (i = 0; i < n; i++) {
+        pRec = &pR->pRecs[(sealed + i) & pPipe->mask];
+        msgs[i].pK = pPipe->K;
+        msgs[i].pN = pRec->n;
+        msgs[i].pA = pRec->pA;
+        msgs[i].aLen = pRec->aLen;
+        msgs[i].pIn = pRec->pC;
+        msgs[i].inLen = pRec->len;
+        msgs[i].pZ = NULL;
+        msgs[i].zLen = 0;
+        msgs[i].pOut = pRec->pC;
+        msgs[i].pT = pRec->t;
+      }
+      NORXBatchSeal(msgs, (size_t)n);
+    }
+
+    sealed += n;
+    atomic_store_explicit(&pR->sealed, sealed, memory_order_release);
+  }
+
+  return NULL;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPipeCreate
+// Purpose -> Allocate the rings and start a worker on each
+// Inputs -> const uint8_t* pK - Key, KEY_BYTES
+//           uint32_t workers - Rings, 0 for one per online CPU
+//           uint32_t slots - Records per ring, 0 for PIPE_SLOTS
+//           size_t recordBytes - Most header and payload bytes per record
+// Returns -> The pipeline, NULL if it could not be allocated
+//
+//*****************************************************************************
+norx_pipe_t*
+NORXPipeCreate(const uint8_t* pK, uint32_t workers, uint32_t slots,
+               size_t recordBytes) {
+  norx_pipe_t* pPipe;
+  ring_t* pR;
+  uint64_t n;
+  long cpus;
+  uint32_t i;
+
+  if (workers == 0) {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    workers = (cpus > 0) ? (uint32_t)cpus : 1;
+  }
+  if (workers > PIPE_MAX_WORKERS) {
+    workers = PIPE_MAX_WORKERS;
+  }
+  if (slots == 0) {
+    slots = PIPE_SLOTS;
+  }
+  for (n = 1; n < slots; n <<= 1) {
+    continue;
+  }
+
+  pPipe = (norx_pipe_t*)malloc(sizeof(*pPipe));
+  if (pPipe == NULL) {
+    return NULL;
+  }
+  memset(pPipe, 0, sizeof(*pPipe));
+  pPipe->pRings = (ring_t*)aligned_alloc(CACHE_LINE, workers * sizeof(ring_t));
+  if (pPipe->pRings == NULL) {
+    free(pPipe);
+    return NULL;
+  }
+  memset(pPipe->pRings, 0, workers * sizeof(ring_t));
+  pPipe->mask = n - 1;
+  pPipe->recordBytes = recordBytes;
+  memcpy(pPipe->K, pK, KEY_BYTES);
+  NORXKeyInit(&pPipe->key, pK);
+  atomic_init(&pPipe->quit, false);
+
+  //
+  // A ring that can not get its slots or its thread just leaves the
+  // pipeline smaller
+  //
+  for (i = 0; i < workers; i++) {
+    pR = &pPipe->pRings[i];
+    atomic_init(&pR->head, 0);
+    atomic_init(&pR->sealed, 0);
+    atomic_init(&pR->tail, 0);
+    pR->pPipe = pPipe;
+    pR->pRecs = (norx_rec_t*)calloc((size_t)n, sizeof(norx_rec_t));
+    pR->pMem = (uint8_t*)malloc((size_t)n * recordBytes + 1);
+    if (pR->pRecs == NULL || pR->pMem == NULL ||
+        pthread_create(&pR->thread, NULL, workerMain, pR) != 0) {
+      free(pR->pRecs);
+      free(pR->pMem);
+      break;
+    }
+    pPipe->count++;
+  }
+
+  if (pPipe->count == 0) {
+    NORXPipeDestroy(pPipe);
+    return NULL;
+  }
+  return pPipe;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPipeDestroy
+// Purpose -> Stop and join the workers and free the pipeline, records still
+//            in the rings are dropped
+//
+//*****************************************************************************
+void
+NORXPipeDestroy(norx_pipe_t* pPipe) {
+  ring_t* pR;
+  uint32_t i;
+
+  if (pPipe == NULL) {
+    return;
+  }
+
+  atomic_store(&pPipe->quit, true);
+  for (i = 0; i < pPipe->count; i++) {
+    pR = &pPipe->pRings[i];
+    pthread_join(pR->thread, NULL);
+    wipe(pR->pMem, (size_t)(pPipe->mask + 1) * pPipe->recordBytes);
+    wipe(pR->pRecs, (size_t)(pPipe->mask + 1) * sizeof(norx_rec_t));
+    free(pR->pMem);
+    free(pR->pRecs);
+  }
+
+  free(pPipe->pRings);
+  NORXKeyWipe(&pPipe->key);
+  wipe(pPipe, sizeof(*pPipe));
+  free(pPipe);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPipeWorkers
+// Purpose -> Rings the pipeline runs, producers use 0 to count - 1
+//
+//*****************************************************************************
+uint32_t
+NORXPipeWorkers(const norx_pipe_t* pPipe) {
+  return pPipe->count;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPipePush
+// Purpose -> Copy a record into the next free slot of a ring
+// Inputs -> norx_pipe_t* pPipe - Pipeline
+//           uint32_t r - Ring, this thread must be its only producer
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//           const uint8_t* pA, aLen - Header
+//           const uint8_t* pM, len - Payload
+//           uint64_t user - Handed back with the sealed record
+// Returns -> false if the ring is full or the record is too big for a slot
+//
+//*****************************************************************************
+bool
+NORXPipePush(norx_pipe_t* pPipe, uint32_t r, const uint8_t* pN,
+             const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t len,
+             uint64_t user) {
+  ring_t* pR = &pPipe->pRings[r];
+  uint64_t head = atomic_load_explicit(&pR->head, memory_order_relaxed);
+  uint64_t slot = head & pPipe->mask;
+  norx_rec_t* pRec = &pR->pRecs[slot];
+  uint8_t* p = pR->pMem + slot * pPipe->recordBytes;
+
+  if (aLen > pPipe->recordBytes || len > pPipe->recordBytes - aLen) {
+    return false;
+  }
+  if (head - pR->tailSeen > pPipe->mask) {
+    pR->tailSeen = atomic_load_explicit(&pR->tail, memory_order_acquire);
+    if (head - pR->tailSeen > pPipe->mask) {
+      return false;
+    }
+  }
+
+  memcpy(pRec->n, pN, NONCE_BYTES);
+  memcpy(p, pA, aLen);
+  memcpy(p + aLen, pM, len);
+  pRec->pA = p;
+  pRec->aLen = aLen;
+  pRec->pC = p + aLen;
+  pRec->len = len;
+  pRec->user = user;
+
+  atomic_store_explicit(&pR->head, head + 1, memory_order_release);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPipePeek
+// Purpose -> Oldest sealed record of a ring
+// Inputs -> norx_pipe_t* pPipe - Pipeline
+//           uint32_t r - Ring, this thread must be its only consumer
+// Returns -> The record, NULL if nothing is sealed yet
+//
+//*****************************************************************************
+const norx_rec_t*
+NORXPipePeek(norx_pipe_t* pPipe, uint32_t r) {
+  ring_t* pR = &pPipe->pRings[r];
+  uint64_t tail = atomic_load_explicit(&pR->tail, memory_order_relaxed);
+
+  if (tail == pR->sealedSeen) {
+    pR->sealedSeen = atomic_load_explicit(&pR->sealed, memory_order_acquire);
+    if (tail == pR->sealedSeen) {
+      return NULL;
+    }
+  }
+  return &pR->pRecs[tail & pPipe->mask];
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPipePop
+// Purpose -> Hand the slot NORXPipePeek() returned back to the producer
+//
+//*****************************************************************************
+void
+NORXPipePop(norx_pipe_t* pPipe, uint32_t r) {
+  ring_t* pR = &pPipe->pRings[r];
+  uint64_t tail = atomic_load_explicit(&pR->tail, memory_order_relaxed);
+
+  atomic_store_explicit(&pR->tail, tail + 1, memory_order_release);
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_pipe.h                                                         *
+* Purpose -> Lock free sealing pipeline: producers push records into SPSC     *
+*            rings, a worker per ring seals them in place and consumers take  *
+*            them back in order                                               *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Lock Free SPSC Sealing Pipeline                 *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_PIPE_H
+#define NORX_PIPE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Limits. slots is rounded up to a power of two, 0 takes PIPE_SLOTS.
+//*****************************************************************************
+#define PIPE_MAX_WORKERS  64
+#define PIPE_SLOTS        256
+
+//*****************************************************************************
+// A sealed record as the consumer sees it. pA and pC point into the slot,
+// they are only good until the record is popped.
+//*****************************************************************************
+typedef struct {
+  uint8_t n[NONCE_BYTES];     // Nonce
+  const uint8_t* pA;          // Header
+  size_t aLen;
+  uint8_t* pC;                // Cipher text
+  size_t len;
+  uint8_t t[TAG_BYTES];       // Tag
+  uint64_t user;              // Whatever the producer passed in
+} norx_rec_t;
+
+//*****************************************************************************
+// Pipeline, only used through the calls below
+//*****************************************************************************
+typedef struct norx_pipe_s norx_pipe_t;
+
+//*****************************************************************************
+// Pipeline Prototypes. Ring r has one producer thread, its own worker and
+// one consumer thread, so none of these calls take a lock or wait: a full
+// ring makes NORXPipePush() return false and an empty one makes
+// NORXPipePeek() return NULL, the caller backs off or does other work.
+//
+// NORXPipeCreate() - workers rings and worker threads, 0 for one per CPU,
+//                    each ring with slots of recordBytes for header and
+//                    payload together
+// NORXPipePush() - Copy a record into ring r, false if the ring is full or
+//                  aLen + len is more than recordBytes
+// NORXPipePeek() - Oldest sealed record of ring r, NULL if there is none
+// NORXPipePop() - Give the record from NORXPipePeek() back to the producer
+//*****************************************************************************
+extern norx_pipe_t* NORXPipeCreate(const uint8_t* pK, uint32_t workers,
+                                   uint32_t slots, size_t recordBytes);
+extern void NORXPipeDestroy(norx_pipe_t* pPipe);
+extern uint32_t NORXPipeWorkers(const norx_pipe_t* pPipe);
+
+extern bool NORXPipePush(norx_pipe_t* pPipe, uint32_t r, const uint8_t* pN,
+                         const uint8_t* pA, size_t aLen,
+                         const uint8_t* pM, size_t len, uint64_t user);
+extern const norx_rec_t* NORXPipePeek(norx_pipe_t* pPipe, uint32_t r);
+extern void NORXPipePop(norx_pipe_t* pPipe, uint32_t r);
+
+#endif // NORX_PIPE_H
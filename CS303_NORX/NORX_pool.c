@@ -0,0 +1,411 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_pool.c                                                         *
+* Purpose -> NORX with chunked lanes on a pool of threads, for payloads too   *
+*            large to seal on one core                                        *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Chunked Lanes on a Thread Pool                  *
+*            2.0 10/17/2026 - Tag Checked by tagMatch()                       *
+*            3.0 10/17/2026 - Own Parameter Value, Lane Size Bound In         *
+*            4.0 10/17/2026 - NORX_STATS Counts for the Lane Branch and Merge *
+*                                                                             *
+* With chunked lanes there is no fixed lane count. The payload is cut into    *
+* lanes of laneBytes each, the last one shorter, and lane n is branched from  *
+* S like branch() does with n XORed into its rate words. Each lane then runs  *
+* its bytes as a payload of its own through encryptLane()/decryptLane(),      *
+* padded last block included, and goes through the merge F. This is not the   *
+* spec's P = 0, see POOL_PARAM in NORX_pool.h for how the initial state       *
+* tells the two apart and binds the lane size.                                *
+*                                                                             *
+* Lanes are handed out one at a time off a shared counter, so a thread that  *
+* is done early just takes the next one. Every thread XORs the lanes it       *
+* merged into a partial state of its own, and the partials are folded        *
+* together pairwise once all lanes are done. Header and trailer stay on the  *
+* caller's thread.                                                            *
+*                                                                             *
+* Build -> needs -pthread                                                     *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <pthread.h>   // Worker threads
+#include <stdatomic.h> // Lane counter
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdlib.h>    // malloc, free
+#include <string.h>    // memcpy, memset
+#include <unistd.h>    // sysconf
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_stats.h" // Domain counters
+#include "NORX_pool.h"  // Pool type and prototypes
+
+//*****************************************************************************
+// What a worker thread needs to find its pool and its partial state
+//*****************************************************************************
+typedef struct {
+  norx_pool_t* pPool;
+  uint32_t slot;              // Index into part[], 0 is the caller
+} worker_t;
+
+//*****************************************************************************
+// Pool, the job fields are set by the caller before waking the workers
+//*****************************************************************************
+struct norx_pool_s {
+  pthread_t threads[POOL_MAX_THREADS];
+  worker_t workers[POOL_MAX_THREADS];
+  uint32_t count;             // Threads on a job, the caller included
+  size_t laneBytes;           // Bytes per lane, whole rate blocks
+
+  pthread_mutex_t lock;
+  pthread_cond_t start;       // A new job or quit
+  pthread_cond_t done;        // Last worker left the job
+  uint64_t job;               // Bumped for every job
+  uint32_t busy;              // Workers still on the job
+  bool quit;
+
+  const word_t* pwS;          // State after the header
+  const uint8_t* pIn;         // Payload in
+  uint8_t* pOut;              // Payload out, may be pIn
+  size_t len;                 // Payload bytes
+  size_t lanes;               // Lanes in the payload
+  bool dec;                   // Decrypt rather than encrypt
+  atomic_size_t next;         // Next lane to hand out
+
+  word_t part[POOL_MAX_THREADS][16];  // Merged lanes per thread
+};
+
+//*****************************************************************************
+//
+// Function -> runLanes
+// Purpose -> Take lanes off the counter until none are left, branch, crypt
+//            and merge each one into this thread's partial state
+// Inputs -> norx_pool_t* pPool - Pool with a job set up
+//           uint32_t slot - Partial state to merge into
+//
+//*****************************************************************************
+static void
+runLanes(norx_pool_t* pPool, uint32_t slot) {
+  word_t lane[16];
+  word_t acc[16] = { 0 };
+  size_t n;
+  size_t off;
+  size_t len;
+  uint32_t i;
+
+  while ((n = atomic_fetch_add(&pPool->next, 1)) < pPool->lanes) {
+    off = n * pPool->laneBytes;
+    len = pPool->len - off;
+    len = (len < pPool->laneBytes) ? len : pPool->laneBytes;
+
+    memcpy(lane, pPool->pwS, sizeof(lane));
+    STATS_DOMAIN(BRANCH_DOMAIN, 1, 0, 0);
+    lane[15] ^= BRANCH_DOMAIN;
+    F(lane);
+    for (i = 0; i < RATE_WORDS; i++) {
+      lane[i] ^= (word_t)n;
+    }
+
+    if (pPool->dec) {
+      decryptLane(lane, pPool->pIn + off, len, PAYLOAD_DOMAIN,
+                  pPool->pOut + off);
+    }
+    else {
+      encryptLane(lane, pPool->pIn + off, len, PAYLOAD_DOMAIN,
+                  pPool->pOut + off);
+    }
+
+    STATS_DOMAIN(MERGE_DOMAIN, 1, 0, 0);
+    lane[15] ^= MERGE_DOMAIN;
+    F(lane);
+    for (i = 0; i < 16; i++) {
+      acc[i] ^= lane[i];
+    }
+  }
+
+  memcpy(pPool->part[slot], acc, sizeof(acc));
+  wipe(lane, sizeof(lane));
+  wipe(acc, sizeof(acc));
+}
+
+//*****************************************************************************
+//
+// Function -> workerMain
+// Purpose -> Worker thread, sleeps until a job comes in and runs lanes
+//
+//*****************************************************************************
+static void*
+workerMain(void* pArg) {
+  worker_t* pWorker = (worker_t*)pArg;
+  norx_pool_t* pPool = pWorker->pPool;
+  uint64_t seen = 0;
+
+  pthread_mutex_lock(&pPool->lock);
+  for (;;) {
+    while (!pPool->quit && pPool->job == seen) {
+      pthread_cond_wait(&pPool->start, &pPool->lock);
+    }
+    if (pPool->quit) {
+      break;
+    }
+    seen = pPool->job;
+    pthread_mutex_unlock(&pPool->lock);
+
+    runLanes(pPool, pWorker->slot);
+
+    pthread_mutex_lock(&pPool->lock);
+    if (--pPool->busy == 0) {
+      pthread_cond_signal(&pPool->done);
+    }
+  }
+  pthread_mutex_unlock(&pPool->lock);
+
+  return NULL;
+}
+
+//*****************************************************************************
+//
+// Function -> cryptPayload
+// Purpose -> Branch, crypt and merge the whole payload on the pool. S goes
+//            in as the state after the header and comes out merged.
+// Inputs -> norx_pool_t* pPool - Pool
+//           word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//           const uint8_t* pIn, len - Payload in
+//           uint8_t* pOut - Payload out, len bytes, may be pIn
+//           bool dec - Decrypt rather than encrypt
+//
+//*****************************************************************************
+static void
+cryptPayload(norx_pool_t* pPool, word_t* pwS, const uint8_t* pIn, size_t len,
+             uint8_t* pOut, bool dec) {
+  uint32_t threads;
+  uint32_t step;
+  uint32_t i;
+  uint32_t j;
+
+  if (len == 0) {
+    return;
+  }
+
+  pPool->pwS = pwS;
+  pPool->pIn = pIn;
+  pPool->pOut = pOut;
+  pPool->len = len;
+  pPool->lanes = (len + pPool->laneBytes - 1) / pPool->laneBytes;
+  pPool->dec = dec;
+  atomic_store(&pPool->next, 0);
+
+  //
+  // A single lane is not worth waking the workers for
+  //
+  threads = (pPool->lanes > 1) ? pPool->count : 1;
+
+  if (threads > 1) {
+    pthread_mutex_lock(&pPool->lock);
+    pPool->busy = threads - 1;
+    pPool->job++;
+    pthread_cond_broadcast(&pPool->start);
+    pthread_mutex_unlock(&pPool->lock);
+  }
+
+  runLanes(pPool, 0);
+
+  if (threads > 1) {
+    pthread_mutex_lock(&pPool->lock);
+    while (pPool->busy > 0) {
+      pthread_cond_wait(&pPool->done, &pPool->lock);
+    }
+    pthread_mutex_unlock(&pPool->lock);
+  }
+
+  //
+  // Fold the partial states pairwise into part[0]
+  //
+  for (step = 1; step < threads; step *= 2) {
+    for (i = 0; i + step < threads; i += 2 * step) {
+      for (j = 0; j < 16; j++) {
+        pPool->part[i][j] ^= pPool->part[i + step][j];
+      }
+    }
+  }
+  memcpy(pwS, pPool->part[0], 16 * sizeof(word_t));
+  wipe(pPool->part, threads * sizeof(pPool->part[0]));
+}
+
+//*****************************************************************************
+//
+// Function -> initialisePool
+// Purpose -> initialiseKey() with POOL_PARAM in the parameter word and the
+//            lane size in rate blocks in word 11. The key schedule has
+//            PARALLEL folded in, and holds words 4 - 15
+//
+//*****************************************************************************
+static void
+initialisePool(const norx_pool_t* pPool, const norx_key_t* pKey,
+               const uint8_t* pN, word_t* pwS) {
+  norx_key_t key = *pKey;
+
+  key.S[10] ^= PARALLEL ^ POOL_PARAM;
+  key.S[7] ^= (word_t)(pPool->laneBytes / RATE_BYTES);
+  initialiseKey(&key, pN, pwS);
+  wipe(&key, sizeof(key));
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPoolCreate
+// Purpose -> Start the worker threads
+// Inputs -> uint32_t threads - Threads including the caller's, 0 for one per
+//                              online CPU
+//           size_t laneBytes - Bytes per lane, 0 for POOL_LANE_BYTES
+// Returns -> The pool, NULL if it could not be allocated
+//
+//*****************************************************************************
+norx_pool_t*
+NORXPoolCreate(uint32_t threads, size_t laneBytes) {
+  norx_pool_t* pPool;
+  long cpus;
+  uint32_t i;
+
+  if (threads == 0) {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (cpus > 0) ? (uint32_t)cpus : 1;
+  }
+  if (threads > POOL_MAX_THREADS) {
+    threads = POOL_MAX_THREADS;
+  }
+  if (laneBytes == 0) {
+    laneBytes = POOL_LANE_BYTES;
+  }
+  laneBytes = (laneBytes + RATE_BYTES - 1) / RATE_BYTES * RATE_BYTES;
+
+  pPool = (norx_pool_t*)malloc(sizeof(*pPool));
+  if (pPool == NULL) {
+    return NULL;
+  }
+  memset(pPool, 0, sizeof(*pPool));
+  pPool->laneBytes = laneBytes;
+  pPool->count = 1;
+  atomic_init(&pPool->next, 0);
+  pthread_mutex_init(&pPool->lock, NULL);
+  pthread_cond_init(&pPool->start, NULL);
+  pthread_cond_init(&pPool->done, NULL);
+
+  //
+  // Slot 0 is the caller, a thread that fails to start just leaves the
+  // pool smaller
+  //
+  for (i = 1; i < threads; i++) {
+    pPool->workers[i].pPool = pPool;
+    pPool->workers[i].slot = i;
+    if (pthread_create(&pPool->threads[i], NULL, workerMain,
+                       &pPool->workers[i]) != 0) {
+      break;
+    }
+    pPool->count++;
+  }
+
+  return pPool;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPoolDestroy
+// Purpose -> Stop and join the worker threads and free the pool
+//
+//*****************************************************************************
+void
+NORXPoolDestroy(norx_pool_t* pPool) {
+  uint32_t i;
+
+  if (pPool == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&pPool->lock);
+  pPool->quit = true;
+  pthread_cond_broadcast(&pPool->start);
+  pthread_mutex_unlock(&pPool->lock);
+
+  for (i = 1; i < pPool->count; i++) {
+    pthread_join(pPool->threads[i], NULL);
+  }
+
+  pthread_cond_destroy(&pPool->done);
+  pthread_cond_destroy(&pPool->start);
+  pthread_mutex_destroy(&pPool->lock);
+  free(pPool);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPoolThreads / NORXPoolLaneBytes
+// Purpose -> Threads the pool runs, the caller's included, and its lane size
+//
+//*****************************************************************************
+uint32_t
+NORXPoolThreads(const norx_pool_t* pPool) {
+  return pPool->count;
+}
+
+size_t
+NORXPoolLaneBytes(const norx_pool_t* pPool) {
+  return pPool->laneBytes;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPoolEnc
+// Purpose -> NORXKeyEnc() with chunked lanes, run on the pool
+// Inputs -> norx_pool_t* pPool - Pool
+//           const norx_key_t* pKey - Key schedule
+//           The rest as NORXEnc()
+//
+//*****************************************************************************
+void
+NORXPoolEnc(norx_pool_t* pPool, const norx_key_t* pKey, const uint8_t* pN,
+            const uint8_t* pA, size_t aLen, const uint8_t* pM, size_t mLen,
+            const uint8_t* pZ, size_t zLen, uint8_t* pC, uint8_t* pT) {
+  word_t S[16];                 // State, 4x4 matrix of words
+  word_t outT[TAG_WORDS];       // Tag words
+  uint32_t i;
+
+  initialisePool(pPool, pKey, pN, S);
+  absorb(S, pA, aLen, HEADER_DOMAIN);
+  cryptPayload(pPool, S, pM, mLen, pC, false);
+  absorb(S, pZ, zLen, TRAILER_DOMAIN);
+  finalise(S, pKey->K, FINAL_DOMAIN, outT);
+
+  for (i = 0; i < TAG_WORDS; i++) {
+    storeWord(pT + i * WORD_BYTES, outT[i]);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> NORXPoolDec
+// Purpose -> NORXKeyDec() with chunked lanes, run on the pool
+// Inputs -> norx_pool_t* pPool - Pool
+//           const norx_key_t* pKey - Key schedule
+//           The rest as NORXDec()
+// Returns -> true if the tag matches
+//
+//*****************************************************************************
+bool
+NORXPoolDec(norx_pool_t* pPool, const norx_key_t* pKey, const uint8_t* pN,
+            const uint8_t* pA, size_t aLen, const uint8_t* pC, size_t cLen,
+            const uint8_t* pZ, size_t zLen, const uint8_t* pT, uint8_t* pM) {
+  word_t S[16];                 // State, 4x4 matrix of words
+  word_t outT[TAG_WORDS];       // Tag words
+
+  initialisePool(pPool, pKey, pN, S);
+  absorb(S, pA, aLen, HEADER_DOMAIN);
+  cryptPayload(pPool, S, pC, cLen, pM, true);
+  absorb(S, pZ, zLen, TRAILER_DOMAIN);
+  finalise(S, pKey->K, FINAL_DOMAIN, outT);
+
+  return tagMatch(outT, pT);
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_pool.h                                                         *
+* Purpose -> NORX with chunked lanes, the payload is cut into lanes of a      *
+*            fixed size and the lanes are sealed on a pool of threads         *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Chunked Lanes on a Thread Pool                  *
+*            2.0 10/17/2026 - Own Parameter Value, Lane Size Bound In         *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_POOL_H
+#define NORX_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Lane size when the pool is created with 0. The lane size is part of the
+// format, both ends must use the same one.
+//*****************************************************************************
+#define POOL_LANE_BYTES   ((size_t)RATE_BYTES << 14)
+
+//*****************************************************************************
+// Chunked lanes are not the spec's P = 0, which gives every payload block a
+// lane of its own. The parameter word p carries POOL_PARAM instead, outside
+// the spec's 8 bit p so no spec instance starts from the same state, and the
+// lane size in rate blocks is XORed into state word 11 before the first F.
+// A message sealed with one lane size does not open with another.
+//*****************************************************************************
+#define POOL_PARAM        0x100
+
+//*****************************************************************************
+// Most threads a pool runs, the caller's thread included
+//*****************************************************************************
+#define POOL_MAX_THREADS  64
+
+//*****************************************************************************
+// Pool of worker threads, only used through the calls below
+//*****************************************************************************
+typedef struct norx_pool_s norx_pool_t;
+
+//*****************************************************************************
+// Pool Prototypes. threads = 0 takes one per online CPU, laneBytes = 0 takes
+// POOL_LANE_BYTES, any other size is rounded up to a whole number of rate
+// blocks. A pool runs one message at a time, NORXPoolEnc()/NORXPoolDec()
+// block until it is done and the caller's thread works lanes as well.
+//*****************************************************************************
+extern norx_pool_t* NORXPoolCreate(uint32_t threads, size_t laneBytes);
+extern void NORXPoolDestroy(norx_pool_t* pPool);
+extern uint32_t NORXPoolThreads(const norx_pool_t* pPool);
+extern size_t NORXPoolLaneBytes(const norx_pool_t* pPool);
+
+extern void NORXPoolEnc(norx_pool_t* pPool, const norx_key_t* pKey,
+                        const uint8_t* pN,
+                        const uint8_t* pA, size_t aLen,
+                        const uint8_t* pM, size_t mLen,
+                        const uint8_t* pZ, size_t zLen,
+                        uint8_t* pC, uint8_t* pT);
+extern bool NORXPoolDec(norx_pool_t* pPool, const norx_key_t* pKey,
+                        const uint8_t* pN,
+                        const uint8_t* pA, size_t aLen,
+                        const uint8_t* pC, size_t cLen,
+                        const uint8_t* pZ, size_t zLen,
+                        const uint8_t* pT, uint8_t* pM);
+
+#endif // NORX_POOL_H
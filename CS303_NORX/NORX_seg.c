@@ -0,0 +1,298 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_seg.c                                                          *
+* Purpose -> Segmented NORX container, the layout is in NORX_seg.h            *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - STREAM Style Segmented Container                *
+*            2.0 10/17/2026 - Container Length Checked against its Header     *
+*                                                                             *
+* This is the STREAM construction on NORX. Every segment is a message of its  *
+* own whose nonce carries its index and a last segment flag, so segments      *
+* can not be moved, and cutting the container short or adding to it fails    *
+* on the last segment. The container header is the header A of every         *
+* segment, so it is checked by whichever segment is opened first.             *
+*                                                                             *
+* Segments are fixed size, so where one sits is arithmetic on the header and *
+* reading a byte costs one segment, not the whole container. The header is    *
+* not authenticated until a segment is opened, so it is only taken when the   *
+* container is exactly as long as it says, every size worked out with         *
+* overflow checks, and only then is an offset trusted. Sealing and opening    *
+* runs of segments go through the batch API a group at a time, one segment    *
+* per lane.                                                                   *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types, SIZE_MAX
+#include <string.h>    // memcpy, memcmp
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_simd.h"  // BATCH_LANES
+#include "NORX_batch.h" // Batch seal and open
+#include "NORX_seg.h"   // Container layout and prototypes
+
+//*****************************************************************************
+// Segments handed to the batch API per call
+//*****************************************************************************
+#define SEG_GROUP   (4 * BATCH_LANES)
+
+//*****************************************************************************
+//
+// Function -> segNonce
+// Purpose -> Nonce of segment n: prefix, n and the last segment flag
+//
+//*****************************************************************************
+static void
+segNonce(const norx_seg_t* pSeg, uint64_t n, uint8_t* pN) {
+  uint32_t i;
+
+  memcpy(pN, pSeg->hdr + SEG_HEADER_BYTES - SEG_PREFIX_BYTES, SEG_PREFIX_BYTES);
+  for (i = 0; i < 8; i++) {
+    pN[SEG_PREFIX_BYTES + i] = (uint8_t)(n >> (8 * i));
+  }
+  pN[NONCE_BYTES - 1] = (n + 1 == pSeg->segs) ? 1 : 0;
+}
+
+//*****************************************************************************
+//
+// Function -> runSegs
+// Purpose -> Seal or open count segments from first on, a group at a time.
+//            Tags being opened are copied out, the batch API takes one
+//            writable tag pointer for both directions
+// Inputs -> const norx_seg_t* pSeg - Container header
+//           const uint8_t* pK - Key, KEY_BYTES
+//           const uint8_t* pIn - Plain bytes when sealing, sealed segments
+//                                when opening, segment first at pIn[0]
+//           uint64_t first, count - Segments to run
+//           uint8_t* pOut - Sealed segments when sealing, plain bytes when
+//                           opening, segment first at pOut[0]
+//           bool open - Open rather than seal
+//           bool* pOk - Tag result per segment when opening, may be NULL
+// Returns -> Number of tags that matched when opening
+//
+//*****************************************************************************
+static uint64_t
+runSegs(const norx_seg_t* pSeg, const uint8_t* pK, const uint8_t* pIn,
+        uint64_t first, uint64_t count, uint8_t* pOut, bool open, bool* pOk) {
+  norx_msg_t msgs[SEG_GROUP];
+  uint8_t nonces[SEG_GROUP][NONCE_BYTES];
+  uint8_t tags[SEG_GROUP][TAG_BYTES];
+  size_t sealed = (size_t)pSeg->segBytes + TAG_BYTES;
+  uint64_t good = 0;
+  uint64_t n;
+  size_t len;
+  uint32_t group;
+  uint32_t i;
+
+  for (n = 0; n < count; n += group) {
+    group = (count - n < SEG_GROUP) ? (uint32_t)(count - n) : SEG_GROUP;
+
+    for (i = 0; i < group; i++) {
+      len = NORXSegLen(pSeg, first + n + i);
+      segNonce(pSeg, first + n + i, nonces[i]);
+      msgs[i].pK = pK;
+      msgs[i].pN = nonces[i];
+      msgs[i].pA = pSeg->hdr;
+      msgs[i].aLen = SEG_HEADER_BYTES;
+      msgs[i].pZ = NULL;
+      msgs[i].zLen = 0;
+      msgs[i].inLen = len;
+      if (open) {
+        msgs[i].pIn = pIn + (n + i) * sealed;
+        msgs[i].pOut = pOut + (n + i) * pSeg->segBytes;
+        memcpy(tags[i], msgs[i].pIn + len, TAG_BYTES);
+        msgs[i].pT = tags[i];
+      }
+      else {
+        msgs[i].pIn = pIn + (n + i) * pSeg->segBytes;
+        msgs[i].pOut = pOut + (n + i) * sealed;
+        msgs[i].pT = msgs[i].pOut + len;
+      }
+    }
+
+    if (open) {
+      good += NORXBatchOpen(msgs, group, (pOk == NULL) ? NULL : pOk + n);
+    }
+    else {
+      NORXBatchSeal(msgs, group);
+    }
+  }
+
+  return good;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSegSealedSize
+// Purpose -> Container bytes for size plain bytes in segments of segBytes
+// Returns -> 0 if segBytes is 0 or the container would not fit in a size_t
+//
+//*****************************************************************************
+size_t
+NORXSegSealedSize(uint64_t size, uint32_t segBytes) {
+  uint64_t segs;
+  uint64_t room;
+
+  if (segBytes == 0) {
+    return 0;
+  }
+  segs = size / segBytes + ((size % segBytes != 0) ? 1 : 0);
+  if (segs == 0) {
+    segs = 1;
+  }
+
+  if (size > SIZE_MAX - SEG_HEADER_BYTES) {
+    return 0;
+  }
+  room = SIZE_MAX - SEG_HEADER_BYTES - size;
+  if (segs > room / TAG_BYTES) {
+    return 0;
+  }
+  return (size_t)(SEG_HEADER_BYTES + size + segs * TAG_BYTES);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSegSeal
+// Purpose -> Write a whole container for pM
+// Inputs -> const uint8_t* pK - Key, KEY_BYTES
+//           const uint8_t* pPrefix - Nonce prefix, SEG_PREFIX_BYTES, must
+//                                    not repeat under one key
+//           uint32_t segBytes - Plain bytes per segment, not 0
+//           const uint8_t* pM, size - Plain text
+//           uint8_t* pOut - Container, NORXSegSealedSize() bytes
+// Returns -> Bytes written to pOut
+//
+//*****************************************************************************
+size_t
+NORXSegSeal(const uint8_t* pK, const uint8_t* pPrefix, uint32_t segBytes,
+            const uint8_t* pM, size_t size, uint8_t* pOut) {
+  norx_seg_t seg;
+  uint32_t i;
+
+  memcpy(pOut, SEG_MAGIC, 8);
+  pOut[8] = WORD_LEN;
+  pOut[9] = RND_NUM;
+  pOut[10] = PARALLEL;
+  pOut[11] = 0;
+  for (i = 0; i < 4; i++) {
+    pOut[12 + i] = (uint8_t)(segBytes >> (8 * i));
+  }
+  for (i = 0; i < 8; i++) {
+    pOut[16 + i] = (uint8_t)((uint64_t)size >> (8 * i));
+  }
+  memcpy(pOut + 24, pPrefix, SEG_PREFIX_BYTES);
+
+  NORXSegParse(&seg, pOut, NORXSegSealedSize(size, segBytes));
+  runSegs(&seg, pK, pM, 0, seg.segs, pOut + SEG_HEADER_BYTES, false, NULL);
+
+  return NORXSegSealedSize(size, segBytes);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSegParse
+// Purpose -> Read a container header
+// Inputs -> norx_seg_t* pSeg - Header to fill
+//           const uint8_t* pIn - Start of the container
+//           size_t inLen - Bytes in the container
+// Returns -> false if it is not a container for this build or it is not as
+//            long as its header says
+//
+//*****************************************************************************
+bool
+NORXSegParse(norx_seg_t* pSeg, const uint8_t* pIn, size_t inLen) {
+  int i;
+
+  if (inLen < SEG_HEADER_BYTES || memcmp(pIn, SEG_MAGIC, 8) != 0 ||
+      pIn[8] != WORD_LEN || pIn[9] != RND_NUM || pIn[10] != PARALLEL ||
+      pIn[11] != 0) {
+    return false;
+  }
+
+  memcpy(pSeg->hdr, pIn, SEG_HEADER_BYTES);
+  pSeg->segBytes = 0;
+  for (i = 3; i >= 0; i--) {
+    pSeg->segBytes = (pSeg->segBytes << 8) | pIn[12 + i];
+  }
+  pSeg->size = 0;
+  for (i = 7; i >= 0; i--) {
+    pSeg->size = (pSeg->size << 8) | pIn[16 + i];
+  }
+  if (pSeg->segBytes == 0 ||
+      NORXSegSealedSize(pSeg->size, pSeg->segBytes) != inLen) {
+    return false;
+  }
+
+  pSeg->segs = pSeg->size / pSeg->segBytes +
+               ((pSeg->size % pSeg->segBytes != 0) ? 1 : 0);
+  if (pSeg->segs == 0) {
+    pSeg->segs = 1;
+  }
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSegOffset / NORXSegLen
+// Purpose -> Byte offset of sealed segment n in the container, and the plain
+//            bytes it holds. Past the last segment the offset is the end of
+//            the container, which NORXSegParse() has checked fits a size_t
+//
+//*****************************************************************************
+size_t
+NORXSegOffset(const norx_seg_t* pSeg, uint64_t n) {
+  uint64_t sealed = (uint64_t)pSeg->segBytes + TAG_BYTES;
+
+  if (n > pSeg->segs) {
+    n = pSeg->segs;
+  }
+  return (size_t)(SEG_HEADER_BYTES + n * sealed);
+}
+
+size_t
+NORXSegLen(const norx_seg_t* pSeg, uint64_t n) {
+  uint64_t left;
+
+  if (n >= pSeg->segs) {
+    return 0;
+  }
+  left = pSeg->size - n * pSeg->segBytes;
+  return (size_t)((left < pSeg->segBytes) ? left : pSeg->segBytes);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSegOpen
+// Purpose -> Open and check a run of segments
+// Inputs -> const norx_seg_t* pSeg - Header from NORXSegParse()
+//           const uint8_t* pK - Key, KEY_BYTES
+//           const uint8_t* pIn - Start of the container
+//           size_t inLen - Bytes in the container, nothing opens unless it
+//                          is what pSeg says
+//           uint64_t first, count - Segments to open, past the end is cut
+//           uint8_t* pM - Plain text out
+//           bool* pOk - Tag result per segment, may be NULL
+// Returns -> Number of tags that matched
+//
+//*****************************************************************************
+uint64_t
+NORXSegOpen(const norx_seg_t* pSeg, const uint8_t* pK, const uint8_t* pIn,
+            size_t inLen, uint64_t first, uint64_t count, uint8_t* pM,
+            bool* pOk) {
+  if (pSeg->segBytes == 0 ||
+      NORXSegSealedSize(pSeg->size, pSeg->segBytes) != inLen ||
+      first >= pSeg->segs) {
+    return 0;
+  }
+  if (count > pSeg->segs - first) {
+    count = pSeg->segs - first;
+  }
+
+  return runSegs(pSeg, pK, pIn + NORXSegOffset(pSeg, first), first, count, pM,
+                 true, pOk);
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_seg.h                                                          *
+* Purpose -> Segmented NORX container, fixed size segments each sealed on     *
+*            their own so any of them can be opened without the rest         *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - STREAM Style Segmented Container                *
+*            2.0 10/17/2026 - Container Length Checked against its Header     *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_SEG_H
+#define NORX_SEG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Container layout, numbers little endian:
+//   magic "NORXSEG1", W, L, P, 0, segment size (4 bytes), plain size
+//   (8 bytes), nonce prefix (SEG_PREFIX_BYTES)
+// then segment n, cipher text and tag, at SEG_HEADER_BYTES +
+// n * (segment size + TAG_BYTES). Segment n is sealed with the nonce
+// prefix || n (8 bytes) || 1 if it is the last segment else 0, and the
+// container header as its header A.
+//*****************************************************************************
+#define SEG_MAGIC          "NORXSEG1"
+#define SEG_PREFIX_BYTES   (NONCE_BYTES - 9)
+#define SEG_HEADER_BYTES   (8 + 4 + 4 + 8 + SEG_PREFIX_BYTES)
+
+//*****************************************************************************
+// Container header as read back, everything needed to find a segment
+//*****************************************************************************
+typedef struct {
+  uint8_t hdr[SEG_HEADER_BYTES];  // Header bytes, header A of every segment
+  uint32_t segBytes;              // Plain bytes per segment, last may be less
+  uint64_t size;                  // Plain bytes in the container
+  uint64_t segs;                  // Segments, at least 1
+} norx_seg_t;
+
+//*****************************************************************************
+// Segment Prototypes
+//
+// NORXSegSealedSize() - Container bytes for size plain bytes, 0 if segBytes
+//                       is 0 or it would not fit in a size_t
+// NORXSegSeal() - Seal pM into a whole container at pOut, the segments run
+//                 through the batch API. Returns the container bytes.
+// NORXSegParse() - Read the header of the inLen byte container at pIn, false
+//                  if it is not a container for this build or inLen is not
+//                  NORXSegSealedSize() of what the header says. The header
+//                  is not authenticated yet, this keeps every segment it
+//                  points at inside the buffer
+// NORXSegOffset() / NORXSegLen() - Where segment n is in the container and
+//                                  how many plain bytes it has
+// NORXSegOpen() - Open count segments from first on into pM, plain bytes of
+//                 segment first at pM[0]. pIn is the start of the inLen byte
+//                 container, only the segments asked for are read, and
+//                 nothing is unless inLen matches pSeg. Many segments share
+//                 the batch lanes. Returns how many tags matched, pOk gets
+//                 the result per segment when not NULL.
+//*****************************************************************************
+extern size_t NORXSegSealedSize(uint64_t size, uint32_t segBytes);
+extern size_t NORXSegSeal(const uint8_t* pK, const uint8_t* pPrefix,
+                          uint32_t segBytes, const uint8_t* pM, size_t size,
+                          uint8_t* pOut);
+extern bool NORXSegParse(norx_seg_t* pSeg, const uint8_t* pIn, size_t inLen);
+extern size_t NORXSegOffset(const norx_seg_t* pSeg, uint64_t n);
+extern size_t NORXSegLen(const norx_seg_t* pSeg, uint64_t n);
+extern uint64_t NORXSegOpen(const norx_seg_t* pSeg, const uint8_t* pK,
+                            const uint8_t* pIn, size_t inLen,
+                            uint64_t first, uint64_t count, uint8_t* pM,
+                            bool* pOk);
+
+#endif // NORX_SEG_H
@@ -0,0 +1,1895 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_selftest.c                                                     *
+* Purpose -> Known answer and differential checks of every optimised path     *
+*            against the scalar reference                                     *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Self Test Gate for the Fast Paths               *
+*            2.0 10/17/2026 - Chunked Lane Pool against the Reference         *
+*            3.0 10/17/2026 - Segmented Container Round Trips                 *
+*            4.0 10/17/2026 - io_uring Pipeline against NORXEnc()             *
+*            5.0 10/17/2026 - SPSC Sealing Pipeline against NORXEnc()         *
+*            6.0 10/17/2026 - NORX_STATS Counts of one Known Message          *
+*            7.0 10/17/2026 - iovec Seal and Open on Random Fragments         *
+*            8.0 10/17/2026 - Verify First Decryption Leaves Forgeries Unseen *
+*            9.0 10/17/2026 - Every Shape of the Small Message Path           *
+*           10.0 10/17/2026 - Session Table Streams against NORXKeyEnc()      *
+*           11.0 10/17/2026 - MAC One Shot, Streamed and Batched              *
+*           12.0 10/17/2026 - DRBG Fills and Reseeds against a Reference      *
+*           13.0 10/17/2026 - Streams Checkpointed and Restored Mid Message   *
+*           14.0 10/17/2026 - Non Temporal Payload Stores against refSeal()   *
+*           15.0 10/17/2026 - Engine Variants against Known Answers           *
+*           16.0 10/17/2026 - Pool Reference with POOL_PARAM and Lane Size    *
+*           17.0 10/17/2026 - DRBG Seeding Counted under its Own Domain       *
+*           18.0 10/17/2026 - Containers of the Wrong Length Turned Away      *
+*           19.0 10/17/2026 - NORX_STATS Counts of a Stream and a Pool Seal   *
+*           20.0 10/17/2026 - Streams Opened with NORXStreamFinalCheck()      *
+*           21.0 10/17/2026 - Small Messages through NORXKeyDecVerify()       *
+*           22.0 10/17/2026 - Session Tags Checked by NORXSessTagCheck()      *
+*                                                                             *
+* The known answer is the one the spec gives for F itself: U0 - U15 are two   *
+* single round F calls on (0, 1, ..., 15), so col()/diag() and the U defines  *
+* check each other. Every engine variant, and the core build when it is one   *
+* of them, is checked against the known answers in NORXKats[]. The AEAD is    *
+* then checked against refSeal() below, a byte at a time version of the spec  *
+* built on FScalar() that shares no code with the block loops. For every      *
+* kernel it runs:                                                             *
+*   - F, FLanes() and the batch F against FScalar() on random states          *
+*   - NORXEnc()/NORXDec() for every payload length up to SELFTEST_MAX_BYTES   *
+*   - NORXKeyEnc() on one key schedule kept over all of them                  *
+*   - every small message, header, payload and trailer each under a block     *
+*   - the stream API fed in random pieces, in place                           *
+*   - the batch API on messages of mixed length                               *
+*   - the NORX_engine.h instance with the same parameters, if there is one    *
+*   - the chunked lane pool with short lanes, so most lengths cut into        *
+*     several                                                                 *
+*   - the segmented container, opened whole, one segment at a time and with   *
+*     a segment or the header changed                                         *
+*   - the io_uring pipeline through temporary files and a pipe, with buffers *
+*     small enough that every message spans several                           *
+*   - the SPSC pipeline with rings small enough to fill, so pushes are        *
+*     turned away and records come back sealed one at a time and in batches   *
+*   - with NORX_STATS, the counts one message of known shape leaves behind    *
+*   - the iovec API with every input and output cut into random fragments     *
+*   - streams saved and restored into a spoilt context between random pieces  *
+*   - with P = 1, the session table with many streams fed in random pieces    *
+*     between ticks, so slabs run both in place and gathered                  *
+*   - the MAC against the reference with the message as the header, one       *
+*     shot, streamed in random pieces and batched                             *
+*   - the DRBG against a byte at a time reference over fills of random        *
+*     length, bulk runs and reseeds among them                                *
+*   - the non temporal payload path, to an odd address and in place           *
+* Each message is also opened again, and opened with one tag bit flipped.     *
+* The verify first open must leave the output alone for the flipped tag.      *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <errno.h>     // ENOSYS, EPERM
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdio.h>     // fprintf
+#include <string.h>    // memcmp, memcpy
+#include <unistd.h>    // pipe, write, lseek
+
+#include "NORX.h"          // NORX defines and prototypes
+#include "NORX_simd.h"     // Kernel dispatch
+#include "NORX_stream.h"   // Stream API
+#include "NORX_batch.h"    // Batch API
+#include "NORX_pool.h"     // Chunked lane pool
+#include "NORX_seg.h"      // Segmented container
+#include "NORX_uring.h"    // io_uring pipeline
+#include "NORX_pipe.h"     // SPSC sealing pipeline
+#include "NORX_stats.h"    // Phase counters
+#include "NORX_iov.h"      // Scatter/gather API
+#include "NORX_sess.h"     // Session table
+#include "NORX_mac.h"      // MAC API
+#include "NORX_drbg.h"     // Generator
+#include "NORX_variants.h" // Include instantiated variants
+#include "NORX_selftest.h" // Prototype
+
+//*****************************************************************************
+// Test sizes
+//*****************************************************************************
+#define SELFTEST_STATES     64     // Random states per permutation check
+#define SELFTEST_AD_BYTES   (2 * RATE_BYTES + 5)
+#define SELFTEST_MSGS       (2 * BATCH_LANES + 3)
+#define SELFTEST_POOL_LANE  (2 * RATE_BYTES)   // Pool lane size
+#define SELFTEST_POOL_THREADS  3
+#define SELFTEST_SEG_BYTES  (RATE_BYTES + 5)   // Container segment size
+#define SELFTEST_SEGS       (SELFTEST_MAX_BYTES / SELFTEST_SEG_BYTES + 1)
+#define SELFTEST_URING_BUF  (RATE_BYTES + 3)   // io_uring buffer size
+#define SELFTEST_PIPE_RINGS 2
+#define SELFTEST_PIPE_SLOTS 4
+#define SELFTEST_FRAGS      6                  // Most fragments per list
+
+//*****************************************************************************
+// Buffers, static so the checks do not eat the stack
+//*****************************************************************************
+static uint8_t msgIn[SELFTEST_MSGS][SELFTEST_MAX_BYTES];
+static uint8_t refOut[SELFTEST_MSGS][SELFTEST_MAX_BYTES];
+static uint8_t refTag[SELFTEST_MSGS][TAG_BYTES];
+static uint8_t out[SELFTEST_MSGS][SELFTEST_MAX_BYTES];
+static uint8_t tag[SELFTEST_MSGS][TAG_BYTES];
+static uint8_t head[SELFTEST_AD_BYTES];
+static uint8_t tail[SELFTEST_AD_BYTES];
+static uint8_t key[KEY_BYTES];
+static uint8_t nonce[NONCE_BYTES];
+static uint8_t sealed[SEG_HEADER_BYTES + SELFTEST_MAX_BYTES +
+                      SELFTEST_SEGS * TAG_BYTES];
+static uint8_t uringRef[SELFTEST_MAX_BYTES + TAG_BYTES];
+static uint8_t uringOut[SELFTEST_MAX_BYTES + TAG_BYTES];
+
+static norx_key_t keySched;
+static norx_pool_t* pPool;
+static uint64_t seed;
+
+//*****************************************************************************
+//
+// Function -> nextRand
+// Purpose -> xorshift64, the checks only need the same numbers every run
+//
+//*****************************************************************************
+static uint64_t
+nextRand(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+static void
+fillRand(uint8_t* p, size_t len) {
+  while (len-- > 0) {
+    *p++ = (uint8_t)nextRand();
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> fail
+// Purpose -> Count a failed check and say which one
+//
+//*****************************************************************************
+static uint32_t
+fail(FILE* pLog, const char* what, uint32_t kernel, size_t len) {
+  if (pLog != NULL) {
+    fprintf(pLog, "NORX self test: %s failed, kernel %s, length %zu\n",
+            what, NORXKernelName(kernel), len);
+  }
+  return 1;
+}
+
+//*****************************************************************************
+//
+// Function -> refPhase
+// Purpose -> One phase of the reference, a byte at a time. Block n runs on
+//            lane n % lanes and its rate is turned into bytes, worked on and
+//            turned back.
+// Inputs -> word_t* pwLanes[] - Lane states, 16 words each
+//           uint32_t lanes - Number of lanes, 1 outside the payload
+//           const uint8_t* pIn, len - Phase bytes
+//           uint32_t domain - Domain of the phase
+//           uint8_t* pOut - Payload out, NULL to absorb
+//           bool open - Decrypt rather than encrypt
+//
+//*****************************************************************************
+static void
+refPhase(word_t* pwLanes, uint32_t lanes, const uint8_t* pIn, size_t len,
+         uint32_t domain, uint8_t* pOut, bool open) {
+  uint8_t r[RATE_BYTES];
+  word_t* pwS;
+  size_t n = 0;
+  size_t take;
+  size_t i;
+  uint8_t m;
+
+  if (len == 0) {
+    return;
+  }
+
+  for (;;) {
+    pwS = pwLanes + 16 * ((n / RATE_BYTES) % lanes);
+    pwS[15] ^= domain;
+    FScalar(pwS);
+
+    for (i = 0; i < RATE_WORDS; i++) {
+      storeWord(r + i * WORD_BYTES, pwS[i]);
+    }
+    take = (len - n < RATE_BYTES) ? len - n : RATE_BYTES;
+    for (i = 0; i < take; i++) {
+      if (pOut == NULL) {
+        r[i] ^= pIn[n + i];
+      }
+      else if (!open) {
+        r[i] ^= pIn[n + i];
+        pOut[n + i] = r[i];
+      }
+      else {
+        m = r[i] ^ pIn[n + i];
+        pOut[n + i] = m;
+        r[i] = pIn[n + i];
+      }
+    }
+    if (take < RATE_BYTES) {
+      r[take] ^= 0x01;
+      r[RATE_BYTES - 1] ^= 0x80;
+    }
+    for (i = 0; i < RATE_WORDS; i++) {
+      pwS[i] = loadWord(r + i * WORD_BYTES);
+    }
+
+    if (take < RATE_BYTES) {
+      return;
+    }
+    n += take;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> refSeal
+// Purpose -> Reference NORX for the core build, written straight from the
+//            spec on FScalar(). poolLane > 0 runs chunked lanes instead,
+//            lane n being payload bytes n * poolLane on, like NORX_pool.c.
+//
+//*****************************************************************************
+static void
+refSeal(const uint8_t* pA, size_t aLen, const uint8_t* pIn, size_t len,
+        const uint8_t* pZ, size_t zLen, uint8_t* pOut, uint8_t* pT, bool open,
+        size_t poolLane) {
+  static const word_t U[8] = { U8, U9, U10, U11, U12, U13, U14, U15 };
+  word_t S[16];
+  word_t lanes[16 * PARALLEL];
+  word_t acc[16];
+  word_t K[4];
+  size_t off;
+  size_t take;
+  uint32_t lane;
+  uint32_t i;
+
+  for (i = 0; i < 4; i++) {
+    K[i] = loadWord(key + i * WORD_BYTES);
+    S[i] = loadWord(nonce + i * WORD_BYTES);
+    S[i + 4] = K[i];
+  }
+  for (i = 0; i < 8; i++) {
+    S[i + 8] = U[i];
+  }
+  S[12] ^= WORD_LEN;
+  S[13] ^= RND_NUM;
+  S[14] ^= (poolLane > 0) ? POOL_PARAM : PARALLEL;
+  S[11] ^= (word_t)(poolLane / RATE_BYTES);
+  S[15] ^= TAG_LEN;
+  FScalar(S);
+  for (i = 0; i < 4; i++) {
+    S[12 + i] ^= K[i];
+  }
+
+  refPhase(S, 1, pA, aLen, HEADER_DOMAIN, NULL, false);
+
+  if (poolLane > 0 && len > 0) {
+    memset(acc, 0, sizeof(acc));
+    for (off = 0, lane = 0; off < len; off += take, lane++) {
+      take = (len - off < poolLane) ? len - off : poolLane;
+      memcpy(lanes, S, sizeof(S));
+      lanes[15] ^= BRANCH_DOMAIN;
+      FScalar(lanes);
+      for (i = 0; i < RATE_WORDS; i++) {
+        lanes[i] ^= lane;
+      }
+      refPhase(lanes, 1, pIn + off, take, PAYLOAD_DOMAIN, pOut + off, open);
+      lanes[15] ^= MERGE_DOMAIN;
+      FScalar(lanes);
+      for (i = 0; i < 16; i++) {
+        acc[i] ^= lanes[i];
+      }
+    }
+    memcpy(S, acc, sizeof(S));
+  }
+  else if (PARALLEL == 1 || len == 0) {
+    refPhase(S, 1, pIn, len, PAYLOAD_DOMAIN, pOut, open);
+  }
+  else {
+    for (lane = 0; lane < PARALLEL; lane++) {
+      memcpy(lanes + 16 * lane, S, sizeof(S));
+      lanes[16 * lane + 15] ^= BRANCH_DOMAIN;
+      FScalar(lanes + 16 * lane);
+      for (i = 0; i < RATE_WORDS; i++) {
+        lanes[16 * lane + i] ^= lane;
+      }
+    }
+    refPhase(lanes, PARALLEL, pIn, len, PAYLOAD_DOMAIN, pOut, open);
+    memset(S, 0, sizeof(S));
+    for (lane = 0; lane < PARALLEL; lane++) {
+      lanes[16 * lane + 15] ^= MERGE_DOMAIN;
+      FScalar(lanes + 16 * lane);
+      for (i = 0; i < 16; i++) {
+        S[i] ^= lanes[16 * lane + i];
+      }
+    }
+  }
+
+  refPhase(S, 1, pZ, zLen, TRAILER_DOMAIN, NULL, false);
+
+  S[15] ^= FINAL_DOMAIN;
+  FScalar(S);
+  for (i = 0; i < 4; i++) {
+    S[12 + i] ^= K[i];
+  }
+  FScalar(S);
+  for (i = 0; i < TAG_WORDS; i++) {
+    S[16 - TAG_WORDS + i] ^= K[i];
+    storeWord(pT + i * WORD_BYTES, S[16 - TAG_WORDS + i]);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> checkConstants
+// Purpose -> U0 - U15 are two single rounds of F on (0, 1, ..., 15)
+//
+//*****************************************************************************
+static uint32_t
+checkConstants(FILE* pLog) {
+  static const word_t U[16] = {
+    U0, U1, U2, U3, U4, U5, U6, U7, U8, U9, U10, U11, U12, U13, U14, U15
+  };
+  word_t S[16];
+  uint32_t i;
+
+  for (i = 0; i < 16; i++) {
+    S[i] = i;
+  }
+  for (i = 0; i < 2; i++) {
+    col(S);
+    diag(S);
+  }
+
+  if (memcmp(S, U, sizeof(S)) != 0) {
+    return fail(pLog, "U constants", KERNEL_SCALAR, 0);
+  }
+  return 0;
+}
+
+//*****************************************************************************
+//
+// Known answers for every engine variant. K = 00 01 ..., N = 20 21 ... over
+// the variant's key bytes, and A = M = Z = 00 01 ... 7F cut to the length, as
+// in the spec's appendix. These come from a transcription of the v3 spec
+// kept apart from this tree, not from the refSeal() reading below
+//
+//*****************************************************************************
+#define KAT_BYTES   128
+#define KAT_MAX_KEY 32
+
+typedef struct {
+  const char* name;
+  size_t len;
+  const char* pC;           // hex, len bytes
+  const char* pT;           // hex, keyBytes bytes
+} kat_t;
+
+static const kat_t NORXKats[] = {
+  { "NORX32-4-1", 0,
+    "",
+    "e6d968068b696d832f43822eff26cb09" },
+  { "NORX32-4-1", KAT_BYTES,
+    "6ce94cb548b20fed7b68c6ac60ac4cb5ebb1f09aec5a750ecf50ec0e64938bf2"
+    "4017a4ff0684f808a67c196c31a0af12569be5f7c56ad3bcac88da3686575f93"
+    "43968da22077eecce7d663174908a3f73c9e9ac149b5ce6be69c9e317cd7e7e8"
+    "0c856997740224413ae064a25a8108b8d3a6859274c76586e29c27ed11fb7195",
+    "d554e4bc6b5bb789547759eacdffcf47" },
+  { "NORX64-4-1", 0,
+    "",
+    "7ca991ffaa25f7e2dfd5edb3b2b5d315160c4102769bdab3758b5fe003ed35d4" },
+  { "NORX64-4-1", KAT_BYTES,
+    "c0816e508ae4a0500b93387bbbabc241ac42387ef5e8bf0ec3826cede166a1d5"
+    "caa3e8d62cd641b3faf2aa2adde3e5ed0a13bd8b96d5f0fb7fe39ca780953175"
+    "e245bc3e534b800e9646771f13ea4085cb3e267f106f5f17a064ff234a027c64"
+    "4be78665db1c46a4b01a4fbf5276dfbd30ebbfb88466f8dc897a7816d0d070d8",
+    "d1f2fa3305a32376e23a61d1c989303fbfbd935aa55b17e4e7254733c473408e" },
+  { "NORX64-6-1", 0,
+    "",
+    "52819073c0ed2b510bd3f6dc2e14a05ee32c9760c6fcf4bc972306c9de6b6c5e" },
+  { "NORX64-6-1", KAT_BYTES,
+    "50ce692c19cb9102c612966f0f626b6296de89271c982910aac1c355522e8fa7"
+    "1303f8d5c9de390484ba91a994cff91bf715d6cb22cc00f36402100317196168"
+    "7239dd9453029b87859c109321135940bc1bc81a55a951c71b2942ffdebf8d13"
+    "c4f3872b78d4506f40db653ce3b8d2bea7a2f9e97ff456b7f0db8c9227e22f23",
+    "a0d10d285291bedb7b7cbdc47e0fe2385bf55bc5f057bcab2c57ccd083d29b2c" },
+  { "NORX64-4-4", 0,
+    "",
+    "fd1a56faf6bc188e5596baa947a4daa4b861f0fc960b4ab44aa33090c8e3068a" },
+  { "NORX64-4-4", KAT_BYTES,
+    "b65ad49d081287730376a038f132b20c33e558302027c0d91c030b9c7dda19c7"
+    "511a4f025afd40fda295c92229faea13a6140536440bebfcd362725d9ee90f2c"
+    "2aac106b5f49869b9fe22cd9f18484fc70c2228c1da3072121972c2bd99a292a"
+    "155152b167723ff7cda5bba3da09e369f27bfe538863ff56184001288cc1beec",
+    "01613b7e498000a767f5d5353f8ffd997872057c1fdc5014cf8227ebb8a75cac" },
+};
+
+#define KAT_COUNT (sizeof(NORXKats) / sizeof(NORXKats[0]))
+
+//*****************************************************************************
+//
+// Function -> fromHex
+// Purpose -> Turn len bytes of hex into bytes
+//
+//*****************************************************************************
+static void
+fromHex(const char* pHex, uint8_t* p, size_t len) {
+  size_t i;
+  uint32_t v;
+
+  for (i = 0; i < len; i++) {
+    sscanf(pHex + 2 * i, "%2x", &v);
+    p[i] = (uint8_t)v;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> checkKat
+// Purpose -> Seal the known answer inputs under pVar and compare, then open
+//            them again and open them with one tag bit flipped. A variant
+//            with no entry in NORXKats[] fails
+//
+//*****************************************************************************
+static uint32_t
+checkKat(FILE* pLog, uint32_t kernel, const variant_t* pVar) {
+  uint8_t k[KAT_MAX_KEY], n[KAT_MAX_KEY], t[KAT_MAX_KEY], wantT[KAT_MAX_KEY];
+  uint8_t in[KAT_BYTES], c[KAT_BYTES], wantC[KAT_BYTES], m[KAT_BYTES];
+  uint32_t bad = 0;
+  uint32_t seen = 0;
+  uint32_t i;
+  size_t len;
+
+  for (i = 0; i < KAT_BYTES; i++) {
+    in[i] = (uint8_t)i;
+  }
+  for (i = 0; i < pVar->keyBytes; i++) {
+    k[i] = (uint8_t)i;
+    n[i] = (uint8_t)(0x20 + i);
+  }
+
+  for (i = 0; i < KAT_COUNT; i++) {
+    if (strcmp(NORXKats[i].name, pVar->name) != 0) {
+      continue;
+    }
+    seen++;
+    len = NORXKats[i].len;
+    fromHex(NORXKats[i].pC, wantC, len);
+    fromHex(NORXKats[i].pT, wantT, pVar->keyBytes);
+
+    pVar->pfnEnc(k, n, in, len, in, len, in, len, c, t);
+    if (memcmp(c, wantC, len) != 0 ||
+        memcmp(t, wantT, pVar->keyBytes) != 0) {
+      bad += fail(pLog, pVar->name, kernel, len);
+      continue;
+    }
+    if (!pVar->pfnDec(k, n, in, len, c, len, in, len, t, m) ||
+        memcmp(m, in, len) != 0) {
+      bad += fail(pLog, pVar->name, kernel, len);
+    }
+    t[0] ^= 1;
+    if (pVar->pfnDec(k, n, in, len, c, len, in, len, t, m)) {
+      bad += fail(pLog, pVar->name, kernel, len);
+    }
+  }
+
+  if (seen == 0) {
+    bad += fail(pLog, pVar->name, kernel, 0);
+  }
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> checkPermutations
+// Purpose -> The kernel's F, FLanes() over 1 - 8 states and the batch F must
+//            all give what FScalar() gives
+//
+//*****************************************************************************
+static uint32_t
+checkPermutations(FILE* pLog, uint32_t kernel) {
+  static word_t lanes[SELFTEST_STATES * 16];
+  static word_t want[SELFTEST_STATES * 16];
+  static word_t batch[BATCH_WORDS];
+  uint32_t bad = 0;
+  uint32_t n;
+  uint32_t i;
+  uint32_t j;
+
+  fillRand((uint8_t*)lanes, sizeof(lanes));
+  memcpy(want, lanes, sizeof(lanes));
+  for (i = 0; i < SELFTEST_STATES; i++) {
+    FScalar(want + 16 * i);
+  }
+
+  for (i = 0; i < SELFTEST_STATES; i++) {
+    pfnPermute(lanes + 16 * i);
+  }
+  if (memcmp(lanes, want, sizeof(lanes)) != 0) {
+    bad += fail(pLog, "F", kernel, 0);
+  }
+
+  //
+  // Each lane count runs over states F has already been run on once
+  //
+  for (n = 1; n <= 8; n++) {
+    memcpy(lanes, want, n * 16 * sizeof(word_t));
+    FLanes(lanes, n);
+    for (i = 0; i < n; i++) {
+      FScalar(want + 16 * i);
+    }
+    if (memcmp(lanes, want, n * 16 * sizeof(word_t)) != 0) {
+      bad += fail(pLog, "FLanes", kernel, n);
+    }
+  }
+
+  for (j = 0; j < BATCH_LANES; j++) {
+    for (i = 0; i < 16; i++) {
+      batch[i * BATCH_LANES + j] = want[16 * j + i];
+    }
+    FScalar(want + 16 * j);
+  }
+  pfnPermuteBatch(batch);
+  for (j = 0; j < BATCH_LANES; j++) {
+    for (i = 0; i < 16; i++) {
+      if (batch[i * BATCH_LANES + j] != want[16 * j + i]) {
+        bad += fail(pLog, "batch F", kernel, j);
+        i = 16;
+        j = BATCH_LANES;
+      }
+    }
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> streamSeal
+// Purpose -> Seal through the stream API in random pieces, payload in place
+//
+//*****************************************************************************
+static void
+streamSeal(size_t aLen, const uint8_t* pM, size_t len, size_t zLen,
+           uint8_t* pC, uint8_t* pT) {
+  norx_stream_t ctx;
+  size_t done;
+  size_t take;
+
+  NORXStreamInit(&ctx, key, nonce);
+  for (done = 0; done < aLen; done += take) {
+    take = 1 + nextRand() % RATE_BYTES;
+    take = (take < aLen - done) ? take : aLen - done;
+    NORXStreamHeader(&ctx, head + done, take);
+  }
+  memcpy(pC, pM, len);
+  for (done = 0; done < len; done += take) {
+    take = nextRand() % (2 * RATE_BYTES + 1);
+    take = (take < len - done) ? take : len - done;
+    NORXStreamEncrypt(&ctx, pC + done, take, pC + done);
+  }
+  for (done = 0; done < zLen; done += take) {
+    take = 1 + nextRand() % RATE_BYTES;
+    take = (take < zLen - done) ? take : zLen - done;
+    NORXStreamTrailer(&ctx, tail + done, take);
+  }
+  NORXStreamFinal(&ctx, pT);
+}
+
+//*****************************************************************************
+//
+// Function -> streamOpen
+// Purpose -> Open through the stream API in one piece per phase
+// Returns -> What NORXStreamFinalCheck() says about pT
+//
+//*****************************************************************************
+static bool
+streamOpen(size_t aLen, const uint8_t* pC, size_t len, size_t zLen,
+           const uint8_t* pT, uint8_t* pM) {
+  norx_stream_t ctx;
+
+  NORXStreamInitKey(&ctx, &keySched, nonce);
+  NORXStreamHeader(&ctx, head, aLen);
+  NORXStreamDecrypt(&ctx, pC, len, pM);
+  NORXStreamTrailer(&ctx, tail, zLen);
+  if (!NORXStreamFinalCheck(&ctx, pT)) {
+    return false;
+  }
+
+  //
+  // A second check on the wiped context must not pass
+  //
+  return !NORXStreamFinalCheck(&ctx, pT);
+}
+
+//*****************************************************************************
+//
+// Function -> checkAead
+// Purpose -> Every payload length through each AEAD path against refSeal()
+//
+//*****************************************************************************
+static uint32_t
+checkAead(FILE* pLog, uint32_t kernel, const variant_t* pVar) {
+  norx_msg_t msgs[SELFTEST_MSGS];
+  bool ok[SELFTEST_MSGS];
+  uint8_t plain[SELFTEST_MAX_BYTES];
+  uint32_t bad = 0;
+  size_t aLen;
+  size_t zLen;
+  size_t len;
+  uint32_t i;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len++) {
+    aLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    zLen = (len % 3 == 0) ? 0 : nextRand() % (SELFTEST_AD_BYTES + 1);
+    refSeal(head, aLen, msgIn[0], len, tail, zLen, refOut[0], refTag[0], false,
+            0);
+
+    NORXEnc(key, nonce, head, aLen, msgIn[0], len, tail, zLen, out[0], tag[0]);
+    if (memcmp(out[0], refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "NORXEnc", kernel, len);
+    }
+
+    //
+    // The same key schedule is used for every length, it must not change
+    //
+    NORXKeyEnc(&keySched, nonce, head, aLen, msgIn[0], len, tail, zLen,
+               out[0], tag[0]);
+    if (memcmp(out[0], refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "NORXKeyEnc", kernel, len);
+    }
+
+    if (!NORXDec(key, nonce, head, aLen, out[0], len, tail, zLen, tag[0],
+                 plain) || memcmp(plain, msgIn[0], len) != 0) {
+      bad += fail(pLog, "NORXDec", kernel, len);
+    }
+    memset(plain, 0xa5, len);
+    if (!NORXKeyDecVerify(&keySched, nonce, head, aLen, out[0], len, tail,
+                          zLen, tag[0], plain) ||
+        memcmp(plain, msgIn[0], len) != 0) {
+      bad += fail(pLog, "NORXKeyDecVerify", kernel, len);
+    }
+    tag[0][len % TAG_BYTES] ^= (uint8_t)(1 << (len % 8));
+    if (NORXDec(key, nonce, head, aLen, out[0], len, tail, zLen, tag[0],
+                plain)) {
+      bad += fail(pLog, "NORXDec forged tag", kernel, len);
+    }
+
+    //
+    // Verify first must not write a byte of a forged message
+    //
+    memset(plain, 0xa5, len);
+    if (NORXDecVerify(key, nonce, head, aLen, out[0], len, tail, zLen, tag[0],
+                      plain)) {
+      bad += fail(pLog, "NORXDecVerify forged tag", kernel, len);
+    }
+    for (i = 0; i < len; i++) {
+      if (plain[i] != 0xa5) {
+        bad += fail(pLog, "NORXDecVerify wrote forged", kernel, len);
+        break;
+      }
+    }
+
+    streamSeal(aLen, msgIn[0], len, zLen, out[0], tag[0]);
+    if (memcmp(out[0], refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "stream", kernel, len);
+    }
+    if (!streamOpen(aLen, out[0], len, zLen, tag[0], plain) ||
+        memcmp(plain, msgIn[0], len) != 0) {
+      bad += fail(pLog, "stream open", kernel, len);
+    }
+    tag[0][len % TAG_BYTES] ^= 0x80;
+    if (streamOpen(aLen, out[0], len, zLen, tag[0], plain)) {
+      bad += fail(pLog, "stream open forged tag", kernel, len);
+    }
+
+    if (pVar != NULL) {
+      pVar->pfnEnc(key, nonce, head, aLen, msgIn[0], len, tail, zLen,
+                   out[0], tag[0]);
+      if (memcmp(out[0], refOut[0], len) != 0 ||
+          memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+        bad += fail(pLog, pVar->name, kernel, len);
+      }
+    }
+
+    //
+    // Chunked lanes on the pool, in place, then opened again in place
+    //
+    if (pPool != NULL) {
+      refSeal(head, aLen, msgIn[0], len, tail, zLen, refOut[1], refTag[1],
+              false, SELFTEST_POOL_LANE);
+      memcpy(out[0], msgIn[0], len);
+      NORXPoolEnc(pPool, &keySched, nonce, head, aLen, out[0], len, tail, zLen,
+                  out[0], tag[0]);
+      if (memcmp(out[0], refOut[1], len) != 0 ||
+          memcmp(tag[0], refTag[1], TAG_BYTES) != 0) {
+        bad += fail(pLog, "NORXPoolEnc", kernel, len);
+      }
+      if (!NORXPoolDec(pPool, &keySched, nonce, head, aLen, out[0], len, tail,
+                       zLen, tag[0], out[0]) ||
+          memcmp(out[0], msgIn[0], len) != 0) {
+        bad += fail(pLog, "NORXPoolDec", kernel, len);
+      }
+    }
+  }
+
+  //
+  // Header, payload and trailer all under a block take the small message
+  // path, every length of each is run
+  //
+  for (len = 0; len < RATE_BYTES; len++) {
+    aLen = RATE_BYTES - 1 - len;
+    zLen = (len * 7) % RATE_BYTES;
+    refSeal(head, aLen, msgIn[0], len, tail, zLen, refOut[0], refTag[0], false,
+            0);
+    memcpy(out[0], msgIn[0], len);
+    NORXKeyEnc(&keySched, nonce, head, aLen, out[0], len, tail, zLen,
+               out[0], tag[0]);
+    if (memcmp(out[0], refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "NORXKeyEnc small", kernel, len);
+    }
+    memset(plain, 0xa5, len);
+    if (!NORXKeyDecVerify(&keySched, nonce, head, aLen, out[0], len, tail,
+                          zLen, tag[0], plain) ||
+        memcmp(plain, msgIn[0], len) != 0) {
+      bad += fail(pLog, "NORXKeyDecVerify small", kernel, len);
+    }
+    memset(plain, 0xa5, len);
+    tag[0][len % TAG_BYTES] ^= 0x01;
+    if (NORXKeyDecVerify(&keySched, nonce, head, aLen, out[0], len, tail,
+                         zLen, tag[0], plain)) {
+      bad += fail(pLog, "NORXKeyDecVerify small forged tag", kernel, len);
+    }
+    for (i = 0; i < len; i++) {
+      if (plain[i] != 0xa5) {
+        bad += fail(pLog, "NORXKeyDecVerify small wrote forged", kernel, len);
+        break;
+      }
+    }
+    tag[0][len % TAG_BYTES] ^= 0x01;
+    if (!NORXKeyDec(&keySched, nonce, head, aLen, out[0], len, tail, zLen,
+                    tag[0], out[0]) ||
+        memcmp(out[0], msgIn[0], len) != 0) {
+      bad += fail(pLog, "NORXKeyDec small", kernel, len);
+    }
+  }
+
+  //
+  // Batch of mixed lengths, so lanes finish and refill at different times,
+  // opened in place
+  //
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    msgs[i].pK = key;
+    msgs[i].pN = nonce;
+    msgs[i].pA = head;
+    msgs[i].aLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    msgs[i].pIn = msgIn[i];
+    msgs[i].inLen = nextRand() % (SELFTEST_MAX_BYTES + 1);
+    msgs[i].pZ = tail;
+    msgs[i].zLen = (i % 2 == 0) ? 0 : nextRand() % (SELFTEST_AD_BYTES + 1);
+    msgs[i].pOut = out[i];
+    msgs[i].pT = tag[i];
+    refSeal(head, msgs[i].aLen, msgIn[i], msgs[i].inLen, tail, msgs[i].zLen,
+            refOut[i], refTag[i], false, 0);
+  }
+  NORXBatchSeal(msgs, SELFTEST_MSGS);
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    if (memcmp(out[i], refOut[i], msgs[i].inLen) != 0 ||
+        memcmp(tag[i], refTag[i], TAG_BYTES) != 0) {
+      bad += fail(pLog, "batch seal", kernel, msgs[i].inLen);
+    }
+    msgs[i].pIn = out[i];
+  }
+  tag[1][0] ^= 0x01;
+  if (NORXBatchOpen(msgs, SELFTEST_MSGS, ok) != SELFTEST_MSGS - 1 || ok[1]) {
+    bad += fail(pLog, "batch open tags", kernel, 0);
+  }
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    if (memcmp(out[i], msgIn[i], msgs[i].inLen) != 0) {
+      bad += fail(pLog, "batch open", kernel, msgs[i].inLen);
+    }
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> checkSegments
+// Purpose -> Containers of every length up to SELFTEST_MAX_BYTES must open
+//            whole and a segment at a time, a changed segment must fail on
+//            its own and a changed header on every segment. A container
+//            one byte short or long, or whose header claims a size that
+//            does not fit, must not parse
+//
+//*****************************************************************************
+static uint32_t
+checkSegments(FILE* pLog, uint32_t kernel) {
+  norx_seg_t seg;
+  bool ok[SELFTEST_SEGS];
+  uint32_t bad = 0;
+  size_t whole;
+  size_t len;
+  size_t off;
+  uint64_t n;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len += 1 + len / 4) {
+    whole = NORXSegSeal(key, nonce, SELFTEST_SEG_BYTES, msgIn[0], len, sealed);
+    if (!NORXSegParse(&seg, sealed, whole) || seg.size != len) {
+      bad += fail(pLog, "segment header", kernel, len);
+      continue;
+    }
+    if (NORXSegParse(&seg, sealed, whole - 1) ||
+        NORXSegParse(&seg, sealed, whole + 1) ||
+        NORXSegOpen(&seg, key, sealed, whole - 1, 0, 1, out[0], NULL) != 0) {
+      bad += fail(pLog, "segment length", kernel, len);
+    }
+
+    //
+    // Sizes whose containers wrap around, the top byte of the plain size
+    //
+    sealed[23] ^= 0xff;
+    if (NORXSegParse(&seg, sealed, whole)) {
+      bad += fail(pLog, "segment size overflow", kernel, len);
+    }
+    sealed[23] ^= 0xff;
+    NORXSegParse(&seg, sealed, whole);
+
+    memset(out[0], 0, len);
+    if (NORXSegOpen(&seg, key, sealed, whole, 0, seg.segs, out[0], ok) !=
+        seg.segs || memcmp(out[0], msgIn[0], len) != 0) {
+      bad += fail(pLog, "segment open", kernel, len);
+    }
+    for (n = 0; n < seg.segs; n++) {
+      off = (size_t)n * SELFTEST_SEG_BYTES;
+      if (NORXSegOpen(&seg, key, sealed, whole, n, 1, out[1], NULL) != 1 ||
+          memcmp(out[1], msgIn[0] + off, NORXSegLen(&seg, n)) != 0) {
+        bad += fail(pLog, "segment random access", kernel, len);
+      }
+    }
+
+    //
+    // First byte of segment 0, its tag when the segment is empty
+    //
+    off = NORXSegOffset(&seg, 0);
+    sealed[off] ^= 0x01;
+
+    sealed[SEG_HEADER_BYTES - 1] ^= 0x01;
+    NORXSegParse(&seg, sealed, whole);
+    if (NORXSegOpen(&seg, key, sealed, whole, 0, seg.segs, out[0], NULL) != 0) {
+      bad += fail(pLog, "segment header forged", kernel, len);
+    }
+    sealed[SEG_HEADER_BYTES - 1] ^= 0x01;
+    NORXSegParse(&seg, sealed, whole);
+    if (NORXSegOpen(&seg, key, sealed, whole, 0, seg.segs, out[0], ok) !=
+        seg.segs - 1 || ok[0]) {
+      bad += fail(pLog, "segment forged", kernel, len);
+    }
+    sealed[off] ^= 0x01;
+
+    sealed[SEG_HEADER_BYTES - 1] ^= 0x01;
+    NORXSegParse(&seg, sealed, whole);
+    if (NORXSegOpen(&seg, key, sealed, whole, 0, seg.segs, out[0], NULL) != 0) {
+      bad += fail(pLog, "segment header forged", kernel, len);
+    }
+    sealed[SEG_HEADER_BYTES - 1] ^= 0x01;
+    NORXSegParse(&seg, sealed, whole);
+
+    //
+    // A container cut short by one segment, with the header to match,
+    // loses its last segment flag
+    //
+    if (seg.segs > 1) {
+      seg.size -= NORXSegLen(&seg, seg.segs - 1);
+      seg.segs--;
+      if (NORXSegOpen(&seg, key, sealed, NORXSegOffset(&seg, seg.segs),
+                      seg.segs - 1, 1, out[0], NULL) != 0) {
+        bad += fail(pLog, "segment truncated", kernel, len);
+      }
+    }
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> readBack
+// Purpose -> Read a whole temporary file back from its start
+//
+//*****************************************************************************
+static size_t
+readBack(FILE* pF, uint8_t* p, size_t max) {
+  size_t got;
+
+  fflush(pF);
+  rewind(pF);
+  got = fread(p, 1, max, pF);
+  rewind(pF);
+  return got;
+}
+
+//*****************************************************************************
+//
+// Function -> checkUring
+// Purpose -> The io_uring pipeline must give what NORXEnc() gives, from a
+//            file and from a pipe, open it again and turn down a changed
+//            tag. Kernels without io_uring, or where it is turned off, skip
+//            the check.
+//
+//*****************************************************************************
+static uint32_t
+checkUring(FILE* pLog, uint32_t kernel) {
+  FILE* pIn;
+  FILE* pOut;
+  int fds[2];
+  uint32_t bad = 0;
+  size_t len;
+  size_t got;
+  int rc;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len += 1 + len / 2) {
+    pIn = tmpfile();
+    pOut = tmpfile();
+    if (pIn == NULL || pOut == NULL) {
+      bad += fail(pLog, "uring tmpfile", kernel, len);
+      if (pIn != NULL) {
+        fclose(pIn);
+      }
+      if (pOut != NULL) {
+        fclose(pOut);
+      }
+      break;
+    }
+    NORXEnc(key, nonce, head, SELFTEST_AD_BYTES, msgIn[0], len, NULL, 0,
+            uringRef, uringRef + len);
+
+    fwrite(msgIn[0], 1, len, pIn);
+    fflush(pIn);
+    rc = NORXUringEnc(fileno(pIn), fileno(pOut), &keySched, nonce, head,
+                      SELFTEST_AD_BYTES, SELFTEST_URING_BUF, NULL);
+    if (rc == -ENOSYS || rc == -EPERM) {
+      fclose(pIn);
+      fclose(pOut);
+      break;
+    }
+    got = readBack(pOut, uringOut, sizeof(uringOut));
+    if (rc != 0 || got != len + TAG_BYTES ||
+        memcmp(uringOut, uringRef, got) != 0) {
+      bad += fail(pLog, "uring seal", kernel, len);
+    }
+
+    //
+    // Open the sealed file back into the input file
+    //
+    if (ftruncate(fileno(pIn), 0) != 0 ||
+        NORXUringDec(fileno(pOut), fileno(pIn), &keySched, nonce, head,
+                     SELFTEST_AD_BYTES, SELFTEST_URING_BUF, NULL) != 0 ||
+        readBack(pIn, out[1], sizeof(out[1])) != len ||
+        memcmp(out[1], msgIn[0], len) != 0) {
+      bad += fail(pLog, "uring open", kernel, len);
+    }
+
+    uringOut[len] ^= 0x01;
+    fwrite(uringOut, 1, len + TAG_BYTES, pOut);
+    fflush(pOut);
+    if (ftruncate(fileno(pIn), 0) != 0 ||
+        NORXUringDec(fileno(pOut), fileno(pIn), &keySched, nonce, head,
+                     SELFTEST_AD_BYTES, SELFTEST_URING_BUF, NULL) !=
+        URING_BAD_TAG) {
+      bad += fail(pLog, "uring forged", kernel, len);
+    }
+
+    //
+    // A pipe has no size and no offsets, it is read a buffer at a time
+    // until it ends
+    //
+    if (ftruncate(fileno(pOut), 0) != 0 || pipe(fds) != 0) {
+      bad += fail(pLog, "uring pipe", kernel, len);
+    }
+    else {
+      if (write(fds[1], msgIn[0], len) != (ssize_t)len) {
+        bad += fail(pLog, "uring pipe", kernel, len);
+      }
+      close(fds[1]);
+      rc = NORXUringEnc(fds[0], fileno(pOut), &keySched, nonce, head,
+                        SELFTEST_AD_BYTES, SELFTEST_URING_BUF, NULL);
+      close(fds[0]);
+      if (rc != 0 || readBack(pOut, uringOut, sizeof(uringOut)) !=
+                     len + TAG_BYTES ||
+          memcmp(uringOut, uringRef, len + TAG_BYTES) != 0) {
+        bad += fail(pLog, "uring pipe seal", kernel, len);
+      }
+    }
+
+    fclose(pIn);
+    fclose(pOut);
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> checkPipe
+// Purpose -> Records pushed through the SPSC pipeline must come back from
+//            their ring in order and sealed like NORXEnc() seals them. The
+//            rings are small, so pushes are turned away while full and the
+//            workers see anything from one record to a whole ring.
+//
+//*****************************************************************************
+static uint32_t
+checkPipe(FILE* pLog, uint32_t kernel) {
+  norx_pipe_t* pPipe;
+  const norx_rec_t* pRec;
+  uint8_t N[NONCE_BYTES];
+  uint64_t pushed = 0;
+  uint64_t popped[SELFTEST_PIPE_RINGS] = { 0 };
+  uint64_t done = 0;
+  uint64_t n;
+  uint32_t r;
+  uint32_t bad = 0;
+  size_t len;
+
+  pPipe = NORXPipeCreate(key, SELFTEST_PIPE_RINGS, SELFTEST_PIPE_SLOTS,
+                         SELFTEST_AD_BYTES + SELFTEST_MAX_BYTES);
+  if (pPipe == NULL || NORXPipeWorkers(pPipe) != SELFTEST_PIPE_RINGS) {
+    NORXPipeDestroy(pPipe);
+    return fail(pLog, "NORXPipeCreate", kernel, 0);
+  }
+
+  //
+  // Record n is payload length n on ring n % rings, nonce byte 0 is n.
+  // Whatever is sealed is drained and checked whenever a push is turned
+  // away, and once they are all pushed.
+  //
+  memcpy(N, nonce, NONCE_BYTES);
+  while (pushed <= SELFTEST_MAX_BYTES || done < pushed) {
+    r = (uint32_t)(pushed % SELFTEST_PIPE_RINGS);
+    N[0] = (uint8_t)pushed;
+    if (pushed <= SELFTEST_MAX_BYTES &&
+        NORXPipePush(pPipe, r, N, head, pushed % SELFTEST_AD_BYTES,
+                     msgIn[0], (size_t)pushed, pushed)) {
+      pushed++;
+      continue;
+    }
+
+    for (r = 0; r < SELFTEST_PIPE_RINGS; r++) {
+      while ((pRec = NORXPipePeek(pPipe, r)) != NULL) {
+        n = popped[r] * SELFTEST_PIPE_RINGS + r;
+        len = (size_t)n;
+        N[0] = (uint8_t)n;
+        NORXEnc(key, N, head, len % SELFTEST_AD_BYTES, msgIn[0], len,
+                NULL, 0, out[0], tag[0]);
+        if (pRec->user != n || pRec->len != len ||
+            memcmp(pRec->pC, out[0], len) != 0 ||
+            memcmp(pRec->t, tag[0], TAG_BYTES) != 0) {
+          bad += fail(pLog, "pipe seal", kernel, len);
+        }
+        NORXPipePop(pPipe, r);
+        popped[r]++;
+        done++;
+      }
+    }
+  }
+
+  if (NORXPipePush(pPipe, 0, nonce, head, SELFTEST_AD_BYTES, msgIn[0],
+                   SELFTEST_MAX_BYTES + 1, 0)) {
+    bad += fail(pLog, "pipe oversize", kernel, SELFTEST_MAX_BYTES + 1);
+  }
+  NORXPipeDestroy(pPipe);
+
+  return bad;
+}
+
+#ifdef NORX_STATS
+//*****************************************************************************
+//
+// Function -> checkDomains
+// Purpose -> Compare the domain counts of a snapshot with the perms, blocks
+//            and bytes wanted for each domain
+// Returns -> Number of domains that were off
+//
+//*****************************************************************************
+static uint32_t
+checkDomains(FILE* pLog, const char* what, uint32_t kernel,
+             const uint64_t want[STAT_DOMAINS][3], const norx_stats_t* pSt) {
+  char name[64];
+  uint32_t bad = 0;
+  uint32_t i;
+
+  for (i = 0; i < STAT_DOMAINS; i++) {
+    if (pSt->domain[i].perms != want[i][0] ||
+        pSt->domain[i].blocks != want[i][1] ||
+        pSt->domain[i].bytes != want[i][2]) {
+      snprintf(name, sizeof(name), "%s %s", what, NORXStatsDomainName(i));
+      bad += fail(pLog, name, kernel, 2 * RATE_BYTES + 1);
+    }
+  }
+  return bad;
+}
+#endif
+
+//*****************************************************************************
+//
+// Function -> checkStats
+// Purpose -> One NORXKeyEnc() call with a header of 3 blocks, a payload of
+//            3 and a trailer of 1 must leave exactly those counts behind.
+//            The same message streamed in pieces must too, and sealed on
+//            the pool its payload is 2 lanes of 2 blocks each. Seeding the
+//            DRBG counts only under its own domain.
+//            Only built with NORX_STATS, nothing else may seal meanwhile.
+//
+//*****************************************************************************
+static uint32_t
+checkStats(FILE* pLog, uint32_t kernel) {
+#ifdef NORX_STATS
+  static const uint64_t want[STAT_DOMAINS][3] = {
+    { 3, 3, SELFTEST_AD_BYTES },
+    { 3, 3, 2 * RATE_BYTES + 1 },
+    { 1, 1, 3 },
+    { 2, 0, TAG_BYTES },
+    { (PARALLEL > 1) ? PARALLEL : 0, 0, 0 },
+    { (PARALLEL > 1) ? PARALLEL : 0, 0, 0 },
+    { 0, 0, 0 }
+  };
+  static const uint64_t wantPool[STAT_DOMAINS][3] = {
+    { 3, 3, SELFTEST_AD_BYTES },
+    { 4, 4, 2 * RATE_BYTES + 1 },
+    { 1, 1, 3 },
+    { 2, 0, TAG_BYTES },
+    { 2, 0, 0 },
+    { 2, 0, 0 },
+    { 0, 0, 0 }
+  };
+  norx_stream_t ctx;
+  norx_drbg_t gen;
+  norx_stats_t st;
+  uint64_t domainPerms = 0;
+  uint64_t phasePerms = 0;
+  uint32_t bad = 0;
+  uint32_t i;
+
+  NORXStatsReset();
+  NORXKeyEnc(&keySched, nonce, head, SELFTEST_AD_BYTES, msgIn[0],
+             2 * RATE_BYTES + 1, tail, 3, out[0], tag[0]);
+  if (!NORXStatsSnapshot(&st)) {
+    return fail(pLog, "stats snapshot", kernel, 0);
+  }
+
+  bad += checkDomains(pLog, "stats", kernel, want, &st);
+  for (i = 0; i < STAT_DOMAINS; i++) {
+    domainPerms += st.domain[i].perms;
+  }
+  for (i = 0; i < STAT_PHASES; i++) {
+    phasePerms += st.phase[i].perms;
+  }
+
+  //
+  // The F of initialise() is the only one outside a domain
+  //
+  if (phasePerms != domainPerms + 1 || st.phase[STAT_INIT].calls != 1 ||
+      st.phase[STAT_ABSORB].calls != 2 || st.phase[STAT_DECRYPT].calls != 0) {
+    bad += fail(pLog, "stats phases", kernel, 2 * RATE_BYTES + 1);
+  }
+
+  //
+  // The stream runs its own open blocks, the payload is cut so one block
+  // is topped up across the two pieces
+  //
+  NORXStatsReset();
+  NORXStreamInitKey(&ctx, &keySched, nonce);
+  NORXStreamHeader(&ctx, head, SELFTEST_AD_BYTES);
+  NORXStreamEncrypt(&ctx, msgIn[0], 5, out[1]);
+  NORXStreamEncrypt(&ctx, msgIn[0] + 5, 2 * RATE_BYTES + 1 - 5, out[1] + 5);
+  NORXStreamTrailer(&ctx, tail, 3);
+  NORXStreamFinal(&ctx, tag[1]);
+  NORXStatsSnapshot(&st);
+  bad += checkDomains(pLog, "stats stream", kernel, want, &st);
+
+  //
+  // The pool branches and merges each lane itself, on whichever thread
+  // takes it
+  //
+  if (pPool != NULL) {
+    NORXStatsReset();
+    NORXPoolEnc(pPool, &keySched, nonce, head, SELFTEST_AD_BYTES, msgIn[0],
+                2 * RATE_BYTES + 1, tail, 3, out[1], tag[1]);
+    NORXStatsSnapshot(&st);
+    bad += checkDomains(pLog, "stats pool", kernel, wantPool, &st);
+  }
+
+  //
+  // Seed bytes count as DRBG work, not as the merge's
+  //
+  NORXStatsReset();
+  NORXDrbgSeed(&gen, head, SELFTEST_AD_BYTES);
+  NORXDrbgWipe(&gen);
+  NORXStatsSnapshot(&st);
+  i = STAT_DOMAIN_DRBG;
+  if (st.domain[i].blocks != SELFTEST_AD_BYTES / RATE_BYTES + 1 ||
+      st.domain[i].bytes != SELFTEST_AD_BYTES ||
+      st.domain[5].perms != 0) {
+    bad += fail(pLog, "stats drbg", kernel, SELFTEST_AD_BYTES);
+  }
+
+  return bad;
+#else
+  (void)pLog;
+  (void)kernel;
+  return 0;
+#endif
+}
+
+//*****************************************************************************
+//
+// Function -> cutIov
+// Purpose -> Cut len bytes at p into up to SELFTEST_FRAGS fragments at
+//            random, empty ones included
+// Returns -> Number of fragments
+//
+//*****************************************************************************
+static size_t
+cutIov(uint8_t* p, size_t len, struct iovec* pV) {
+  size_t cnt = 1 + nextRand() % SELFTEST_FRAGS;
+  size_t take;
+  size_t i;
+
+  for (i = 0; i < cnt; i++) {
+    take = (i + 1 == cnt || len == 0) ? len : nextRand() % (len + 1);
+    pV[i].iov_base = p;
+    pV[i].iov_len = take;
+    p += take;
+    len -= take;
+  }
+  return cnt;
+}
+
+//*****************************************************************************
+//
+// Function -> checkIov
+// Purpose -> The iovec API must give what NORXKeyEnc() gives with header,
+//            payload, trailer and output each cut up differently, open it
+//            again in place and turn down a changed tag or a short output
+//
+//*****************************************************************************
+static uint32_t
+checkIov(FILE* pLog, uint32_t kernel) {
+  struct iovec a[SELFTEST_FRAGS];
+  struct iovec m[SELFTEST_FRAGS];
+  struct iovec z[SELFTEST_FRAGS];
+  struct iovec c[SELFTEST_FRAGS];
+  size_t aCnt;
+  size_t mCnt;
+  size_t zCnt;
+  size_t cCnt;
+  size_t aLen;
+  size_t zLen;
+  uint32_t bad = 0;
+  size_t len;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len++) {
+    aLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    zLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    NORXKeyEnc(&keySched, nonce, head, aLen, msgIn[0], len, tail, zLen,
+               refOut[0], refTag[0]);
+
+    aCnt = cutIov(head, aLen, a);
+    mCnt = cutIov(msgIn[0], len, m);
+    zCnt = cutIov(tail, zLen, z);
+    cCnt = cutIov(out[0], len, c);
+    if (!NORXIovEnc(&keySched, nonce, a, aCnt, m, mCnt, z, zCnt, c, cCnt,
+                    tag[0]) ||
+        memcmp(out[0], refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "iovec seal", kernel, len);
+    }
+
+    aCnt = cutIov(head, aLen, a);
+    cCnt = cutIov(out[0], len, c);
+    zCnt = cutIov(tail, zLen, z);
+    if (!NORXIovDec(&keySched, nonce, a, aCnt, c, cCnt, z, zCnt, tag[0],
+                    c, cCnt) ||
+        memcmp(out[0], msgIn[0], len) != 0) {
+      bad += fail(pLog, "iovec open", kernel, len);
+    }
+
+    tag[0][len % TAG_BYTES] ^= 0x01;
+    mCnt = cutIov(out[1], len, m);
+    if (NORXIovDec(&keySched, nonce, a, aCnt, c, cCnt, z, zCnt, tag[0],
+                   m, mCnt)) {
+      bad += fail(pLog, "iovec forged tag", kernel, len);
+    }
+
+    if (len > 0) {
+      cCnt = cutIov(out[0], len - 1, c);
+      if (NORXIovEnc(&keySched, nonce, a, aCnt, m, mCnt, z, zCnt, c, cCnt,
+                     tag[0])) {
+        bad += fail(pLog, "iovec short output", kernel, len);
+      }
+    }
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> runSessions
+// Purpose -> Seal or open message i of msgs on session i, every session
+//            fed a random piece of its current phase between ticks, and
+//            check each comes out like NORXKeyEnc(). Opened sessions check
+//            their tags with NORXSessTagCheck(), every other one is given
+//            a forged tag to turn down.
+// Returns -> Failed checks
+//
+//*****************************************************************************
+static uint32_t
+runSessions(FILE* pLog, uint32_t kernel, norx_sess_t* pTab,
+            const norx_msg_t* pMsgs, bool open) {
+  uint32_t id[SELFTEST_MSGS];
+  uint32_t phase[SELFTEST_MSGS];
+  size_t off[SELFTEST_MSGS];
+  uint8_t N[NONCE_BYTES];
+  uint8_t T[TAG_BYTES];
+  const norx_msg_t* pMsg;
+  uint32_t done = 0;
+  uint32_t bad = 0;
+  uint32_t i;
+  size_t want;
+  size_t taken;
+  bool match;
+  bool ok;
+
+  memcpy(N, nonce, NONCE_BYTES);
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    N[0] = (uint8_t)i;
+    id[i] = NORXSessStart(pTab, &keySched, N);
+    phase[i] = (id[i] == SESS_NONE) ? 4 : 0;
+    off[i] = 0;
+    if (id[i] == SESS_NONE) {
+      bad += fail(pLog, "NORXSessStart", kernel, i);
+      done++;
+    }
+  }
+
+  while (done < SELFTEST_MSGS) {
+    for (i = 0; i < SELFTEST_MSGS; i++) {
+      pMsg = &pMsgs[i];
+      if (phase[i] == 4 || NORXSessBusy(pTab, id[i])) {
+        continue;
+      }
+      if (phase[i] == 3) {
+        if (open) {
+          memcpy(T, refTag[i], TAG_BYTES);
+          T[i % TAG_BYTES] ^= (uint8_t)(i % 2);
+          ok = NORXSessTagCheck(pTab, id[i], T, &match);
+          match = ok && match == (i % 2 == 0);
+        }
+        else {
+          ok = NORXSessTag(pTab, id[i], tag[i]);
+          match = (memcmp(tag[i], refTag[i], TAG_BYTES) == 0);
+        }
+        if (ok) {
+          if (!match || memcmp(pMsg->pOut, open ? msgIn[i] : refOut[i],
+                               pMsg->inLen) != 0) {
+            bad += fail(pLog, open ? "session open" : "session seal", kernel,
+                        pMsg->inLen);
+          }
+          phase[i] = 4;
+          done++;
+        }
+        continue;
+      }
+
+      want = (phase[i] == 0) ? pMsg->aLen :
+             (phase[i] == 1) ? pMsg->inLen : pMsg->zLen;
+      if (off[i] == want) {
+        if (++phase[i] == 3) {
+          NORXSessFinal(pTab, id[i]);
+        }
+        off[i] = 0;
+        continue;
+      }
+
+      want = 1 + nextRand() % (RATE_BYTES + 3);
+      if (want > ((phase[i] == 0) ? pMsg->aLen :
+                  (phase[i] == 1) ? pMsg->inLen : pMsg->zLen) - off[i]) {
+        want = ((phase[i] == 0) ? pMsg->aLen :
+                (phase[i] == 1) ? pMsg->inLen : pMsg->zLen) - off[i];
+      }
+      if (phase[i] == 0) {
+        ok = NORXSessHeader(pTab, id[i], pMsg->pA + off[i], want, &taken);
+      }
+      else if (phase[i] == 2) {
+        ok = NORXSessTrailer(pTab, id[i], pMsg->pZ + off[i], want, &taken);
+      }
+      else if (open) {
+        ok = NORXSessDecrypt(pTab, id[i], pMsg->pIn + off[i], want,
+                             pMsg->pOut + off[i], &taken);
+      }
+      else {
+        ok = NORXSessEncrypt(pTab, id[i], pMsg->pIn + off[i], want,
+                             pMsg->pOut + off[i], &taken);
+      }
+      if (!ok) {
+        bad += fail(pLog, "session feed", kernel, pMsg->inLen);
+        NORXSessDrop(pTab, id[i]);
+        phase[i] = 4;
+        done++;
+      }
+      off[i] += taken;
+    }
+    NORXSessTick(pTab);
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> checkSess
+// Purpose -> Streams on the session table must seal and open like
+//            NORXKeyEnc(). There are more sessions than two slabs, the
+//            first are dropped and started again so ids are reused.
+//
+//*****************************************************************************
+static uint32_t
+checkSess(FILE* pLog, uint32_t kernel) {
+  norx_msg_t msgs[SELFTEST_MSGS];
+  uint8_t N[NONCE_BYTES];
+  norx_sess_t* pTab;
+  uint32_t bad = 0;
+  uint32_t i;
+
+  if (PARALLEL != 1) {
+    return 0;
+  }
+  pTab = NORXSessCreate(SELFTEST_MSGS + 1);
+  if (pTab == NULL) {
+    return fail(pLog, "NORXSessCreate", kernel, 0);
+  }
+
+  //
+  // Ids in use at first, so the real sessions start on a partly used slab
+  //
+  for (i = 0; i < 3; i++) {
+    NORXSessStart(pTab, &keySched, nonce);
+  }
+  NORXSessTick(pTab);
+  NORXSessDrop(pTab, 0);
+  NORXSessDrop(pTab, 2);
+  NORXSessDrop(pTab, 1);
+
+  memcpy(N, nonce, NONCE_BYTES);
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    msgs[i].pA = head;
+    msgs[i].aLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    msgs[i].pIn = msgIn[i];
+    msgs[i].inLen = (i == 0) ? 4 * RATE_BYTES :
+                    nextRand() % (SELFTEST_MAX_BYTES + 1);
+    msgs[i].pZ = tail;
+    msgs[i].zLen = (i % 3 == 0) ? 0 : nextRand() % (SELFTEST_AD_BYTES + 1);
+    msgs[i].pOut = out[i];
+    N[0] = (uint8_t)i;
+    NORXKeyEnc(&keySched, N, msgs[i].pA, msgs[i].aLen, msgs[i].pIn,
+               msgs[i].inLen, msgs[i].pZ, msgs[i].zLen, refOut[i], refTag[i]);
+  }
+  bad += runSessions(pLog, kernel, pTab, msgs, false);
+
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    msgs[i].pIn = out[i];
+  }
+  bad += runSessions(pLog, kernel, pTab, msgs, true);
+
+  NORXSessDestroy(pTab);
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> checkMac
+// Purpose -> The MAC of every length must be the reference tag of a message
+//            with it as the header and nothing else, one shot, streamed in
+//            random pieces and batched, and a changed tag must be turned down
+//
+//*****************************************************************************
+static uint32_t
+checkMac(FILE* pLog, uint32_t kernel) {
+  norx_mac_msg_t msgs[SELFTEST_MSGS];
+  bool ok[SELFTEST_MSGS];
+  norx_mac_t ctx;
+  uint32_t bad = 0;
+  size_t off;
+  size_t take;
+  size_t len;
+  uint32_t i;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len++) {
+    refSeal(msgIn[0], len, NULL, 0, NULL, 0, NULL, refTag[0], false, 0);
+
+    NORXMac(&keySched, nonce, msgIn[0], len, tag[0]);
+    if (memcmp(tag[0], refTag[0], TAG_BYTES) != 0 ||
+        !NORXMacVerify(&keySched, nonce, msgIn[0], len, tag[0])) {
+      bad += fail(pLog, "MAC", kernel, len);
+    }
+
+    NORXMacInit(&ctx, &keySched, nonce);
+    for (off = 0; off < len; off += take) {
+      take = nextRand() % (len - off + 1);
+      NORXMacUpdate(&ctx, msgIn[0] + off, take);
+    }
+    if (!NORXMacFinal(&ctx, tag[1]) ||
+        memcmp(tag[1], refTag[0], TAG_BYTES) != 0 ||
+        NORXMacUpdate(&ctx, msgIn[0], 1)) {
+      bad += fail(pLog, "MAC stream", kernel, len);
+    }
+
+    tag[0][len % TAG_BYTES] ^= 0x01;
+    if (NORXMacVerify(&keySched, nonce, msgIn[0], len, tag[0])) {
+      bad += fail(pLog, "MAC forged tag", kernel, len);
+    }
+  }
+
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    msgs[i].pK = key;
+    msgs[i].pN = nonce;
+    msgs[i].pMsg = msgIn[i];
+    msgs[i].len = (i == 0) ? 0 : nextRand() % (SELFTEST_MAX_BYTES + 1);
+    msgs[i].pT = tag[i];
+    NORXMac(&keySched, nonce, msgIn[i], msgs[i].len, refTag[i]);
+  }
+  NORXMacBatch(msgs, SELFTEST_MSGS);
+  for (i = 0; i < SELFTEST_MSGS; i++) {
+    if (memcmp(tag[i], refTag[i], TAG_BYTES) != 0) {
+      bad += fail(pLog, "MAC batch", kernel, msgs[i].len);
+    }
+  }
+  tag[1][0] ^= 0x01;
+  if (NORXMacBatchCheck(msgs, SELFTEST_MSGS, ok) != SELFTEST_MSGS - 1 ||
+      ok[1] || !ok[0]) {
+    bad += fail(pLog, "MAC batch check", kernel, 0);
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> refDrbgSeed / refDrbgFill
+// Purpose -> Reference generator, a byte at a time on FScalar(), bulk runs
+//            squeezed through refPhase() with the lanes as payload lanes
+//
+//*****************************************************************************
+static void
+refDrbgSeed(word_t* pwS, const uint8_t* pSeed, size_t len) {
+  static const word_t U[8] = { U8, U9, U10, U11, U12, U13, U14, U15 };
+  uint32_t i;
+
+  for (i = 0; i < 8; i++) {
+    pwS[i] = 0;
+    pwS[i + 8] = U[i];
+  }
+  pwS[12] ^= WORD_LEN;
+  pwS[13] ^= RND_NUM;
+  pwS[15] ^= TAG_LEN;
+  FScalar(pwS);
+  refPhase(pwS, 1, pSeed, len, DRBG_SEED_DOMAIN, NULL, false);
+}
+
+static void
+refDrbgFill(word_t* pwS, uint32_t* pPos, uint8_t* pOut, size_t len) {
+  static word_t lanes[16 * BATCH_LANES];
+  size_t blocks;
+  uint32_t lane;
+  uint32_t i;
+
+  while (len > 0) {
+    if (*pPos == RATE_BYTES) {
+      blocks = len / RATE_BYTES;
+      if (blocks >= DRBG_BULK_BLOCKS) {
+        for (lane = 0; lane < BATCH_LANES; lane++) {
+          memcpy(lanes + 16 * lane, pwS, 16 * sizeof(word_t));
+          for (i = 0; i < RATE_WORDS; i++) {
+            lanes[16 * lane + i] ^= lane + 1;
+          }
+        }
+        memset(pOut, 0, blocks * RATE_BYTES);
+        refPhase(lanes, BATCH_LANES, pOut, blocks * RATE_BYTES,
+                 DRBG_BULK_DOMAIN, pOut, false);
+        pOut += blocks * RATE_BYTES;
+        len -= blocks * RATE_BYTES;
+        pwS[15] ^= DRBG_OUT_DOMAIN;
+        FScalar(pwS);
+        continue;
+      }
+      pwS[15] ^= DRBG_OUT_DOMAIN;
+      FScalar(pwS);
+      *pPos = 0;
+    }
+    *pOut++ = (uint8_t)(pwS[*pPos / WORD_BYTES] >> (8 * (*pPos % WORD_BYTES)));
+    (*pPos)++;
+    len--;
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> checkDrbg
+// Purpose -> The generator must give what the reference gives over fills
+//            of random length, bulk runs and reseeds among them
+//
+//*****************************************************************************
+static uint32_t
+checkDrbg(FILE* pLog, uint32_t kernel) {
+  norx_drbg_t gen;
+  word_t S[16];
+  uint32_t pos = RATE_BYTES;
+  uint32_t bad = 0;
+  size_t len;
+  uint32_t i;
+
+  NORXDrbgSeed(&gen, head, sizeof(head));
+  refDrbgSeed(S, head, sizeof(head));
+
+  for (i = 0; i < 40; i++) {
+    if (i % 10 == 9) {
+      NORXDrbgReseed(&gen, tail, i);
+      refPhase(S, 1, tail, i, DRBG_SEED_DOMAIN, NULL, false);
+      pos = RATE_BYTES;
+    }
+    len = (i % 3 == 0) ? nextRand() % sizeof(out) :
+                         nextRand() % (3 * RATE_BYTES);
+    NORXDrbgFill(&gen, &out[0][0], len);
+    refDrbgFill(S, &pos, &refOut[0][0], len);
+    if (memcmp(&out[0][0], &refOut[0][0], len) != 0) {
+      bad += fail(pLog, "DRBG", kernel, len);
+    }
+  }
+  NORXDrbgWipe(&gen);
+
+  if (NORXDrbgLocal() == NULL || NORXDrbgLocal() != NORXDrbgLocal()) {
+    bad += fail(pLog, "NORXDrbgLocal", kernel, 0);
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> ckptHop
+// Purpose -> Save the stream, spoil the context and restore it, as if the
+//            stream moved to another process
+// Returns -> false if the restore turned the checkpoint down
+//
+//*****************************************************************************
+static bool
+ckptHop(norx_stream_t* pCtx) {
+  static uint8_t ckpt[STREAM_CKPT_BYTES];
+  size_t len = NORXStreamSave(pCtx, ckpt);
+
+  memset(pCtx, 0xa5, sizeof(*pCtx));
+  return len > 0 && NORXStreamRestore(pCtx, &keySched, ckpt, len);
+}
+
+//*****************************************************************************
+//
+// Function -> checkCkpt
+// Purpose -> A stream saved and restored at random points between pieces
+//            must seal what NORXKeyEnc() does, and damaged or short
+//            checkpoints must be turned down
+//
+//*****************************************************************************
+static uint32_t
+checkCkpt(FILE* pLog, uint32_t kernel) {
+  uint8_t ckpt[STREAM_CKPT_BYTES];
+  norx_stream_t ctx;
+  const uint8_t* pIn;
+  size_t lens[3];
+  size_t done;
+  size_t take;
+  size_t n;
+  uint32_t bad = 0;
+  uint32_t phase;
+  size_t len;
+  bool ok;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len++) {
+    lens[0] = nextRand() % (SELFTEST_AD_BYTES + 1);
+    lens[1] = len;
+    lens[2] = nextRand() % (SELFTEST_AD_BYTES + 1);
+    NORXKeyEnc(&keySched, nonce, head, lens[0], msgIn[0], len, tail, lens[2],
+               refOut[0], refTag[0]);
+
+    NORXStreamInitKey(&ctx, &keySched, nonce);
+    ok = ckptHop(&ctx);
+    for (phase = 0; phase < 3; phase++) {
+      pIn = (phase == 0) ? head : (phase == 1) ? msgIn[0] : tail;
+      for (done = 0; done < lens[phase]; done += take) {
+        take = nextRand() % (2 * RATE_BYTES + 1);
+        take = (take < lens[phase] - done) ? take : lens[phase] - done;
+        if (phase == 0) {
+          NORXStreamHeader(&ctx, pIn + done, take);
+        }
+        else if (phase == 1) {
+          NORXStreamEncrypt(&ctx, pIn + done, take, out[0] + done);
+        }
+        else {
+          NORXStreamTrailer(&ctx, pIn + done, take);
+        }
+        if (nextRand() % 2 == 0) {
+          ok &= ckptHop(&ctx);
+        }
+      }
+    }
+    ok &= ckptHop(&ctx);
+    NORXStreamFinal(&ctx, tag[0]);
+    if (!ok || memcmp(out[0], refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "checkpoint", kernel, len);
+    }
+  }
+
+  //
+  // Cut short, another build or a stream that is done
+  //
+  NORXStreamInitKey(&ctx, &keySched, nonce);
+  NORXStreamEncrypt(&ctx, msgIn[0], RATE_BYTES + 1, out[0]);
+  n = NORXStreamSave(&ctx, ckpt);
+  if (NORXStreamRestore(&ctx, &keySched, ckpt, n - 1)) {
+    bad += fail(pLog, "short checkpoint", kernel, n - 1);
+  }
+  ckpt[10] ^= 0x01;
+  if (NORXStreamRestore(&ctx, &keySched, ckpt, n)) {
+    bad += fail(pLog, "foreign checkpoint", kernel, n);
+  }
+  NORXStreamFinal(&ctx, tag[0]);
+  if (NORXStreamSave(&ctx, ckpt) != 0) {
+    bad += fail(pLog, "checkpoint after final", kernel, 0);
+  }
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> checkNt
+// Purpose -> With the non temporal threshold at or just past the payload
+//            size, seal to an odd address must match refSeal() and both
+//            opens must give the message back
+//
+//*****************************************************************************
+static uint32_t
+checkNt(FILE* pLog, uint32_t kernel) {
+  size_t old = NORXNtBytes();
+  uint8_t* pC = sealed + 1;
+  uint32_t bad = 0;
+  size_t aLen;
+  size_t zLen;
+  size_t len;
+
+  for (len = 0; len <= SELFTEST_MAX_BYTES; len++) {
+    aLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    zLen = nextRand() % (SELFTEST_AD_BYTES + 1);
+    NORXSetNtBytes(1 + nextRand() % (len + 1));
+    refSeal(head, aLen, msgIn[0], len, tail, zLen, refOut[0], refTag[0],
+            false, 0);
+
+    NORXKeyEnc(&keySched, nonce, head, aLen, msgIn[0], len, tail, zLen, pC,
+               tag[0]);
+    if (memcmp(pC, refOut[0], len) != 0 ||
+        memcmp(tag[0], refTag[0], TAG_BYTES) != 0) {
+      bad += fail(pLog, "non temporal seal", kernel, len);
+    }
+    if (!NORXKeyDecVerify(&keySched, nonce, head, aLen, pC, len, tail, zLen,
+                          tag[0], out[1]) ||
+        memcmp(out[1], msgIn[0], len) != 0) {
+      bad += fail(pLog, "non temporal verify first open", kernel, len);
+    }
+    if (!NORXKeyDec(&keySched, nonce, head, aLen, pC, len, tail, zLen,
+                    tag[0], pC) ||
+        memcmp(pC, msgIn[0], len) != 0) {
+      bad += fail(pLog, "non temporal open", kernel, len);
+    }
+  }
+  NORXSetNtBytes(old);
+
+  return bad;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSelfTest
+// Purpose -> Run every check on every kernel this CPU supports
+// Inputs -> FILE* pLog - Where to report failures, NULL for none
+// Returns -> Number of failed checks
+//
+//*****************************************************************************
+uint32_t
+NORXSelfTest(FILE* pLog) {
+  const variant_t* pVar;
+  variant_t core;
+  char name[32];
+  uint32_t startKernel = NORXKernel();
+  uint32_t bad = 0;
+  uint32_t kernel;
+  uint32_t i;
+
+  seed = 0x9e3779b97f4a7c15u;
+  fillRand(&msgIn[0][0], sizeof(msgIn));
+  fillRand(head, sizeof(head));
+  fillRand(tail, sizeof(tail));
+  fillRand(key, sizeof(key));
+  fillRand(nonce, sizeof(nonce));
+  NORXKeyInit(&keySched, key);
+  pPool = NORXPoolCreate(SELFTEST_POOL_THREADS, SELFTEST_POOL_LANE);
+  if (pPool == NULL) {
+    bad += fail(pLog, "NORXPoolCreate", KERNEL_SCALAR, 0);
+  }
+
+  snprintf(name, sizeof(name), "NORX%u-%u-%u",
+           (unsigned)WORD_LEN, (unsigned)RND_NUM, (unsigned)PARALLEL);
+  pVar = NORXFindVariant(name);
+  core.name = name;
+  core.wordLen = WORD_LEN;
+  core.rounds = RND_NUM;
+  core.parallel = PARALLEL;
+  core.keyBytes = KEY_BYTES;
+  core.pfnEnc = NORXEnc;
+  core.pfnDec = NORXDec;
+
+  bad += checkConstants(pLog);
+
+  //
+  // The engine variants are checked against the known answers, and the core
+  // build too when it is one of them
+  //
+  for (i = 0; i < NORXVariantCount; i++) {
+    bad += checkKat(pLog, KERNEL_SCALAR, &NORXVariants[i]);
+  }
+
+  for (kernel = 0; kernel < KERNEL_COUNT; kernel++) {
+    if (!NORXSetKernel(kernel)) {
+      continue;
+    }
+    bad += checkPermutations(pLog, kernel);
+    bad += checkAead(pLog, kernel, pVar);
+    if (pVar != NULL) {
+      bad += checkKat(pLog, kernel, &core);
+    }
+    bad += checkSegments(pLog, kernel);
+    bad += checkSess(pLog, kernel);
+    bad += checkMac(pLog, kernel);
+    bad += checkDrbg(pLog, kernel);
+    bad += checkNt(pLog, kernel);
+  }
+  NORXSetKernel(startKernel);
+
+  //
+  // These only add I/O, queues, fragment lists or checkpoints around the
+  // stream and batch APIs, once is enough
+  //
+  bad += checkUring(pLog, startKernel);
+  bad += checkPipe(pLog, startKernel);
+  bad += checkStats(pLog, startKernel);
+  bad += checkIov(pLog, startKernel);
+  bad += checkCkpt(pLog, startKernel);
+  NORXKeyWipe(&keySched);
+  NORXPoolDestroy(pPool);
+  pPool = NULL;
+
+  return bad;
+}
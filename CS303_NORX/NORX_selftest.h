@@ -0,0 +1,31 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_selftest.h                                                     *
+* Purpose -> Known answer and differential checks of every optimised path     *
+*            against the scalar reference                                     *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Self Test Gate for the Fast Paths               *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_SELFTEST_H
+#define NORX_SELFTEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Longest payload the AEAD checks try, every length from 0 up to it is run
+//*****************************************************************************
+#define SELFTEST_MAX_BYTES   (4 * PARALLEL * RATE_BYTES + 3)
+
+//*****************************************************************************
+// Self Test Prototype. Returns the number of failed checks, 0 means every
+// path matches. Each failure gets a line on pLog unless it is NULL. The
+// kernel picked at startup is put back before it returns.
+//*****************************************************************************
+extern uint32_t NORXSelfTest(FILE* pLog);
+
+#endif // NORX_SELFTEST_H
@@ -0,0 +1,852 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_sess.c                                                         *
+* Purpose -> Session table, many long lived streams stepped together          *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - SoA Session Table with Batched Ticks            *
+*            2.0 10/17/2026 - Free List Described as the Stack It Is          *
+*            3.0 10/17/2026 - NORX_STATS Counts for Bytes, Opens and Tags     *
+*            4.0 10/17/2026 - Tag Checked by tagMatch(), Batch Wiped          *
+*                                                                             *
+* Sessions live in slabs of BATCH_LANES. A slab keeps the states in the       *
+* batch layout, word i of session j at [i * BATCH_LANES + j], and the key     *
+* words the same way, so a slab is one batch F kernel operand as it sits in   *
+* memory. Like the stream API the open rate block lives in the state itself:  *
+* its F has already run, bytes XOR straight into the rate and pos counts      *
+* how much of it is used. A session is its 16 state words, 4 key words and    *
+* 4 bytes of bookkeeping, plus its entries in the free and pending lists.     *
+*                                                                             *
+* Unlike the stream API the next block is opened as soon as one fills. If     *
+* the phase ends there instead, that F is the one its empty padded block      *
+* needs anyway, so a phase that took bytes always has an open block to pad    *
+* and a session fed a block per tick needs one F per tick.                    *
+*                                                                             *
+* Calls never run F. A session that needs one, to finish initialise, open a   *
+* block or finalise, XORs in the domain, goes on the pending list and waits.  *
+* A tick runs them all. A slab where every live session waits and at least    *
+* half the lanes are in use is permuted in place. The rest are gathered a     *
+* batch at a time from whatever slabs they are in, permuted and scattered     *
+* back. Then each session does whatever it was waiting to do after its F.     *
+*                                                                             *
+* With P > 1 a session would need P lane states, there is no table then.      *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <stdlib.h>    // aligned_alloc, calloc, free
+#include <string.h>    // memset
+
+#include "NORX.h"       // NORX defines and prototypes
+#include "NORX_stats.h" // Domain counters
+#include "NORX_simd.h"  // Batch kernel and BATCH_LANES
+#include "NORX_sess.h"  // Prototypes
+
+#if PARALLEL == 1
+
+//*****************************************************************************
+// Phases a session moves through, only ever forwards
+//*****************************************************************************
+#define SESS_HEADER    0
+#define SESS_PAYLOAD   1
+#define SESS_TRAILER   2
+#define SESS_FINAL     3   // Tag being made
+#define SESS_DONE      4   // Tag ready
+
+//*****************************************************************************
+// What a session does once its F has run
+//*****************************************************************************
+#define AFTER_INIT     0   // Key into words 12 - 15
+#define AFTER_OPEN     1   // Block open, pos = 0
+#define AFTER_FINAL    2   // Key in, second F of finalise
+#define AFTER_TAG      3   // Key in, tag ready
+
+//*****************************************************************************
+// Session flags
+//*****************************************************************************
+#define FLAG_LIVE      0x01
+#define FLAG_PEND      0x02   // On the pending list
+#define FLAG_CLOSE     0x04   // NORXSessFinal() called
+#define FLAG_HAD(p)    (0x08 << (p))   // Phase p took bytes
+
+//*****************************************************************************
+// How rateBytes() treats the bytes
+//*****************************************************************************
+#define MODE_ABSORB    0
+#define MODE_ENCRYPT   1
+#define MODE_DECRYPT   2
+
+//*****************************************************************************
+// Word i of session j of a slab
+//*****************************************************************************
+#define SLAB_WORD(pSl, i, j)  ((pSl)->S[(i) * BATCH_LANES + (j)])
+#define SLAB_KEY(pSl, i, j)   ((pSl)->K[(i) * BATCH_LANES + (j)])
+
+//*****************************************************************************
+// BATCH_LANES sessions
+//*****************************************************************************
+typedef struct {
+  word_t S[BATCH_WORDS];          // States, batch layout
+  word_t K[4 * BATCH_LANES];      // Key words, batch layout
+  uint8_t pos[BATCH_LANES];       // Bytes of the open block used
+  uint8_t phase[BATCH_LANES];     // SESS_xxx
+  uint8_t after[BATCH_LANES];     // AFTER_xxx while pending
+  uint8_t flags[BATCH_LANES];     // FLAG_xxx
+  uint32_t live;                  // Sessions in use
+  uint32_t pending;               // Sessions waiting for a tick
+  uint64_t tick;                  // Last tick that ran the slab in place
+} NORX_ALIGN slab_t;
+
+struct norx_sess_s {
+  word_t B[BATCH_WORDS];          // Gathered batch
+  slab_t** ppSlabs;               // Allocated on first use
+  uint32_t* pFree;                // Free ids, a stack, last freed on top
+  uint32_t* pPend;                // Ids waiting for a tick
+  uint32_t slabs;
+  uint32_t freeCount;
+  uint32_t pendCount;
+  uint64_t tick;
+} NORX_ALIGN;
+
+//*****************************************************************************
+// Domain of each phase that takes bytes
+//*****************************************************************************
+static const uint32_t phaseDomain[3] = {
+  HEADER_DOMAIN, PAYLOAD_DOMAIN, TRAILER_DOMAIN
+};
+
+//*****************************************************************************
+//
+// Function -> find
+// Purpose -> Slab and lane of a live session
+// Returns -> The slab, NULL if id is not a live session
+//
+//*****************************************************************************
+static slab_t*
+find(const norx_sess_t* pTab, uint32_t id, uint32_t* pJ) {
+  slab_t* pSl;
+
+  if (id / BATCH_LANES >= pTab->slabs) {
+    return NULL;
+  }
+  pSl = pTab->ppSlabs[id / BATCH_LANES];
+  *pJ = id % BATCH_LANES;
+  if (pSl == NULL || !(pSl->flags[*pJ] & FLAG_LIVE)) {
+    return NULL;
+  }
+  return pSl;
+}
+
+//*****************************************************************************
+//
+// Function -> need
+// Purpose -> Put a session on the pending list, its domain already XORed in
+//
+//*****************************************************************************
+static void
+need(norx_sess_t* pTab, slab_t* pSl, uint32_t j, uint32_t id, uint8_t after) {
+  pSl->after[j] = after;
+  pSl->flags[j] |= FLAG_PEND;
+  pSl->pending++;
+  pTab->pPend[pTab->pendCount++] = id;
+}
+
+//*****************************************************************************
+//
+// Function -> padAt
+// Purpose -> pad() on the strided rate of session j
+//
+//*****************************************************************************
+static void
+padAt(slab_t* pSl, uint32_t j, uint32_t pos) {
+  SLAB_WORD(pSl, pos / WORD_BYTES, j) ^=
+    (word_t)0x01 << (8 * (pos % WORD_BYTES));
+  SLAB_WORD(pSl, RATE_WORDS - 1, j) ^= (word_t)0x80 << (WORD_LEN - 8);
+}
+
+//*****************************************************************************
+//
+// Function -> keyIn
+// Purpose -> XOR the key into words 12 - 15, as initialise() and finalise()
+//            do after F
+//
+//*****************************************************************************
+static void
+keyIn(slab_t* pSl, uint32_t j) {
+  uint32_t i;
+
+  for (i = 0; i < 4; i++) {
+    SLAB_WORD(pSl, 12 + i, j) ^= SLAB_KEY(pSl, i, j);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> enterPhase
+// Purpose -> Close every phase before the one asked for, padding the open
+//            block of each that took bytes
+// Returns -> false while the session waits for a tick, it may not close a
+//            phase before the F of its open block has run
+//
+//*****************************************************************************
+static bool
+enterPhase(slab_t* pSl, uint32_t j, uint32_t phase) {
+  uint32_t p;
+
+  if (pSl->flags[j] & FLAG_PEND) {
+    return false;
+  }
+  while (pSl->phase[j] < phase) {
+    p = pSl->phase[j];
+    if (p <= SESS_TRAILER && (pSl->flags[j] & FLAG_HAD(p))) {
+      padAt(pSl, j, pSl->pos[j]);
+    }
+    pSl->pos[j] = RATE_BYTES;
+    pSl->phase[j]++;
+  }
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> rateBytes
+// Purpose -> Take bytes into the open block of session j, a word at a time
+//            where the block position allows
+// Returns -> Bytes taken, up to the end of the block
+//
+//*****************************************************************************
+static size_t
+rateBytes(slab_t* pSl, uint32_t j, const uint8_t* pIn, size_t len,
+          uint8_t* pOut, uint32_t mode) {
+  uint32_t pos = pSl->pos[j];
+  uint32_t shift;
+  size_t n = 0;
+  word_t* pW;
+  word_t w;
+  uint8_t b;
+
+  while (n < len && pos < RATE_BYTES) {
+    pW = &SLAB_WORD(pSl, pos / WORD_BYTES, j);
+    if (pos % WORD_BYTES == 0 && len - n >= WORD_BYTES) {
+      w = loadWord(pIn + n);
+      if (mode == MODE_DECRYPT) {
+        storeWord(pOut + n, *pW ^ w);
+        *pW = w;
+      }
+      else {
+        *pW ^= w;
+        if (mode == MODE_ENCRYPT) {
+          storeWord(pOut + n, *pW);
+        }
+      }
+      pos += WORD_BYTES;
+      n += WORD_BYTES;
+    }
+    else {
+      shift = 8 * (pos % WORD_BYTES);
+      b = pIn[n];
+      if (mode == MODE_DECRYPT) {
+        b ^= (uint8_t)(*pW >> shift);
+        *pW ^= (word_t)b << shift;
+        pOut[n] = b;
+      }
+      else {
+        *pW ^= (word_t)b << shift;
+        if (mode == MODE_ENCRYPT) {
+          pOut[n] = (uint8_t)(*pW >> shift);
+        }
+      }
+      pos++;
+      n++;
+    }
+  }
+
+  pSl->pos[j] = (uint8_t)pos;
+  return n;
+}
+
+//*****************************************************************************
+//
+// Function -> feed
+// Purpose -> Take bytes of a phase, asking for the F of the next block when
+//            there is no open block or it is full
+// Returns -> false if the session is not live, closing or past the phase
+//
+//*****************************************************************************
+static bool
+feed(norx_sess_t* pTab, uint32_t id, uint32_t phase, const uint8_t* pIn,
+     size_t len, uint8_t* pOut, uint32_t mode, size_t* pTaken) {
+  slab_t* pSl;
+  uint32_t j;
+
+  *pTaken = 0;
+  pSl = find(pTab, id, &j);
+  if (pSl == NULL || (pSl->flags[j] & FLAG_CLOSE) || pSl->phase[j] > phase) {
+    return false;
+  }
+  if (len == 0 || !enterPhase(pSl, j, phase)) {
+    return true;
+  }
+
+  pSl->flags[j] |= FLAG_HAD(phase);
+  *pTaken = rateBytes(pSl, j, pIn, len, pOut, mode);
+  STATS_DOMAIN(phaseDomain[phase], 0, 0, *pTaken);
+  if (pSl->pos[j] == RATE_BYTES) {
+    STATS_DOMAIN(phaseDomain[phase], 1, 1, 0);
+    SLAB_WORD(pSl, 15, j) ^= phaseDomain[phase];
+    need(pTab, pSl, j, id, AFTER_OPEN);
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> closeSession
+// Purpose -> Move a session that NORXSessFinal() was called on towards its
+//            tag as far as it can go without a tick
+//
+//*****************************************************************************
+static void
+closeSession(norx_sess_t* pTab, slab_t* pSl, uint32_t j, uint32_t id) {
+  if (enterPhase(pSl, j, SESS_FINAL)) {
+    pSl->flags[j] &= (uint8_t)~FLAG_CLOSE;
+    STATS_DOMAIN(FINAL_DOMAIN, 2, 0, TAG_BYTES);
+    SLAB_WORD(pSl, 15, j) ^= FINAL_DOMAIN;
+    need(pTab, pSl, j, id, AFTER_FINAL);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> freeSession
+// Purpose -> Wipe a session and push its id on the free stack. The next
+//            start takes it again, so a slab that was just in use, and is
+//            still in cache, fills up first. Ids only come lowest first
+//            until the first one is freed
+//
+//*****************************************************************************
+static void
+freeSession(norx_sess_t* pTab, slab_t* pSl, uint32_t j, uint32_t id) {
+  uint32_t i;
+
+  for (i = 0; i < 16; i++) {
+    SLAB_WORD(pSl, i, j) = 0;
+  }
+  for (i = 0; i < 4; i++) {
+    SLAB_KEY(pSl, i, j) = 0;
+  }
+  pSl->flags[j] = 0;
+  pSl->live--;
+  pTab->pFree[pTab->freeCount++] = id;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessCreate
+// Purpose -> Set up an empty table, slabs are allocated as ids reach them
+// Inputs -> uint32_t maxSessions - Most sessions at once
+// Returns -> The table, NULL if it could not be allocated
+//
+//*****************************************************************************
+norx_sess_t*
+NORXSessCreate(uint32_t maxSessions) {
+  norx_sess_t* pTab;
+  uint32_t i;
+
+  if (maxSessions == 0 || maxSessions > UINT32_MAX - BATCH_LANES) {
+    return NULL;
+  }
+
+  pTab = (norx_sess_t*)aligned_alloc(64, sizeof(*pTab));
+  if (pTab == NULL) {
+    return NULL;
+  }
+  memset(pTab, 0, sizeof(*pTab));
+  pTab->slabs = (maxSessions + BATCH_LANES - 1) / BATCH_LANES;
+  pTab->ppSlabs = (slab_t**)calloc(pTab->slabs, sizeof(slab_t*));
+  pTab->pFree = (uint32_t*)malloc((size_t)maxSessions * sizeof(uint32_t));
+  pTab->pPend = (uint32_t*)malloc((size_t)maxSessions * sizeof(uint32_t));
+  if (pTab->ppSlabs == NULL || pTab->pFree == NULL || pTab->pPend == NULL) {
+    NORXSessDestroy(pTab);
+    return NULL;
+  }
+
+  for (i = 0; i < maxSessions; i++) {
+    pTab->pFree[i] = maxSessions - 1 - i;
+  }
+  pTab->freeCount = maxSessions;
+
+  return pTab;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessDestroy
+// Purpose -> Wipe and free a table and every session still in it
+//
+//*****************************************************************************
+void
+NORXSessDestroy(norx_sess_t* pTab) {
+  uint32_t i;
+
+  if (pTab == NULL) {
+    return;
+  }
+  if (pTab->ppSlabs != NULL) {
+    for (i = 0; i < pTab->slabs; i++) {
+      if (pTab->ppSlabs[i] != NULL) {
+        wipe(pTab->ppSlabs[i], sizeof(slab_t));
+        free(pTab->ppSlabs[i]);
+      }
+    }
+  }
+  free(pTab->ppSlabs);
+  free(pTab->pFree);
+  free(pTab->pPend);
+  wipe(pTab, sizeof(*pTab));
+  free(pTab);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessStart
+// Purpose -> Start a session, initialise()'s F runs on the next tick
+// Inputs -> norx_sess_t* pTab - Table
+//           const norx_key_t* pKey - Key schedule from NORXKeyInit()
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+// Returns -> Session id, SESS_NONE if the table is full
+//
+//*****************************************************************************
+uint32_t
+NORXSessStart(norx_sess_t* pTab, const norx_key_t* pKey, const uint8_t* pN) {
+  slab_t* pSl;
+  uint32_t id;
+  uint32_t j;
+  uint32_t i;
+
+  if (pTab->freeCount == 0) {
+    return SESS_NONE;
+  }
+  id = pTab->pFree[pTab->freeCount - 1];
+  j = id % BATCH_LANES;
+
+  pSl = pTab->ppSlabs[id / BATCH_LANES];
+  if (pSl == NULL) {
+    pSl = (slab_t*)aligned_alloc(64, sizeof(slab_t));
+    if (pSl == NULL) {
+      return SESS_NONE;
+    }
+    memset(pSl, 0, sizeof(*pSl));
+    pTab->ppSlabs[id / BATCH_LANES] = pSl;
+  }
+  pTab->freeCount--;
+
+  for (i = 0; i < 4; i++) {
+    SLAB_WORD(pSl, i, j) = loadWord(pN + i * WORD_BYTES);
+    SLAB_KEY(pSl, i, j) = pKey->K[i];
+  }
+  for (i = 0; i < 12; i++) {
+    SLAB_WORD(pSl, 4 + i, j) = pKey->S[i];
+  }
+  pSl->pos[j] = RATE_BYTES;
+  pSl->phase[j] = SESS_HEADER;
+  pSl->flags[j] = FLAG_LIVE;
+  pSl->live++;
+  need(pTab, pSl, j, id, AFTER_INIT);
+
+  return id;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessHeader / NORXSessEncrypt / NORXSessDecrypt /
+//             NORXSessTrailer
+// Purpose -> Feed bytes of a phase, moving to it first if need be
+// Inputs -> norx_sess_t* pTab - Table
+//           uint32_t id - Session
+//           pIn, len - Phase bytes
+//           pOut - Cipher or plain text for the payload, may be pIn
+//           size_t* pTaken - Bytes taken, fewer than len while the session
+//                            waits for a tick
+// Returns -> false if the session is not live, closed or past the phase
+//
+//*****************************************************************************
+bool
+NORXSessHeader(norx_sess_t* pTab, uint32_t id, const uint8_t* pA, size_t len,
+               size_t* pTaken) {
+  return feed(pTab, id, SESS_HEADER, pA, len, NULL, MODE_ABSORB, pTaken);
+}
+
+bool
+NORXSessEncrypt(norx_sess_t* pTab, uint32_t id, const uint8_t* pM, size_t len,
+                uint8_t* pC, size_t* pTaken) {
+  return feed(pTab, id, SESS_PAYLOAD, pM, len, pC, MODE_ENCRYPT, pTaken);
+}
+
+bool
+NORXSessDecrypt(norx_sess_t* pTab, uint32_t id, const uint8_t* pC, size_t len,
+                uint8_t* pM, size_t* pTaken) {
+  return feed(pTab, id, SESS_PAYLOAD, pC, len, pM, MODE_DECRYPT, pTaken);
+}
+
+bool
+NORXSessTrailer(norx_sess_t* pTab, uint32_t id, const uint8_t* pZ, size_t len,
+                size_t* pTaken) {
+  return feed(pTab, id, SESS_TRAILER, pZ, len, NULL, MODE_ABSORB, pTaken);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessFinal
+// Purpose -> Close a session, the padding and finalise F calls run on the
+//            ticks that follow
+// Returns -> false if the session is not live or was closed already
+//
+//*****************************************************************************
+bool
+NORXSessFinal(norx_sess_t* pTab, uint32_t id) {
+  slab_t* pSl;
+  uint32_t j;
+
+  pSl = find(pTab, id, &j);
+  if (pSl == NULL || (pSl->flags[j] & FLAG_CLOSE) ||
+      pSl->phase[j] >= SESS_FINAL) {
+    return false;
+  }
+  pSl->flags[j] |= FLAG_CLOSE;
+  if (!(pSl->flags[j] & FLAG_PEND)) {
+    closeSession(pTab, pSl, j, id);
+  }
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessTag
+// Purpose -> Hand out the tag of a finished session and free it
+// Inputs -> norx_sess_t* pTab - Table
+//           uint32_t id - Session
+//           uint8_t* pT - Tag, TAG_BYTES
+// Returns -> false if the tag is not ready
+//
+//*****************************************************************************
+bool
+NORXSessTag(norx_sess_t* pTab, uint32_t id, uint8_t* pT) {
+  slab_t* pSl;
+  uint32_t j;
+  uint32_t i;
+
+  pSl = find(pTab, id, &j);
+  if (pSl == NULL || pSl->phase[j] != SESS_DONE ||
+      (pSl->flags[j] & FLAG_PEND)) {
+    return false;
+  }
+  for (i = 0; i < TAG_WORDS; i++) {
+    storeWord(pT + i * WORD_BYTES, SLAB_WORD(pSl, 16 - TAG_WORDS + i, j));
+  }
+  freeSession(pTab, pSl, j, id);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessTagCheck
+// Purpose -> Check the tag of a finished session against a received one
+//            with tagMatch() and free the session. The computed tag is not
+//            handed out, its words are wiped with the session.
+// Inputs -> norx_sess_t* pTab - Table
+//           uint32_t id - Session
+//           const uint8_t* pT - Received tag, TAG_BYTES
+//           bool* pOk - Whether the tags match
+// Returns -> false if the tag is not ready, *pOk is not set then
+//
+//*****************************************************************************
+bool
+NORXSessTagCheck(norx_sess_t* pTab, uint32_t id, const uint8_t* pT,
+                 bool* pOk) {
+  word_t tag[TAG_WORDS];
+  slab_t* pSl;
+  uint32_t j;
+  uint32_t i;
+
+  pSl = find(pTab, id, &j);
+  if (pSl == NULL || pSl->phase[j] != SESS_DONE ||
+      (pSl->flags[j] & FLAG_PEND)) {
+    return false;
+  }
+  for (i = 0; i < TAG_WORDS; i++) {
+    tag[i] = SLAB_WORD(pSl, 16 - TAG_WORDS + i, j);
+  }
+  *pOk = tagMatch(tag, pT);
+  wipe(tag, sizeof(tag));
+  freeSession(pTab, pSl, j, id);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessDrop
+// Purpose -> Free a session whatever state it is in. One waiting for a tick
+//            is freed by the tick.
+//
+//*****************************************************************************
+void
+NORXSessDrop(norx_sess_t* pTab, uint32_t id) {
+  slab_t* pSl;
+  uint32_t j;
+
+  pSl = find(pTab, id, &j);
+  if (pSl == NULL) {
+    return;
+  }
+  if (pSl->flags[j] & FLAG_PEND) {
+    pSl->flags[j] |= FLAG_CLOSE;
+    pSl->phase[j] = SESS_DONE;
+    return;
+  }
+  freeSession(pTab, pSl, j, id);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessBusy
+// Purpose -> Whether a session waits for a tick
+//
+//*****************************************************************************
+bool
+NORXSessBusy(const norx_sess_t* pTab, uint32_t id) {
+  const slab_t* pSl;
+  uint32_t j;
+
+  pSl = find(pTab, id, &j);
+  return pSl != NULL && (pSl->flags[j] & FLAG_PEND);
+}
+
+//*****************************************************************************
+//
+// Function -> gatherRun
+// Purpose -> Permute the first lanes sessions gathered into the batch and
+//            scatter them back to their slabs. The batch is wiped after, so
+//            no state outlives the tick in it.
+//
+//*****************************************************************************
+static void
+gatherRun(norx_sess_t* pTab, const uint32_t* pIds, uint32_t lanes) {
+  slab_t* pSl;
+  uint32_t j;
+  uint32_t k;
+  uint32_t i;
+
+  pfnPermuteBatch(pTab->B);
+  for (k = 0; k < lanes; k++) {
+    pSl = pTab->ppSlabs[pIds[k] / BATCH_LANES];
+    j = pIds[k] % BATCH_LANES;
+    for (i = 0; i < 16; i++) {
+      SLAB_WORD(pSl, i, j) = pTab->B[i * BATCH_LANES + k];
+    }
+  }
+  wipe(pTab->B, sizeof(pTab->B));
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSessTick
+// Purpose -> Run the F of every waiting session, then let each carry on.
+//            Those that need another F, the second one of finalise, wait for
+//            the next tick.
+// Inputs -> norx_sess_t* pTab - Table
+// Returns -> Number of F calls run
+//
+//*****************************************************************************
+size_t
+NORXSessTick(norx_sess_t* pTab) {
+  uint32_t ids[BATCH_LANES];
+  uint32_t count = pTab->pendCount;
+  uint32_t lanes = 0;
+  uint32_t id;
+  uint32_t r;
+  uint32_t j;
+  uint32_t i;
+  slab_t* pSl;
+
+  pTab->tick++;
+
+  //
+  // Whole slabs in place, the rest gathered
+  //
+  for (r = 0; r < count; r++) {
+    id = pTab->pPend[r];
+    pSl = pTab->ppSlabs[id / BATCH_LANES];
+    if (pSl->tick == pTab->tick) {
+      continue;
+    }
+    if (pSl->pending == pSl->live && 2 * pSl->pending >= BATCH_LANES) {
+      pfnPermuteBatch(pSl->S);
+      pSl->tick = pTab->tick;
+      continue;
+    }
+
+    j = id % BATCH_LANES;
+    for (i = 0; i < 16; i++) {
+      pTab->B[i * BATCH_LANES + lanes] = SLAB_WORD(pSl, i, j);
+    }
+    ids[lanes++] = id;
+    if (lanes == BATCH_LANES) {
+      gatherRun(pTab, ids, lanes);
+      lanes = 0;
+    }
+  }
+  if (lanes > 0) {
+    gatherRun(pTab, ids, lanes);
+  }
+
+  //
+  // Each session carries on. need() puts those that wait again back on the
+  // list, never past the entry being read.
+  //
+  pTab->pendCount = 0;
+  for (r = 0; r < count; r++) {
+    id = pTab->pPend[r];
+    pSl = pTab->ppSlabs[id / BATCH_LANES];
+    j = id % BATCH_LANES;
+    pSl->flags[j] &= (uint8_t)~FLAG_PEND;
+    pSl->pending--;
+
+    if (pSl->phase[j] == SESS_DONE) {
+      freeSession(pTab, pSl, j, id);    // Dropped while pending
+      continue;
+    }
+
+    switch (pSl->after[j]) {
+      case AFTER_INIT:
+        keyIn(pSl, j);
+        break;
+      case AFTER_OPEN:
+        pSl->pos[j] = 0;
+        break;
+      case AFTER_FINAL:
+        keyIn(pSl, j);
+        need(pTab, pSl, j, id, AFTER_TAG);
+        break;
+      default:
+        keyIn(pSl, j);
+        pSl->phase[j] = SESS_DONE;
+        break;
+    }
+
+    if ((pSl->flags[j] & (FLAG_CLOSE | FLAG_PEND)) == FLAG_CLOSE) {
+      closeSession(pTab, pSl, j, id);
+    }
+  }
+
+  return count;
+}
+
+#else
+
+//*****************************************************************************
+//
+// Function -> NORX session calls
+// Purpose -> Nothing to run with P > 1, NORXSessCreate() gives no table
+//
+//*****************************************************************************
+norx_sess_t*
+NORXSessCreate(uint32_t maxSessions) {
+  (void)maxSessions;
+  return NULL;
+}
+
+void
+NORXSessDestroy(norx_sess_t* pTab) {
+  (void)pTab;
+}
+
+uint32_t
+NORXSessStart(norx_sess_t* pTab, const norx_key_t* pKey, const uint8_t* pN) {
+  (void)pTab;
+  (void)pKey;
+  (void)pN;
+  return SESS_NONE;
+}
+
+bool
+NORXSessHeader(norx_sess_t* pTab, uint32_t id, const uint8_t* pA, size_t len,
+               size_t* pTaken) {
+  (void)pTab;
+  (void)id;
+  (void)pA;
+  (void)len;
+  *pTaken = 0;
+  return false;
+}
+
+bool
+NORXSessEncrypt(norx_sess_t* pTab, uint32_t id, const uint8_t* pM, size_t len,
+                uint8_t* pC, size_t* pTaken) {
+  (void)pC;
+  return NORXSessHeader(pTab, id, pM, len, pTaken);
+}
+
+bool
+NORXSessDecrypt(norx_sess_t* pTab, uint32_t id, const uint8_t* pC, size_t len,
+                uint8_t* pM, size_t* pTaken) {
+  (void)pM;
+  return NORXSessHeader(pTab, id, pC, len, pTaken);
+}
+
+bool
+NORXSessTrailer(norx_sess_t* pTab, uint32_t id, const uint8_t* pZ, size_t len,
+                size_t* pTaken) {
+  return NORXSessHeader(pTab, id, pZ, len, pTaken);
+}
+
+bool
+NORXSessFinal(norx_sess_t* pTab, uint32_t id) {
+  (void)pTab;
+  (void)id;
+  return false;
+}
+
+bool
+NORXSessTag(norx_sess_t* pTab, uint32_t id, uint8_t* pT) {
+  (void)pTab;
+  (void)id;
+  (void)pT;
+  return false;
+}
+
+bool
+NORXSessTagCheck(norx_sess_t* pTab, uint32_t id, const uint8_t* pT,
+                 bool* pOk) {
+  (void)pTab;
+  (void)id;
+  (void)pT;
+  (void)pOk;
+  return false;
+}
+
+void
+NORXSessDrop(norx_sess_t* pTab, uint32_t id) {
+  (void)pTab;
+  (void)id;
+}
+
+bool
+NORXSessBusy(const norx_sess_t* pTab, uint32_t id) {
+  (void)pTab;
+  (void)id;
+  return false;
+}
+
+size_t
+NORXSessTick(norx_sess_t* pTab) {
+  (void)pTab;
+  return 0;
+}
+
+#endif
@@ -0,0 +1,81 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_sess.h                                                         *
+* Purpose -> Table of many long lived NORX streams, states kept structure of  *
+*            arrays so the F calls of all sessions run through the batch      *
+*            kernel                                                           *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - SoA Session Table with Batched Ticks            *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_SESS_H
+#define NORX_SESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Session id NORXSessStart() gives when the table is full
+//*****************************************************************************
+#define SESS_NONE   UINT32_MAX
+
+//*****************************************************************************
+// Session table, only used through the calls below. A table belongs to one
+// thread, run one per event loop.
+//*****************************************************************************
+typedef struct norx_sess_s norx_sess_t;
+
+//*****************************************************************************
+// Session Prototypes
+//
+// A session is a stream like NORX_stream.h gives, except that it never runs
+// F itself. When a call needs one, say to open the next rate block, it asks
+// for it and takes no more bytes. NORXSessTick() then runs every F asked for
+// since the last tick, as many sessions per batch F as there are lanes.
+//
+// NORXSessCreate() - Table for up to maxSessions at once, NULL if there is
+//                    no memory or PARALLEL is not 1
+// NORXSessStart() - New session under a key schedule and nonce, SESS_NONE
+//                   if the table is full
+// NORXSessHeader() / NORXSessEncrypt() / NORXSessDecrypt() /
+// NORXSessTrailer() - Feed bytes of a phase, *pTaken gets how many were
+//                     taken, fewer than len while the session waits for a
+//                     tick. false if the session is past that phase.
+// NORXSessFinal() - Close the session, the tag is made over the next ticks.
+//                   false if it was closed already.
+// NORXSessTag() - Tag of a closed session once it is ready, the session is
+//                 then freed. false until then.
+// NORXSessTagCheck() - NORXSessTag() for a session being opened: *pOk gets
+//                      whether the tag matches pT, compared by tagMatch(),
+//                      and the computed tag is never handed out
+// NORXSessDrop() - Free a session without a tag
+// NORXSessBusy() - true while the session waits for a tick
+// NORXSessTick() - Run every F asked for, returns how many ran
+//*****************************************************************************
+extern norx_sess_t* NORXSessCreate(uint32_t maxSessions);
+extern void NORXSessDestroy(norx_sess_t* pTab);
+extern uint32_t NORXSessStart(norx_sess_t* pTab, const norx_key_t* pKey,
+                              const uint8_t* pN);
+extern bool NORXSessHeader(norx_sess_t* pTab, uint32_t id,
+                           const uint8_t* pA, size_t len, size_t* pTaken);
+extern bool NORXSessEncrypt(norx_sess_t* pTab, uint32_t id,
+                            const uint8_t* pM, size_t len, uint8_t* pC,
+                            size_t* pTaken);
+extern bool NORXSessDecrypt(norx_sess_t* pTab, uint32_t id,
+                            const uint8_t* pC, size_t len, uint8_t* pM,
+                            size_t* pTaken);
+extern bool NORXSessTrailer(norx_sess_t* pTab, uint32_t id,
+                            const uint8_t* pZ, size_t len, size_t* pTaken);
+extern bool NORXSessFinal(norx_sess_t* pTab, uint32_t id);
+extern bool NORXSessTag(norx_sess_t* pTab, uint32_t id, uint8_t* pT);
+extern bool NORXSessTagCheck(norx_sess_t* pTab, uint32_t id,
+                             const uint8_t* pT, bool* pOk);
+extern void NORXSessDrop(norx_sess_t* pTab, uint32_t id);
+extern bool NORXSessBusy(const norx_sess_t* pTab, uint32_t id);
+extern size_t NORXSessTick(norx_sess_t* pTab);
+
+#endif // NORX_SESS_H
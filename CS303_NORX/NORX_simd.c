@@ -0,0 +1,1130 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_simd.c                                                         *
+* Purpose -> SIMD versions of the F permutation and the cpuid check that      *
+*            picks the fastest one this CPU can run                           *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - SSE2, AVX2 and AVX-512 Row Kernels              *
+*            2.0 10/17/2026 - Lane Kernels Running the P Branched States      *
+*                             Together                                        *
+*            3.0 10/17/2026 - Batch Kernels on BATCH_LANES States Kept Word   *
+*                             per Row                                         *
+*            4.0 10/17/2026 - NORXLaneWidth() for the micro benchmark         *
+*                                                                             *
+* The kernels keep the 4x4 state as four row vectors. The column step is one  *
+* G over the rows, the diagonal step rotates rows 1-3 left by 1, 2 and 3      *
+* words so the diagonals line up as columns, runs G, then rotates them back.  *
+*                                                                             *
+* The lane kernels run several independent states at once. Most hold word i   *
+* of every lane in one vector so the G calls need no shuffles at all, the     *
+* AVX-512 NORX32 kernel instead packs the same row of four lanes into one     *
+* 512 bit register and keeps the row rotations of the single state kernels.   *
+*                                                                             *
+* The batch kernels take states already stored word per row, BATCH_LANES      *
+* words in each of the 16 rows, so they go straight into vectors of as many   *
+* lanes as the register holds with no transposes on the way in or out.        *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stdint.h>    // uintXX_t types
+
+#include "NORX.h"      // NORX defines and prototypes
+#include "NORX_simd.h" // Kernel IDs and prototypes
+
+//*****************************************************************************
+// Only build the vector kernels where GCC style target attributes and the
+// x86 intrinsics are around, everything else gets the scalar F
+//*****************************************************************************
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define NORX_X86  0x1
+  #include <cpuid.h>
+  #include <immintrin.h>
+
+  #define TARGET_SSE2    __attribute__((target("sse2")))
+  #define TARGET_AVX2    __attribute__((target("avx2")))
+  #define TARGET_AVX512  __attribute__((target("avx2,avx512f,avx512vl")))
+#endif
+
+//*****************************************************************************
+// G on four row vectors, a column of the state per vector slot
+//*****************************************************************************
+#define ROW_G(a, b, c, d, HF, XF, RF)   \
+  do {                                  \
+    a = HF(a, b);                       \
+    d = RF(XF(a, d), R0);               \
+    c = HF(c, d);                       \
+    b = RF(XF(b, c), R1);               \
+    a = HF(a, b);                       \
+    d = RF(XF(a, d), R2);               \
+    c = HF(c, d);                       \
+    b = RF(XF(b, c), R3);               \
+  } while (0)
+
+//*****************************************************************************
+// Full F over states held word per vector, v[i] has word i of every lane
+//*****************************************************************************
+#define LANE_F(v, HF, XF, RF)                         \
+  do {                                                \
+    int rnd;                                          \
+    for (rnd = 0; rnd < RND_NUM; rnd++) {             \
+      ROW_G(v[0], v[4], v[8], v[12], HF, XF, RF);     \
+      ROW_G(v[1], v[5], v[9], v[13], HF, XF, RF);     \
+      ROW_G(v[2], v[6], v[10], v[14], HF, XF, RF);    \
+      ROW_G(v[3], v[7], v[11], v[15], HF, XF, RF);    \
+      ROW_G(v[0], v[5], v[10], v[15], HF, XF, RF);    \
+      ROW_G(v[1], v[6], v[11], v[12], HF, XF, RF);    \
+      ROW_G(v[2], v[7], v[8], v[13], HF, XF, RF);     \
+      ROW_G(v[3], v[4], v[9], v[14], HF, XF, RF);     \
+    }                                                 \
+  } while (0)
+
+//*****************************************************************************
+// F over a batch stored word per row, T holds as many lanes as fit and the
+// rows are walked a vector wide at a time
+//*****************************************************************************
+#define BATCH_F(pwBatch, T, LOAD, STORE, HF, XF, RF)                    \
+  do {                                                                  \
+    T v[16];                                                            \
+    int k;                                                              \
+    int w;                                                              \
+    for (k = 0; k < BATCH_LANES; k += sizeof(T) / WORD_BYTES) {         \
+      for (w = 0; w < 16; w++) {                                        \
+        v[w] = LOAD((const T*)(pwBatch + w * BATCH_LANES + k));         \
+      }                                                                 \
+      LANE_F(v, HF, XF, RF);                                            \
+      for (w = 0; w < 16; w++) {                                        \
+        STORE((T*)(pwBatch + w * BATCH_LANES + k), v[w]);               \
+      }                                                                 \
+    }                                                                   \
+  } while (0)
+
+//*****************************************************************************
+// Kernel currently behind F(), scalar until NORXSelectKernel() runs
+//*****************************************************************************
+permute_t pfnPermute = FScalar;
+permute_t pfnPermuteLanes = FScalar;
+permute_t pfnPermuteBatch = FBatchScalar;
+
+static uint32_t curKernel = KERNEL_SCALAR;
+static uint32_t laneWidth = 1;    // states pfnPermuteLanes runs per call
+static uint32_t kernelMask = 0;   // bit per supported kernel, 0 = not probed
+
+static const char* kernelNames[KERNEL_COUNT] = {
+  "scalar",
+  "sse2",
+  "avx2",
+  "avx512"
+};
+
+//*****************************************************************************
+// Scalar helpers for the batch kernel, one lane per "vector"
+//*****************************************************************************
+static inline word_t
+wordLoad(const word_t* pw) {
+  return *pw;
+}
+
+static inline void
+wordStore(word_t* pw, word_t x) {
+  *pw = x;
+}
+
+static inline word_t
+wordXor(word_t x, word_t y) {
+  return x ^ y;
+}
+
+static inline word_t
+wordH(word_t x, word_t y) {
+  return (x ^ y) ^ ((x & y) << 1);
+}
+
+static inline word_t
+wordRot(word_t x, const int shift) {
+  return (x >> shift) | (x << (WORD_LEN - shift));
+}
+
+//*****************************************************************************
+//
+// Function -> FBatchScalar
+// Purpose -> F permutation on a batch with plain C, the loops are all
+//            independent so the compiler is free to vectorise them itself
+// Input -> word_t* pwBatch[] - 16 rows of BATCH_LANES words
+//
+//*****************************************************************************
+void
+FBatchScalar(word_t* pwBatch) {
+  BATCH_F(pwBatch, word_t, wordLoad, wordStore, wordH, wordXor, wordRot);
+}
+
+#ifdef NORX_X86
+
+#if WORD_LEN == 32
+//*****************************************************************************
+//
+// 32 bit words, one row of the state fits a 128 bit register
+//
+//*****************************************************************************
+
+//*****************************************************************************
+// SSE2 helpers
+//*****************************************************************************
+TARGET_SSE2 static inline __m128i
+sse2H(__m128i x, __m128i y) {
+  return _mm_xor_si128(_mm_xor_si128(x, y),
+                       _mm_slli_epi32(_mm_and_si128(x, y), 1));
+}
+
+TARGET_SSE2 static inline __m128i
+sse2Rot(__m128i x, const int shift) {
+  return _mm_or_si128(_mm_srli_epi32(x, shift), _mm_slli_epi32(x, 32 - shift));
+}
+
+//*****************************************************************************
+//
+// Function -> FSse2
+// Purpose -> F permutation on four 128 bit rows using SSE2
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+TARGET_SSE2 void
+FSse2(word_t* pwS) {
+  __m128i r0 = _mm_loadu_si128((const __m128i*)(pwS + 0));
+  __m128i r1 = _mm_loadu_si128((const __m128i*)(pwS + 4));
+  __m128i r2 = _mm_loadu_si128((const __m128i*)(pwS + 8));
+  __m128i r3 = _mm_loadu_si128((const __m128i*)(pwS + 12));
+  int i;
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r0, r1, r2, r3, sse2H, _mm_xor_si128, sse2Rot);
+
+    //
+    // Line the diagonals up as columns
+    //
+    r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(0, 3, 2, 1));
+    r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(2, 1, 0, 3));
+
+    ROW_G(r0, r1, r2, r3, sse2H, _mm_xor_si128, sse2Rot);
+
+    r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(2, 1, 0, 3));
+    r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(0, 3, 2, 1));
+  }
+
+  _mm_storeu_si128((__m128i*)(pwS + 0), r0);
+  _mm_storeu_si128((__m128i*)(pwS + 4), r1);
+  _mm_storeu_si128((__m128i*)(pwS + 8), r2);
+  _mm_storeu_si128((__m128i*)(pwS + 12), r3);
+}
+
+//*****************************************************************************
+// AVX2 helpers, the 8 and 16 bit rotations are byte shuffles
+//*****************************************************************************
+TARGET_AVX2 static inline __m128i
+avx2H(__m128i x, __m128i y) {
+  return _mm_xor_si128(_mm_xor_si128(x, y),
+                       _mm_slli_epi32(_mm_and_si128(x, y), 1));
+}
+
+TARGET_AVX2 static inline __m128i
+avx2Rot(__m128i x, const int shift) {
+  if (shift == 8) {
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4,
+                                             9, 10, 11, 8, 13, 14, 15, 12));
+  }
+  if (shift == 16) {
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5,
+                                             10, 11, 8, 9, 14, 15, 12, 13));
+  }
+  return _mm_or_si128(_mm_srli_epi32(x, shift), _mm_slli_epi32(x, 32 - shift));
+}
+
+//*****************************************************************************
+//
+// Function -> FAvx2
+// Purpose -> F permutation on four 128 bit rows using AVX2 encodings
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+TARGET_AVX2 void
+FAvx2(word_t* pwS) {
+  __m128i r0 = _mm_loadu_si128((const __m128i*)(pwS + 0));
+  __m128i r1 = _mm_loadu_si128((const __m128i*)(pwS + 4));
+  __m128i r2 = _mm_loadu_si128((const __m128i*)(pwS + 8));
+  __m128i r3 = _mm_loadu_si128((const __m128i*)(pwS + 12));
+  int i;
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r0, r1, r2, r3, avx2H, _mm_xor_si128, avx2Rot);
+
+    r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(0, 3, 2, 1));
+    r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(2, 1, 0, 3));
+
+    ROW_G(r0, r1, r2, r3, avx2H, _mm_xor_si128, avx2Rot);
+
+    r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(2, 1, 0, 3));
+    r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(0, 3, 2, 1));
+  }
+
+  _mm_storeu_si128((__m128i*)(pwS + 0), r0);
+  _mm_storeu_si128((__m128i*)(pwS + 4), r1);
+  _mm_storeu_si128((__m128i*)(pwS + 8), r2);
+  _mm_storeu_si128((__m128i*)(pwS + 12), r3);
+}
+
+//*****************************************************************************
+// AVX-512 helpers, native rotates and a three way XOR through vpternlog
+//*****************************************************************************
+TARGET_AVX512 static inline __m128i
+avx512H(__m128i x, __m128i y) {
+  return _mm_ternarylogic_epi32(x, y, _mm_slli_epi32(_mm_and_si128(x, y), 1),
+                                0x96);
+}
+
+TARGET_AVX512 static inline __m128i
+avx512Rot(__m128i x, const int shift) {
+  return _mm_ror_epi32(x, shift);
+}
+
+//*****************************************************************************
+//
+// Function -> FAvx512
+// Purpose -> F permutation on four 128 bit rows using AVX-512VL
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+TARGET_AVX512 void
+FAvx512(word_t* pwS) {
+  __m128i r0 = _mm_loadu_si128((const __m128i*)(pwS + 0));
+  __m128i r1 = _mm_loadu_si128((const __m128i*)(pwS + 4));
+  __m128i r2 = _mm_loadu_si128((const __m128i*)(pwS + 8));
+  __m128i r3 = _mm_loadu_si128((const __m128i*)(pwS + 12));
+  int i;
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r0, r1, r2, r3, avx512H, _mm_xor_si128, avx512Rot);
+
+    r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(0, 3, 2, 1));
+    r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(2, 1, 0, 3));
+
+    ROW_G(r0, r1, r2, r3, avx512H, _mm_xor_si128, avx512Rot);
+
+    r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(2, 1, 0, 3));
+    r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(0, 3, 2, 1));
+  }
+
+  _mm_storeu_si128((__m128i*)(pwS + 0), r0);
+  _mm_storeu_si128((__m128i*)(pwS + 4), r1);
+  _mm_storeu_si128((__m128i*)(pwS + 8), r2);
+  _mm_storeu_si128((__m128i*)(pwS + 12), r3);
+}
+
+//*****************************************************************************
+// 4x4 transpose of 32 bit words, turns four rows of four lanes into word
+// per vector form and back
+//*****************************************************************************
+TARGET_SSE2 static inline void
+sse2Transpose(__m128i* v) {
+  __m128i t0 = _mm_unpacklo_epi32(v[0], v[1]);
+  __m128i t1 = _mm_unpackhi_epi32(v[0], v[1]);
+  __m128i t2 = _mm_unpacklo_epi32(v[2], v[3]);
+  __m128i t3 = _mm_unpackhi_epi32(v[2], v[3]);
+
+  v[0] = _mm_unpacklo_epi64(t0, t2);
+  v[1] = _mm_unpackhi_epi64(t0, t2);
+  v[2] = _mm_unpacklo_epi64(t1, t3);
+  v[3] = _mm_unpackhi_epi64(t1, t3);
+}
+
+TARGET_SSE2 static inline void
+sse2LoadLanes(const word_t* pwLanes, __m128i* v) {
+  int i;
+  int j;
+
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 4; j++) {
+      v[4 * i + j] = _mm_loadu_si128((const __m128i*)(pwLanes + 16 * j + 4 * i));
+    }
+    sse2Transpose(v + 4 * i);
+  }
+}
+
+TARGET_SSE2 static inline void
+sse2StoreLanes(word_t* pwLanes, __m128i* v) {
+  int i;
+  int j;
+
+  for (i = 0; i < 4; i++) {
+    sse2Transpose(v + 4 * i);
+    for (j = 0; j < 4; j++) {
+      _mm_storeu_si128((__m128i*)(pwLanes + 16 * j + 4 * i), v[4 * i + j]);
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> FLanesSse2
+// Purpose -> F permutation on four states at once using SSE2
+// Input -> word_t* pwLanes[] - Pointer to 4 states, 16 words each
+//
+//*****************************************************************************
+TARGET_SSE2 void
+FLanesSse2(word_t* pwLanes) {
+  __m128i v[16];
+
+  sse2LoadLanes(pwLanes, v);
+  LANE_F(v, sse2H, _mm_xor_si128, sse2Rot);
+  sse2StoreLanes(pwLanes, v);
+}
+
+//*****************************************************************************
+//
+// Function -> FLanesAvx2
+// Purpose -> F permutation on four states at once using AVX2 encodings
+// Input -> word_t* pwLanes[] - Pointer to 4 states, 16 words each
+//
+//*****************************************************************************
+TARGET_AVX2 void
+FLanesAvx2(word_t* pwLanes) {
+  __m128i v[16];
+
+  sse2LoadLanes(pwLanes, v);
+  LANE_F(v, avx2H, _mm_xor_si128, avx2Rot);
+  sse2StoreLanes(pwLanes, v);
+}
+
+//*****************************************************************************
+// AVX-512 helpers for a register holding the same row of four lanes
+//*****************************************************************************
+TARGET_AVX512 static inline __m512i
+zmmH(__m512i x, __m512i y) {
+  return _mm512_ternarylogic_epi32(x, y,
+                                   _mm512_slli_epi32(_mm512_and_si512(x, y), 1),
+                                   0x96);
+}
+
+TARGET_AVX512 static inline __m512i
+zmmRot(__m512i x, const int shift) {
+  return _mm512_ror_epi32(x, shift);
+}
+
+//
+// 4x4 transpose of 128 bit blocks, four whole states become four rows
+//
+TARGET_AVX512 static inline void
+zmmTranspose(__m512i* r) {
+  __m512i t0 = _mm512_shuffle_i32x4(r[0], r[1], _MM_SHUFFLE(1, 0, 1, 0));
+  __m512i t1 = _mm512_shuffle_i32x4(r[0], r[1], _MM_SHUFFLE(3, 2, 3, 2));
+  __m512i t2 = _mm512_shuffle_i32x4(r[2], r[3], _MM_SHUFFLE(1, 0, 1, 0));
+  __m512i t3 = _mm512_shuffle_i32x4(r[2], r[3], _MM_SHUFFLE(3, 2, 3, 2));
+
+  r[0] = _mm512_shuffle_i32x4(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));
+  r[1] = _mm512_shuffle_i32x4(t0, t2, _MM_SHUFFLE(3, 1, 3, 1));
+  r[2] = _mm512_shuffle_i32x4(t1, t3, _MM_SHUFFLE(2, 0, 2, 0));
+  r[3] = _mm512_shuffle_i32x4(t1, t3, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+//*****************************************************************************
+//
+// Function -> FLanesAvx512
+// Purpose -> F permutation on four states at once, all 16x32 bit slots of
+//            each AVX-512 register in use
+// Input -> word_t* pwLanes[] - Pointer to 4 states, 16 words each
+//
+//*****************************************************************************
+TARGET_AVX512 void
+FLanesAvx512(word_t* pwLanes) {
+  __m512i r[4];
+  int i;
+
+  for (i = 0; i < 4; i++) {
+    r[i] = _mm512_loadu_si512((const void*)(pwLanes + 16 * i));
+  }
+  zmmTranspose(r);
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r[0], r[1], r[2], r[3], zmmH, _mm512_xor_si512, zmmRot);
+
+    r[1] = _mm512_shuffle_epi32(r[1], (_MM_PERM_ENUM)_MM_SHUFFLE(0, 3, 2, 1));
+    r[2] = _mm512_shuffle_epi32(r[2], (_MM_PERM_ENUM)_MM_SHUFFLE(1, 0, 3, 2));
+    r[3] = _mm512_shuffle_epi32(r[3], (_MM_PERM_ENUM)_MM_SHUFFLE(2, 1, 0, 3));
+
+    ROW_G(r[0], r[1], r[2], r[3], zmmH, _mm512_xor_si512, zmmRot);
+
+    r[1] = _mm512_shuffle_epi32(r[1], (_MM_PERM_ENUM)_MM_SHUFFLE(2, 1, 0, 3));
+    r[2] = _mm512_shuffle_epi32(r[2], (_MM_PERM_ENUM)_MM_SHUFFLE(1, 0, 3, 2));
+    r[3] = _mm512_shuffle_epi32(r[3], (_MM_PERM_ENUM)_MM_SHUFFLE(0, 3, 2, 1));
+  }
+
+  zmmTranspose(r);
+  for (i = 0; i < 4; i++) {
+    _mm512_storeu_si512((void*)(pwLanes + 16 * i), r[i]);
+  }
+}
+
+//*****************************************************************************
+// 256 bit AVX2 helpers for the batch kernel, eight lanes per register
+//*****************************************************************************
+TARGET_AVX2 static inline __m256i
+ymmH(__m256i x, __m256i y) {
+  return _mm256_xor_si256(_mm256_xor_si256(x, y),
+                          _mm256_slli_epi32(_mm256_and_si256(x, y), 1));
+}
+
+TARGET_AVX2 static inline __m256i
+ymmRot(__m256i x, const int shift) {
+  if (shift == 8) {
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+             1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+             1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12));
+  }
+  if (shift == 16) {
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+             2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+             2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+  }
+  return _mm256_or_si256(_mm256_srli_epi32(x, shift),
+                         _mm256_slli_epi32(x, 32 - shift));
+}
+
+//*****************************************************************************
+//
+// Function -> FBatchSse2 / FBatchAvx2 / FBatchAvx512
+// Purpose -> F permutation on a batch of 16 states, 4, 8 or all 16 lanes
+//            per register
+// Input -> word_t* pwBatch[] - 16 rows of BATCH_LANES words
+//
+//*****************************************************************************
+TARGET_SSE2 void
+FBatchSse2(word_t* pwBatch) {
+  BATCH_F(pwBatch, __m128i, _mm_loadu_si128, _mm_storeu_si128,
+          sse2H, _mm_xor_si128, sse2Rot);
+}
+
+TARGET_AVX2 void
+FBatchAvx2(word_t* pwBatch) {
+  BATCH_F(pwBatch, __m256i, _mm256_loadu_si256, _mm256_storeu_si256,
+          ymmH, _mm256_xor_si256, ymmRot);
+}
+
+TARGET_AVX512 void
+FBatchAvx512(word_t* pwBatch) {
+  BATCH_F(pwBatch, __m512i, _mm512_loadu_si512, _mm512_storeu_si512,
+          zmmH, _mm512_xor_si512, zmmRot);
+}
+
+#else
+//*****************************************************************************
+//
+// 64 bit words, one row is 256 bits so SSE2 splits it into a low and high
+// register and AVX2/AVX-512 hold it in one
+//
+//*****************************************************************************
+
+//*****************************************************************************
+// SSE2 helpers
+//*****************************************************************************
+TARGET_SSE2 static inline __m128i
+sse2H(__m128i x, __m128i y) {
+  return _mm_xor_si128(_mm_xor_si128(x, y),
+                       _mm_slli_epi64(_mm_and_si128(x, y), 1));
+}
+
+TARGET_SSE2 static inline __m128i
+sse2Rot(__m128i x, const int shift) {
+  return _mm_or_si128(_mm_srli_epi64(x, shift), _mm_slli_epi64(x, 64 - shift));
+}
+
+//
+// (a[1], b[0]) of two word pairs, used to turn split rows
+//
+TARGET_SSE2 static inline __m128i
+sse2Mid(__m128i a, __m128i b) {
+  return _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(a),
+                                         _mm_castsi128_pd(b), 1));
+}
+
+//*****************************************************************************
+//
+// Function -> FSse2
+// Purpose -> F permutation on four 256 bit rows, each split in two SSE2
+//            registers
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+TARGET_SSE2 void
+FSse2(word_t* pwS) {
+  __m128i r0l = _mm_loadu_si128((const __m128i*)(pwS + 0));
+  __m128i r0h = _mm_loadu_si128((const __m128i*)(pwS + 2));
+  __m128i r1l = _mm_loadu_si128((const __m128i*)(pwS + 4));
+  __m128i r1h = _mm_loadu_si128((const __m128i*)(pwS + 6));
+  __m128i r2l = _mm_loadu_si128((const __m128i*)(pwS + 8));
+  __m128i r2h = _mm_loadu_si128((const __m128i*)(pwS + 10));
+  __m128i r3l = _mm_loadu_si128((const __m128i*)(pwS + 12));
+  __m128i r3h = _mm_loadu_si128((const __m128i*)(pwS + 14));
+  __m128i t0;
+  __m128i t1;
+  int i;
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r0l, r1l, r2l, r3l, sse2H, _mm_xor_si128, sse2Rot);
+    ROW_G(r0h, r1h, r2h, r3h, sse2H, _mm_xor_si128, sse2Rot);
+
+    //
+    // Line the diagonals up as columns
+    //
+    t0 = sse2Mid(r1l, r1h);
+    t1 = sse2Mid(r1h, r1l);
+    r1l = t0;
+    r1h = t1;
+    t0 = r2l;
+    r2l = r2h;
+    r2h = t0;
+    t0 = sse2Mid(r3h, r3l);
+    t1 = sse2Mid(r3l, r3h);
+    r3l = t0;
+    r3h = t1;
+
+    ROW_G(r0l, r1l, r2l, r3l, sse2H, _mm_xor_si128, sse2Rot);
+    ROW_G(r0h, r1h, r2h, r3h, sse2H, _mm_xor_si128, sse2Rot);
+
+    t0 = sse2Mid(r1h, r1l);
+    t1 = sse2Mid(r1l, r1h);
+    r1l = t0;
+    r1h = t1;
+    t0 = r2l;
+    r2l = r2h;
+    r2h = t0;
+    t0 = sse2Mid(r3l, r3h);
+    t1 = sse2Mid(r3h, r3l);
+    r3l = t0;
+    r3h = t1;
+  }
+
+  _mm_storeu_si128((__m128i*)(pwS + 0), r0l);
+  _mm_storeu_si128((__m128i*)(pwS + 2), r0h);
+  _mm_storeu_si128((__m128i*)(pwS + 4), r1l);
+  _mm_storeu_si128((__m128i*)(pwS + 6), r1h);
+  _mm_storeu_si128((__m128i*)(pwS + 8), r2l);
+  _mm_storeu_si128((__m128i*)(pwS + 10), r2h);
+  _mm_storeu_si128((__m128i*)(pwS + 12), r3l);
+  _mm_storeu_si128((__m128i*)(pwS + 14), r3h);
+}
+
+//*****************************************************************************
+// AVX2 helpers, the 8 and 40 bit rotations are byte shuffles
+//*****************************************************************************
+TARGET_AVX2 static inline __m256i
+avx2H(__m256i x, __m256i y) {
+  return _mm256_xor_si256(_mm256_xor_si256(x, y),
+                          _mm256_slli_epi64(_mm256_and_si256(x, y), 1));
+}
+
+TARGET_AVX2 static inline __m256i
+avx2Rot(__m256i x, const int shift) {
+  if (shift == 8) {
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+             1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8,
+             1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8));
+  }
+  if (shift == 40) {
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+             5, 6, 7, 0, 1, 2, 3, 4, 13, 14, 15, 8, 9, 10, 11, 12,
+             5, 6, 7, 0, 1, 2, 3, 4, 13, 14, 15, 8, 9, 10, 11, 12));
+  }
+  if (shift == 63) {
+    return _mm256_or_si256(_mm256_add_epi64(x, x), _mm256_srli_epi64(x, 63));
+  }
+  return _mm256_or_si256(_mm256_srli_epi64(x, shift),
+                         _mm256_slli_epi64(x, 64 - shift));
+}
+
+//*****************************************************************************
+//
+// Function -> FAvx2
+// Purpose -> F permutation on four 256 bit rows using AVX2
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+TARGET_AVX2 void
+FAvx2(word_t* pwS) {
+  __m256i r0 = _mm256_loadu_si256((const __m256i*)(pwS + 0));
+  __m256i r1 = _mm256_loadu_si256((const __m256i*)(pwS + 4));
+  __m256i r2 = _mm256_loadu_si256((const __m256i*)(pwS + 8));
+  __m256i r3 = _mm256_loadu_si256((const __m256i*)(pwS + 12));
+  int i;
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r0, r1, r2, r3, avx2H, _mm256_xor_si256, avx2Rot);
+
+    r1 = _mm256_permute4x64_epi64(r1, _MM_SHUFFLE(0, 3, 2, 1));
+    r2 = _mm256_permute4x64_epi64(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm256_permute4x64_epi64(r3, _MM_SHUFFLE(2, 1, 0, 3));
+
+    ROW_G(r0, r1, r2, r3, avx2H, _mm256_xor_si256, avx2Rot);
+
+    r1 = _mm256_permute4x64_epi64(r1, _MM_SHUFFLE(2, 1, 0, 3));
+    r2 = _mm256_permute4x64_epi64(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm256_permute4x64_epi64(r3, _MM_SHUFFLE(0, 3, 2, 1));
+  }
+
+  _mm256_storeu_si256((__m256i*)(pwS + 0), r0);
+  _mm256_storeu_si256((__m256i*)(pwS + 4), r1);
+  _mm256_storeu_si256((__m256i*)(pwS + 8), r2);
+  _mm256_storeu_si256((__m256i*)(pwS + 12), r3);
+}
+
+//*****************************************************************************
+// AVX-512 helpers, native rotates and a three way XOR through vpternlog
+//*****************************************************************************
+TARGET_AVX512 static inline __m256i
+avx512H(__m256i x, __m256i y) {
+  return _mm256_ternarylogic_epi64(x, y,
+                                   _mm256_slli_epi64(_mm256_and_si256(x, y), 1),
+                                   0x96);
+}
+
+TARGET_AVX512 static inline __m256i
+avx512Rot(__m256i x, const int shift) {
+  return _mm256_ror_epi64(x, shift);
+}
+
+//*****************************************************************************
+//
+// Function -> FAvx512
+// Purpose -> F permutation on four 256 bit rows using AVX-512VL
+// Input -> word_t* pwS[] - Pointer to State, 4x4 matrix of words
+//
+//*****************************************************************************
+TARGET_AVX512 void
+FAvx512(word_t* pwS) {
+  __m256i r0 = _mm256_loadu_si256((const __m256i*)(pwS + 0));
+  __m256i r1 = _mm256_loadu_si256((const __m256i*)(pwS + 4));
+  __m256i r2 = _mm256_loadu_si256((const __m256i*)(pwS + 8));
+  __m256i r3 = _mm256_loadu_si256((const __m256i*)(pwS + 12));
+  int i;
+
+  for (i = 0; i < RND_NUM; i++) {
+    ROW_G(r0, r1, r2, r3, avx512H, _mm256_xor_si256, avx512Rot);
+
+    r1 = _mm256_permute4x64_epi64(r1, _MM_SHUFFLE(0, 3, 2, 1));
+    r2 = _mm256_permute4x64_epi64(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm256_permute4x64_epi64(r3, _MM_SHUFFLE(2, 1, 0, 3));
+
+    ROW_G(r0, r1, r2, r3, avx512H, _mm256_xor_si256, avx512Rot);
+
+    r1 = _mm256_permute4x64_epi64(r1, _MM_SHUFFLE(2, 1, 0, 3));
+    r2 = _mm256_permute4x64_epi64(r2, _MM_SHUFFLE(1, 0, 3, 2));
+    r3 = _mm256_permute4x64_epi64(r3, _MM_SHUFFLE(0, 3, 2, 1));
+  }
+
+  _mm256_storeu_si256((__m256i*)(pwS + 0), r0);
+  _mm256_storeu_si256((__m256i*)(pwS + 4), r1);
+  _mm256_storeu_si256((__m256i*)(pwS + 8), r2);
+  _mm256_storeu_si256((__m256i*)(pwS + 12), r3);
+}
+
+//*****************************************************************************
+// Word per vector loads for two lanes in 128 bit registers
+//*****************************************************************************
+TARGET_SSE2 static inline void
+sse2LoadLanes(const word_t* pwLanes, __m128i* v) {
+  __m128i a;
+  __m128i b;
+  int i;
+
+  for (i = 0; i < 16; i += 2) {
+    a = _mm_loadu_si128((const __m128i*)(pwLanes + i));
+    b = _mm_loadu_si128((const __m128i*)(pwLanes + 16 + i));
+    v[i] = _mm_unpacklo_epi64(a, b);
+    v[i + 1] = _mm_unpackhi_epi64(a, b);
+  }
+}
+
+TARGET_SSE2 static inline void
+sse2StoreLanes(word_t* pwLanes, const __m128i* v) {
+  int i;
+
+  for (i = 0; i < 16; i += 2) {
+    _mm_storeu_si128((__m128i*)(pwLanes + i), _mm_unpacklo_epi64(v[i], v[i + 1]));
+    _mm_storeu_si128((__m128i*)(pwLanes + 16 + i),
+                     _mm_unpackhi_epi64(v[i], v[i + 1]));
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> FLanesSse2
+// Purpose -> F permutation on two states at once using SSE2
+// Input -> word_t* pwLanes[] - Pointer to 2 states, 16 words each
+//
+//*****************************************************************************
+TARGET_SSE2 void
+FLanesSse2(word_t* pwLanes) {
+  __m128i v[16];
+
+  sse2LoadLanes(pwLanes, v);
+  LANE_F(v, sse2H, _mm_xor_si128, sse2Rot);
+  sse2StoreLanes(pwLanes, v);
+}
+
+//*****************************************************************************
+// 4x4 transpose of 64 bit words, turns four rows of four lanes into word
+// per vector form and back
+//*****************************************************************************
+TARGET_AVX2 static inline void
+avx2Transpose(__m256i* v) {
+  __m256i t0 = _mm256_unpacklo_epi64(v[0], v[1]);
+  __m256i t1 = _mm256_unpackhi_epi64(v[0], v[1]);
+  __m256i t2 = _mm256_unpacklo_epi64(v[2], v[3]);
+  __m256i t3 = _mm256_unpackhi_epi64(v[2], v[3]);
+
+  v[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+  v[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+  v[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+  v[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+TARGET_AVX2 static inline void
+avx2LoadLanes(const word_t* pwLanes, __m256i* v) {
+  int i;
+  int j;
+
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 4; j++) {
+      v[4 * i + j] = _mm256_loadu_si256((const __m256i*)(pwLanes + 16 * j + 4 * i));
+    }
+    avx2Transpose(v + 4 * i);
+  }
+}
+
+TARGET_AVX2 static inline void
+avx2StoreLanes(word_t* pwLanes, __m256i* v) {
+  int i;
+  int j;
+
+  for (i = 0; i < 4; i++) {
+    avx2Transpose(v + 4 * i);
+    for (j = 0; j < 4; j++) {
+      _mm256_storeu_si256((__m256i*)(pwLanes + 16 * j + 4 * i), v[4 * i + j]);
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> FLanesAvx2
+// Purpose -> F permutation on four states at once, one 64 bit lane per slot
+// Input -> word_t* pwLanes[] - Pointer to 4 states, 16 words each
+//
+//*****************************************************************************
+TARGET_AVX2 void
+FLanesAvx2(word_t* pwLanes) {
+  __m256i v[16];
+
+  avx2LoadLanes(pwLanes, v);
+  LANE_F(v, avx2H, _mm256_xor_si256, avx2Rot);
+  avx2StoreLanes(pwLanes, v);
+}
+
+//*****************************************************************************
+//
+// Function -> FLanesAvx512
+// Purpose -> F permutation on four states at once using AVX-512VL rotates
+// Input -> word_t* pwLanes[] - Pointer to 4 states, 16 words each
+//
+//*****************************************************************************
+TARGET_AVX512 void
+FLanesAvx512(word_t* pwLanes) {
+  __m256i v[16];
+
+  avx2LoadLanes(pwLanes, v);
+  LANE_F(v, avx512H, _mm256_xor_si256, avx512Rot);
+  avx2StoreLanes(pwLanes, v);
+}
+
+//*****************************************************************************
+// 512 bit helpers for the batch kernel, eight lanes per register
+//*****************************************************************************
+TARGET_AVX512 static inline __m512i
+zmmH(__m512i x, __m512i y) {
+  return _mm512_ternarylogic_epi64(x, y,
+                                   _mm512_slli_epi64(_mm512_and_si512(x, y), 1),
+                                   0x96);
+}
+
+TARGET_AVX512 static inline __m512i
+zmmRot(__m512i x, const int shift) {
+  return _mm512_ror_epi64(x, shift);
+}
+
+//*****************************************************************************
+//
+// Function -> FBatchSse2 / FBatchAvx2 / FBatchAvx512
+// Purpose -> F permutation on a batch of 8 states, 2, 4 or all 8 lanes per
+//            register
+// Input -> word_t* pwBatch[] - 16 rows of BATCH_LANES words
+//
+//*****************************************************************************
+TARGET_SSE2 void
+FBatchSse2(word_t* pwBatch) {
+  BATCH_F(pwBatch, __m128i, _mm_loadu_si128, _mm_storeu_si128,
+          sse2H, _mm_xor_si128, sse2Rot);
+}
+
+TARGET_AVX2 void
+FBatchAvx2(word_t* pwBatch) {
+  BATCH_F(pwBatch, __m256i, _mm256_loadu_si256, _mm256_storeu_si256,
+          avx2H, _mm256_xor_si256, avx2Rot);
+}
+
+TARGET_AVX512 void
+FBatchAvx512(word_t* pwBatch) {
+  BATCH_F(pwBatch, __m512i, _mm512_loadu_si512, _mm512_storeu_si512,
+          zmmH, _mm512_xor_si512, zmmRot);
+}
+
+#endif // WORD_LEN == 32
+
+//*****************************************************************************
+//
+// Function -> xgetbv0
+// Purpose -> Read XCR0 to see which register files the OS saves
+//
+//*****************************************************************************
+static uint64_t
+xgetbv0(void) {
+  uint32_t lo;
+  uint32_t hi;
+
+  __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return ((uint64_t)hi << 32) | lo;
+}
+
+//*****************************************************************************
+//
+// Function -> probeKernels
+// Purpose -> Use cpuid and XCR0 to find the kernels this CPU and OS can run
+// Returns -> Bit mask with one bit per kernel ID
+//
+//*****************************************************************************
+static uint32_t
+probeKernels(void) {
+  uint32_t mask = 1u << KERNEL_SCALAR;
+  uint32_t eax;
+  uint32_t ebx;
+  uint32_t ecx;
+  uint32_t edx;
+  uint64_t xcr0;
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return mask;
+  }
+  if (edx & bit_SSE2) {
+    mask |= 1u << KERNEL_SSE2;
+  }
+
+  //
+  // AVX state has to be enabled by the OS before any VEX code runs
+  //
+  if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+    return mask;
+  }
+  xcr0 = xgetbv0();
+  if ((xcr0 & 0x6) != 0x6) {
+    return mask;
+  }
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return mask;
+  }
+  if (ebx & bit_AVX2) {
+    mask |= 1u << KERNEL_AVX2;
+  }
+
+  //
+  // AVX-512 also needs the opmask and upper ZMM state enabled
+  //
+  if ((xcr0 & 0xE6) == 0xE6 && (ebx & bit_AVX2) &&
+      (ebx & bit_AVX512F) && (ebx & bit_AVX512VL)) {
+    mask |= 1u << KERNEL_AVX512;
+  }
+
+  return mask;
+}
+
+#else
+
+static uint32_t
+probeKernels(void) {
+  return 1u << KERNEL_SCALAR;
+}
+
+#endif // NORX_X86
+
+//*****************************************************************************
+//
+// Function -> NORXKernelSupported
+// Purpose -> Check if a kernel can run on this CPU
+// Inputs -> uint32_t kernel - KERNEL_xxx ID
+//
+//*****************************************************************************
+bool
+NORXKernelSupported(uint32_t kernel) {
+  if (kernelMask == 0) {
+    kernelMask = probeKernels();
+  }
+  return kernel < KERNEL_COUNT && (kernelMask & (1u << kernel)) != 0;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSetKernel
+// Purpose -> Point F() at the given kernel
+// Inputs -> uint32_t kernel - KERNEL_xxx ID
+// Returns -> false if the CPU can not run that kernel, F() is left alone
+//
+//*****************************************************************************
+bool
+NORXSetKernel(uint32_t kernel) {
+  if (!NORXKernelSupported(kernel)) {
+    return false;
+  }
+
+  switch (kernel) {
+#ifdef NORX_X86
+    case KERNEL_SSE2:
+      pfnPermute = FSse2;
+      pfnPermuteLanes = FLanesSse2;
+      pfnPermuteBatch = FBatchSse2;
+      laneWidth = 128 / WORD_LEN;
+      break;
+    case KERNEL_AVX2:
+      pfnPermute = FAvx2;
+      pfnPermuteLanes = FLanesAvx2;
+      pfnPermuteBatch = FBatchAvx2;
+      laneWidth = 4;
+      break;
+    case KERNEL_AVX512:
+      pfnPermute = FAvx512;
+      pfnPermuteLanes = FLanesAvx512;
+      pfnPermuteBatch = FBatchAvx512;
+      laneWidth = 4;
+      break;
+#endif
+    default:
+      pfnPermute = FScalar;
+      pfnPermuteLanes = FScalar;
+      pfnPermuteBatch = FBatchScalar;
+      laneWidth = 1;
+      break;
+  }
+  curKernel = kernel;
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> FLanes
+// Purpose -> Run F on several independent states, as many per call of the
+//            lane kernel as it holds and the rest one at a time
+// Inputs -> word_t* pwLanes[] - Pointer to the states, 16 words each
+//           uint32_t lanes - Number of states
+//
+//*****************************************************************************
+void
+FLanes(word_t* pwLanes, uint32_t lanes) {
+  uint32_t i = 0;
+
+  if (laneWidth > 1) {
+    for (; i + laneWidth <= lanes; i += laneWidth) {
+      pfnPermuteLanes(pwLanes + 16 * i);
+    }
+  }
+  for (; i < lanes; i++) {
+    pfnPermute(pwLanes + 16 * i);
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> NORXSelectKernel
+// Purpose -> Point F() at the fastest kernel this CPU supports
+// Returns -> KERNEL_xxx ID that was picked
+//
+//*****************************************************************************
+uint32_t
+NORXSelectKernel(void) {
+  uint32_t kernel;
+
+  for (kernel = KERNEL_COUNT - 1; kernel > KERNEL_SCALAR; kernel--) {
+    if (NORXSetKernel(kernel)) {
+      return kernel;
+    }
+  }
+  NORXSetKernel(KERNEL_SCALAR);
+
+  return KERNEL_SCALAR;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKernel
+// Purpose -> KERNEL_xxx ID F() currently runs through
+//
+//*****************************************************************************
+uint32_t
+NORXKernel(void) {
+  return curKernel;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXLaneWidth
+// Purpose -> States pfnPermuteLanes runs per call, 1 if it is just F
+//
+//*****************************************************************************
+uint32_t
+NORXLaneWidth(void) {
+  return laneWidth;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXKernelName
+// Purpose -> Printable name of a kernel ID
+// Inputs -> uint32_t kernel - KERNEL_xxx ID
+//
+//*****************************************************************************
+const char*
+NORXKernelName(uint32_t kernel) {
+  if (kernel >= KERNEL_COUNT) {
+    return "unknown";
+  }
+  return kernelNames[kernel];
+}
+
+//*****************************************************************************
+//
+// Function -> selectAtStartup
+// Purpose -> Run the cpuid check before main() so F() is fast from the
+//            first call. Without GCC style constructors call
+//            NORXSelectKernel() by hand, F() stays scalar until then.
+//
+//*****************************************************************************
+#ifdef __GNUC__
+__attribute__((constructor)) static void
+selectAtStartup(void) {
+  NORXSelectKernel();
+}
+#endif
@@ -0,0 +1,73 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_simd.h                                                         *
+* Purpose -> Prototypes for the SIMD F permutation kernels and the cpuid      *
+*            based dispatch that picks one of them at startup                 *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - SSE2, AVX2 and AVX-512 Row Kernels              *
+*            2.0 10/17/2026 - Lane Kernels for the Parallel Modes             *
+*            3.0 10/17/2026 - Batch Kernels for Independent Messages          *
+*            4.0 10/17/2026 - Lane Width of the Current Kernel                *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_SIMD_H
+#define NORX_SIMD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Kernel IDs, ordered from slowest to fastest
+//*****************************************************************************
+#define KERNEL_SCALAR   0
+#define KERNEL_SSE2     1
+#define KERNEL_AVX2     2
+#define KERNEL_AVX512   3
+#define KERNEL_COUNT    4
+
+//*****************************************************************************
+// States in one batch, a 512 bit register of words. A batch is stored word
+// per row: word i of lane j is at [i * BATCH_LANES + j].
+//*****************************************************************************
+#define BATCH_LANES     (512 / WORD_LEN)
+#define BATCH_WORDS     (16 * BATCH_LANES)
+
+//*****************************************************************************
+// Kernel function type and the kernel F() currently runs through
+//*****************************************************************************
+typedef void (*permute_t)(word_t* pwS);
+
+extern permute_t pfnPermute;
+extern permute_t pfnPermuteLanes;
+extern permute_t pfnPermuteBatch;
+
+//*****************************************************************************
+// Dispatch Prototypes
+//*****************************************************************************
+extern uint32_t NORXSelectKernel(void);
+extern bool NORXSetKernel(uint32_t kernel);
+extern bool NORXKernelSupported(uint32_t kernel);
+extern uint32_t NORXKernel(void);
+extern uint32_t NORXLaneWidth(void);
+extern const char* NORXKernelName(uint32_t kernel);
+extern void FLanes(word_t* pwLanes, uint32_t lanes);
+
+//*****************************************************************************
+// Kernel Prototypes, only callable when NORXKernelSupported() says so. Lane
+// kernels take 4 states, except 64 bit SSE2 which takes 2
+//*****************************************************************************
+extern void FSse2(word_t* pwS);
+extern void FAvx2(word_t* pwS);
+extern void FAvx512(word_t* pwS);
+extern void FLanesSse2(word_t* pwLanes);
+extern void FLanesAvx2(word_t* pwLanes);
+extern void FLanesAvx512(word_t* pwLanes);
+extern void FBatchScalar(word_t* pwBatch);
+extern void FBatchSse2(word_t* pwBatch);
+extern void FBatchAvx2(word_t* pwBatch);
+extern void FBatchAvx512(word_t* pwBatch);
+
+#endif // NORX_SIMD_H
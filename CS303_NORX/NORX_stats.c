@@ -0,0 +1,330 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_stats.c                                                        *
+* Purpose -> Per thread counters behind the NORX_stats.h hooks                *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Hot Path Instrumentation                        *
+*            2.0 10/17/2026 - Reset by Baseline, Blocks on Whole Lines        *
+*            3.0 10/17/2026 - DRBG Domains Counted on Their Own               *
+*                                                                             *
+* Every thread that counts gets a block of counters of its own the first      *
+* time it does, so the hot path never shares a cache line or takes a lock.    *
+* Each counter has one writer and is updated with relaxed loads and stores,   *
+* which are plain moves, so a snapshot from another thread reads whole        *
+* values. Blocks are linked into a list under a lock, a snapshot walks it.    *
+* Only the owner ever stores to its counters. A reset instead records what    *
+* each counter reads as its baseline under the lock, and snapshots report     *
+* counts past the baseline, so no count is lost to a reset. Blocks are        *
+* cache line aligned and padded to whole lines. When a thread exits its       *
+* counts are added to the retired totals and its block is kept for the        *
+* next new thread.                                                            *
+*                                                                             *
+* Build -> needs -pthread, counts only with -DNORX_STATS                      *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <pthread.h>   // Thread exit hook, list lock
+#include <stdatomic.h> // Single writer counters
+#include <stdbool.h>   // bool types
+#include <stdint.h>    // uintXX_t types
+#include <stdlib.h>    // aligned_alloc
+#include <string.h>    // memset
+#include <time.h>      // clock_gettime
+
+#include "NORX.h"       // Domain constants
+#include "NORX_stats.h" // Counter types and prototypes
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <x86intrin.h>
+  #define STATS_TSC  0x1
+#endif
+
+//*****************************************************************************
+// Names for reports
+//*****************************************************************************
+static const char* const phaseNames[STAT_PHASES] = {
+  "initialise", "absorb", "branch", "encrypt", "decrypt", "merge", "finalise"
+};
+static const char* const domainNames[STAT_DOMAINS] = {
+  "header", "payload", "trailer", "tag", "branch", "merge", "drbg"
+};
+
+//*****************************************************************************
+//
+// Function -> NORXStatsPhaseName / NORXStatsDomainName
+// Purpose -> Name of a phase or domain index, "?" past the end
+//
+//*****************************************************************************
+const char*
+NORXStatsPhaseName(uint32_t phase) {
+  return (phase < STAT_PHASES) ? phaseNames[phase] : "?";
+}
+
+const char*
+NORXStatsDomainName(uint32_t domain) {
+  return (domain < STAT_DOMAINS) ? domainNames[domain] : "?";
+}
+
+#ifdef NORX_STATS
+
+//*****************************************************************************
+// One thread's counters, the same layout as norx_stats_t
+//*****************************************************************************
+#define STAT_COUNTERS  (3 * STAT_PHASES + 3 * STAT_DOMAINS)
+#define CACHE_LINE     64
+
+typedef struct stats_block_s {
+  _Alignas(CACHE_LINE) _Atomic uint64_t c[STAT_COUNTERS];
+  _Alignas(CACHE_LINE) uint64_t base[STAT_COUNTERS];  // At the last reset
+  struct stats_block_s* pNext;    // Every block
+  struct stats_block_s* pFree;    // Blocks of exited threads
+  bool live;
+} stats_block_t;
+
+#define PHASE_CALLS(p)    (3 * (p))
+#define PHASE_PERMS(p)    (3 * (p) + 1)
+#define PHASE_TICKS(p)    (3 * (p) + 2)
+#define DOMAIN_PERMS(d)   (3 * STAT_PHASES + 3 * (d))
+#define DOMAIN_BLOCKS(d)  (3 * STAT_PHASES + 3 * (d) + 1)
+#define DOMAIN_BYTES(d)   (3 * STAT_PHASES + 3 * (d) + 2)
+
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t statsOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t statsKey;
+static stats_block_t* pBlocks;
+static stats_block_t* pFreeBlocks;
+static uint64_t retired[STAT_COUNTERS];
+static _Thread_local stats_block_t* pMine;
+
+//*****************************************************************************
+//
+// Function -> add
+// Purpose -> Bump a counter only this thread writes
+//
+//*****************************************************************************
+static inline void
+add(_Atomic uint64_t* pC, uint64_t v) {
+  atomic_store_explicit(pC, atomic_load_explicit(pC, memory_order_relaxed) + v,
+                        memory_order_relaxed);
+}
+
+//*****************************************************************************
+//
+// Function -> threadExit
+// Purpose -> Fold an exiting thread's counts into the retired totals and
+//            keep its block for reuse
+//
+//*****************************************************************************
+static void
+threadExit(void* pArg) {
+  stats_block_t* pB = (stats_block_t*)pArg;
+  uint32_t i;
+
+  pthread_mutex_lock(&statsLock);
+  for (i = 0; i < STAT_COUNTERS; i++) {
+    retired[i] += atomic_load_explicit(&pB->c[i], memory_order_relaxed) -
+                  pB->base[i];
+    atomic_store_explicit(&pB->c[i], 0, memory_order_relaxed);
+    pB->base[i] = 0;
+  }
+  pB->live = false;
+  pB->pFree = pFreeBlocks;
+  pFreeBlocks = pB;
+  pthread_mutex_unlock(&statsLock);
+  pMine = NULL;
+}
+
+static void
+makeKey(void) {
+  pthread_key_create(&statsKey, threadExit);
+}
+
+//*****************************************************************************
+//
+// Function -> mine
+// Purpose -> This thread's block, set up on first use. NULL if there is no
+//            memory for one, the counts are then dropped.
+//
+//*****************************************************************************
+static stats_block_t*
+mine(void) {
+  stats_block_t* pB;
+
+  if (pMine != NULL) {
+    return pMine;
+  }
+
+  pthread_once(&statsOnce, makeKey);
+  pthread_mutex_lock(&statsLock);
+  pB = pFreeBlocks;
+  if (pB != NULL) {
+    pFreeBlocks = pB->pFree;
+  }
+  else {
+    pB = (stats_block_t*)aligned_alloc(CACHE_LINE, sizeof(*pB));
+    if (pB != NULL) {
+      memset(pB, 0, sizeof(*pB));
+      pB->pNext = pBlocks;
+      pBlocks = pB;
+    }
+  }
+  if (pB != NULL) {
+    pB->live = true;
+  }
+  pthread_mutex_unlock(&statsLock);
+
+  if (pB != NULL) {
+    pthread_setspecific(statsKey, pB);
+  }
+  pMine = pB;
+  return pB;
+}
+
+//*****************************************************************************
+//
+// Function -> statsNow
+// Purpose -> Tick counter the phases are timed with
+//
+//*****************************************************************************
+uint64_t
+statsNow(void) {
+#ifdef STATS_TSC
+  return __rdtsc();
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+//*****************************************************************************
+//
+// Function -> statsPhase
+// Purpose -> Close a phase opened at t0 that ran perms F calls
+//
+//*****************************************************************************
+void
+statsPhase(uint32_t phase, uint64_t perms, uint64_t t0) {
+  uint64_t t1 = statsNow();
+  stats_block_t* pB = mine();
+
+  if (pB == NULL) {
+    return;
+  }
+  add(&pB->c[PHASE_CALLS(phase)], 1);
+  add(&pB->c[PHASE_PERMS(phase)], perms);
+  add(&pB->c[PHASE_TICKS(phase)], t1 - t0);
+}
+
+//*****************************************************************************
+//
+// Function -> statsDomain
+// Purpose -> Add work done under a *_DOMAIN constant, the DRBG's ones
+//            all under STAT_DOMAIN_DRBG
+//
+//*****************************************************************************
+void
+statsDomain(uint32_t domain, uint64_t perms, uint64_t blocks, uint64_t bytes) {
+  stats_block_t* pB = mine();
+  uint32_t d = 0;
+
+  while (d < STAT_DOMAIN_DRBG && (domain >> d) > 1) {
+    d++;
+  }
+  if (pB == NULL) {
+    return;
+  }
+  add(&pB->c[DOMAIN_PERMS(d)], perms);
+  add(&pB->c[DOMAIN_BLOCKS(d)], blocks);
+  add(&pB->c[DOMAIN_BYTES(d)], bytes);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStatsSnapshot
+// Purpose -> Sum the retired totals and every live thread's counters
+// Inputs -> norx_stats_t* pStats - Filled with the sums
+// Returns -> true
+//
+//*****************************************************************************
+bool
+NORXStatsSnapshot(norx_stats_t* pStats) {
+  uint64_t sum[STAT_COUNTERS];
+  stats_block_t* pB;
+  uint32_t i;
+
+  memset(pStats, 0, sizeof(*pStats));
+  pthread_mutex_lock(&statsLock);
+  memcpy(sum, retired, sizeof(sum));
+  for (pB = pBlocks; pB != NULL; pB = pB->pNext) {
+    for (i = 0; i < STAT_COUNTERS; i++) {
+      sum[i] += atomic_load_explicit(&pB->c[i], memory_order_relaxed) -
+                pB->base[i];
+    }
+    pStats->threads += pB->live ? 1 : 0;
+  }
+  pthread_mutex_unlock(&statsLock);
+
+  for (i = 0; i < STAT_PHASES; i++) {
+    pStats->phase[i].calls = sum[PHASE_CALLS(i)];
+    pStats->phase[i].perms = sum[PHASE_PERMS(i)];
+    pStats->phase[i].ticks = sum[PHASE_TICKS(i)];
+  }
+  for (i = 0; i < STAT_DOMAINS; i++) {
+    pStats->domain[i].perms = sum[DOMAIN_PERMS(i)];
+    pStats->domain[i].blocks = sum[DOMAIN_BLOCKS(i)];
+    pStats->domain[i].bytes = sum[DOMAIN_BYTES(i)];
+  }
+#ifdef STATS_TSC
+  pStats->tsc = true;
+#endif
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStatsReset
+// Purpose -> Zero the retired totals and move every thread's baseline up to
+//            its counters. The owners keep counting, none of them is
+//            stored to from here
+//
+//*****************************************************************************
+void
+NORXStatsReset(void) {
+  stats_block_t* pB;
+  uint32_t i;
+
+  pthread_mutex_lock(&statsLock);
+  memset(retired, 0, sizeof(retired));
+  for (pB = pBlocks; pB != NULL; pB = pB->pNext) {
+    for (i = 0; i < STAT_COUNTERS; i++) {
+      pB->base[i] = atomic_load_explicit(&pB->c[i], memory_order_relaxed);
+    }
+  }
+  pthread_mutex_unlock(&statsLock);
+}
+
+#else
+
+//*****************************************************************************
+//
+// Function -> NORXStatsSnapshot / NORXStatsReset
+// Purpose -> Built without NORX_STATS, there is nothing to report
+//
+//*****************************************************************************
+bool
+NORXStatsSnapshot(norx_stats_t* pStats) {
+  memset(pStats, 0, sizeof(*pStats));
+  return false;
+}
+
+void
+NORXStatsReset(void) {
+}
+
+#endif
@@ -0,0 +1,107 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_stats.h                                                        *
+* Purpose -> Optional per phase and per domain counters for the core NORX     *
+*            functions, kept per thread and summed on demand                  *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Hot Path Instrumentation                        *
+*            2.0 10/17/2026 - Reset Loses No Counts                           *
+*            3.0 10/17/2026 - DRBG Domains Counted on Their Own               *
+*            4.0 10/17/2026 - Domain Counts Made Wherever the Work Is Done    *
+*                                                                             *
+* Build -> -DNORX_STATS turns the counters on, NORX_stats.c must then be      *
+* linked in. Without it the hooks compile to nothing and NORXStatsSnapshot()  *
+* returns false.                                                              *
+*                                                                             *
+* Phase counts come from the phase functions in NORX.c only. Domain counts    *
+* come from the block helpers and from every loop that runs its own F, the    *
+* stream, MAC, pool, batch and session ones included, so they cover every     *
+* path a message can take.                                                    *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_STATS_H
+#define NORX_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//*****************************************************************************
+// Phases, one per core function. initialise() and initialiseKey() are both
+// STAT_INIT.
+//*****************************************************************************
+#define STAT_INIT       0
+#define STAT_ABSORB     1
+#define STAT_BRANCH     2
+#define STAT_ENCRYPT    3
+#define STAT_DECRYPT    4
+#define STAT_MERGE      5
+#define STAT_FINALISE   6
+#define STAT_PHASES     7
+
+//*****************************************************************************
+// Domains, indexed by the bit the *_DOMAIN constant sets: header, payload,
+// trailer, tag, branch, merge. Every domain past MERGE_DOMAIN is one of
+// NORX_drbg.h's and they share the last bucket.
+//*****************************************************************************
+#define STAT_DOMAIN_DRBG  6
+#define STAT_DOMAINS      7
+
+//*****************************************************************************
+// Counts summed over every thread. Ticks are TSC cycles where tsc is set,
+// steady clock ns otherwise.
+//*****************************************************************************
+typedef struct {
+  uint64_t calls;             // Calls that did work
+  uint64_t perms;             // F calls, one per lane for FLanes()
+  uint64_t ticks;             // Time inside the phase
+} norx_phase_stats_t;
+
+typedef struct {
+  uint64_t perms;             // F calls under the domain
+  uint64_t blocks;            // Rate blocks, the padded last one included
+  uint64_t bytes;             // Caller bytes, TAG_BYTES per tag
+} norx_domain_stats_t;
+
+typedef struct {
+  norx_phase_stats_t phase[STAT_PHASES];
+  norx_domain_stats_t domain[STAT_DOMAINS];
+  uint32_t threads;           // Threads that have counted and still run
+  bool tsc;
+} norx_stats_t;
+
+//*****************************************************************************
+// Stats Prototypes
+//
+// NORXStatsSnapshot() - Sum every thread's counters, threads that have
+//                       exited included. false if built without NORX_STATS.
+// NORXStatsReset() - Start every count again from 0. Counts made after it
+//                    are all kept, even while other threads are running
+// NORXStatsPhaseName() / NORXStatsDomainName() - Names for reports
+//*****************************************************************************
+extern bool NORXStatsSnapshot(norx_stats_t* pStats);
+extern void NORXStatsReset(void);
+extern const char* NORXStatsPhaseName(uint32_t phase);
+extern const char* NORXStatsDomainName(uint32_t domain);
+
+//*****************************************************************************
+// Hooks. STATS_START() opens a phase and STATS_PHASE() closes it, both in
+// NORX.c. STATS_DOMAIN() adds work done under one domain, wherever it is.
+//*****************************************************************************
+#ifdef NORX_STATS
+  extern uint64_t statsNow(void);
+  extern void statsPhase(uint32_t phase, uint64_t perms, uint64_t t0);
+  extern void statsDomain(uint32_t domain, uint64_t perms, uint64_t blocks,
+                          uint64_t bytes);
+
+  #define STATS_START(t0)                    uint64_t t0 = statsNow()
+  #define STATS_PHASE(phase, perms, t0)      statsPhase(phase, perms, t0)
+  #define STATS_DOMAIN(dom, perms, blocks, bytes)                          \
+    statsDomain(dom, perms, blocks, bytes)
+#else
+  #define STATS_START(t0)
+  #define STATS_PHASE(phase, perms, t0)
+  #define STATS_DOMAIN(dom, perms, blocks, bytes)
+#endif
+
+#endif // NORX_STATS_H
@@ -0,0 +1,605 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_stream.c                                                       *
+* Purpose -> Streaming NORX, header, payload and trailer bytes can arrive in  *
+*            pieces of any length and the payload is encrypted as it comes    *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Init/Update/Final Streaming API                 *
+*            2.0 10/17/2026 - Init from a Key Schedule                        *
+*            3.0 10/17/2026 - Checkpoint and Restore                          *
+*            4.0 10/17/2026 - NORX_STATS Counts for the Open Block            *
+*            5.0 10/17/2026 - Final with the Tag Checked by tagMatch()        *
+*                                                                             *
+* A rate block is opened (domain XOR and F) when its first byte arrives, so   *
+* the key stream for it is ready and every byte is turned around at once.     *
+* Whole blocks at the open block boundary go through the byte block loops     *
+* in NORX.c without being copied. A phase is closed by padding its open       *
+* block, or an empty one if it ended on a block boundary, like the one shot   *
+* functions do.                                                               *
+*                                                                             *
+* Because the open block lives in the state there is no block buffer, and a   *
+* checkpoint is just the counters and the state words that are live: S in     *
+* the header and trailer, the lane states while the payload runs.             *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <string.h>    // memcmp, memcpy, memset
+
+#include "NORX.h"        // NORX defines and prototypes
+#include "NORX_stats.h"  // Domain counters
+#include "NORX_simd.h"   // FLanes()
+#include "NORX_stream.h" // Stream context and prototypes
+
+//*****************************************************************************
+//
+// Function -> rateByte / xorRateByte
+// Purpose -> Byte n of the rate is byte n % WORD_BYTES of word
+//            n / WORD_BYTES, little endian like loadWord()
+//
+//*****************************************************************************
+static inline uint8_t
+rateByte(const word_t* pwS, uint32_t pos) {
+  return (uint8_t)(pwS[pos / WORD_BYTES] >> (8 * (pos % WORD_BYTES)));
+}
+
+static inline void
+xorRateByte(word_t* pwS, uint32_t pos, uint8_t b) {
+  pwS[pos / WORD_BYTES] ^= (word_t)b << (8 * (pos % WORD_BYTES));
+}
+
+//*****************************************************************************
+//
+// Function -> openPayloadBlock
+// Purpose -> Start the next payload block on its lane
+// Returns -> The lane state the block is on
+//
+//*****************************************************************************
+static word_t*
+openPayloadBlock(norx_stream_t* pCtx) {
+  word_t* pwS = pCtx->Sbar + 16 * (pCtx->blocks % PARALLEL);
+
+  STATS_DOMAIN(PAYLOAD_DOMAIN, 1, 1, 0);
+  pwS[15] ^= PAYLOAD_DOMAIN;
+  F(pwS);
+  pCtx->blocks++;
+  pCtx->pos = 0;
+
+  return pwS;
+}
+
+//*****************************************************************************
+//
+// Function -> padBlock
+// Purpose -> 10*1 padding on the open block of pwS, opening an empty one
+//            first if the phase ended on a block boundary
+//
+//*****************************************************************************
+static void
+padBlock(norx_stream_t* pCtx, word_t* pwS, uint32_t domain) {
+  if (pCtx->pos == RATE_BYTES) {
+    STATS_DOMAIN(domain, 1, 1, 0);
+    pwS[15] ^= domain;
+    F(pwS);
+    pCtx->pos = 0;
+  }
+  pad(pwS, pCtx->pos);
+  pCtx->pos = RATE_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> closePhase
+// Purpose -> Pad the last block of the current phase, merging the lanes at
+//            the end of the payload, and move to the next phase. Empty
+//            phases leave the state alone.
+//
+//*****************************************************************************
+static void
+closePhase(norx_stream_t* pCtx) {
+  word_t* pwS;
+
+  switch (pCtx->phase) {
+    case STREAM_HEADER:
+      if (pCtx->len[STREAM_HEADER] > 0) {
+        padBlock(pCtx, pCtx->S, HEADER_DOMAIN);
+      }
+      break;
+    case STREAM_PAYLOAD:
+      if (pCtx->len[STREAM_PAYLOAD] > 0) {
+        if (pCtx->pos == RATE_BYTES) {
+          pwS = openPayloadBlock(pCtx);
+        }
+        else {
+          pwS = pCtx->Sbar + 16 * ((pCtx->blocks - 1) % PARALLEL);
+        }
+        padBlock(pCtx, pwS, PAYLOAD_DOMAIN);
+        merge(pCtx->Sbar, pCtx->S, 1, MERGE_DOMAIN);
+      }
+      break;
+    case STREAM_TRAILER:
+      if (pCtx->len[STREAM_TRAILER] > 0) {
+        padBlock(pCtx, pCtx->S, TRAILER_DOMAIN);
+      }
+      break;
+    default:
+      break;
+  }
+
+  pCtx->pos = RATE_BYTES;
+  pCtx->phase++;
+}
+
+//*****************************************************************************
+//
+// Function -> enterPhase
+// Purpose -> Close every phase before the one asked for
+// Returns -> false if the stream is already past it
+//
+//*****************************************************************************
+static bool
+enterPhase(norx_stream_t* pCtx, uint32_t phase) {
+  if (pCtx->phase > phase) {
+    return false;
+  }
+  while (pCtx->phase < phase) {
+    closePhase(pCtx);
+  }
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> absorbBytes
+// Purpose -> Absorb header or trailer bytes into the main state
+//
+//*****************************************************************************
+static void
+absorbBytes(norx_stream_t* pCtx, const uint8_t* pIn, size_t len,
+            uint32_t domain) {
+  size_t blocks;
+
+  pCtx->len[pCtx->phase] += len;
+
+  //
+  // Top up the open block
+  //
+  STATS_DOMAIN(domain, 0, 0, (len < RATE_BYTES - pCtx->pos) ?
+               len : RATE_BYTES - pCtx->pos);
+  while (len > 0 && pCtx->pos < RATE_BYTES) {
+    xorRateByte(pCtx->S, pCtx->pos++, *pIn++);
+    len--;
+  }
+
+  //
+  // Whole blocks straight from the input
+  //
+  blocks = len / RATE_BYTES;
+  absorbBlocks(pCtx->S, pIn, blocks, domain);
+  pIn += blocks * RATE_BYTES;
+  len -= blocks * RATE_BYTES;
+
+  //
+  // Open a block for what is left
+  //
+  if (len > 0) {
+    STATS_DOMAIN(domain, 1, 1, len);
+    pCtx->S[15] ^= domain;
+    F(pCtx->S);
+    pCtx->pos = 0;
+    while (len > 0) {
+      xorRateByte(pCtx->S, pCtx->pos++, *pIn++);
+      len--;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> cryptBytes
+// Purpose -> Encrypt or decrypt payload bytes, branching the lanes on the
+//            first one. pOut may be pIn.
+//
+//*****************************************************************************
+static void
+cryptBytes(norx_stream_t* pCtx, const uint8_t* pIn, size_t len, uint8_t* pOut,
+           bool dec) {
+  word_t* pwS;
+  size_t blocks;
+  uint8_t b;
+
+  if (len == 0) {
+    return;
+  }
+  if (pCtx->len[STREAM_PAYLOAD] == 0) {
+    branch(pCtx->S, pCtx->Sbar, 1, BRANCH_DOMAIN);
+  }
+  pCtx->len[STREAM_PAYLOAD] += len;
+
+  //
+  // Top up the open block
+  //
+  pwS = pCtx->Sbar + 16 * ((pCtx->blocks + PARALLEL - 1) % PARALLEL);
+  STATS_DOMAIN(PAYLOAD_DOMAIN, 0, 0, (len < RATE_BYTES - pCtx->pos) ?
+               len : RATE_BYTES - pCtx->pos);
+  while (len > 0 && pCtx->pos < RATE_BYTES) {
+    b = *pIn++;
+    if (dec) {
+      b ^= rateByte(pwS, pCtx->pos);
+      xorRateByte(pwS, pCtx->pos, b);
+    }
+    else {
+      xorRateByte(pwS, pCtx->pos, b);
+      b = rateByte(pwS, pCtx->pos);
+    }
+    *pOut++ = b;
+    pCtx->pos++;
+    len--;
+  }
+
+  //
+  // Whole blocks straight from and to the caller's buffers
+  //
+  blocks = len / RATE_BYTES;
+  if (dec) {
+    decryptBlocks(pCtx->Sbar, pCtx->blocks, pIn, blocks, PAYLOAD_DOMAIN, pOut);
+  }
+  else {
+    encryptBlocks(pCtx->Sbar, pCtx->blocks, pIn, blocks, PAYLOAD_DOMAIN, pOut);
+  }
+  pCtx->blocks += blocks;
+  pIn += blocks * RATE_BYTES;
+  pOut += blocks * RATE_BYTES;
+  len -= blocks * RATE_BYTES;
+
+  //
+  // Open a block for what is left
+  //
+  if (len > 0) {
+    pwS = openPayloadBlock(pCtx);
+    STATS_DOMAIN(PAYLOAD_DOMAIN, 0, 0, len);
+    while (len > 0) {
+      b = *pIn++;
+      if (dec) {
+        b ^= rateByte(pwS, pCtx->pos);
+        xorRateByte(pwS, pCtx->pos, b);
+      }
+      else {
+        xorRateByte(pwS, pCtx->pos, b);
+        b = rateByte(pwS, pCtx->pos);
+      }
+      *pOut++ = b;
+      pCtx->pos++;
+      len--;
+    }
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamInit
+// Purpose -> Set up a stream for one message
+// Inputs -> norx_stream_t* pCtx - Context to set up
+//           const uint8_t* pK - Key, KEY_BYTES
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//
+//*****************************************************************************
+void
+NORXStreamInit(norx_stream_t* pCtx, const uint8_t* pK, const uint8_t* pN) {
+  norx_key_t key;
+
+  NORXKeyInit(&key, pK);
+  NORXStreamInitKey(pCtx, &key, pN);
+  NORXKeyWipe(&key);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamInitKey
+// Purpose -> Set up a stream for one message under a key schedule, only the
+//            nonce is new
+// Inputs -> norx_stream_t* pCtx - Context to set up
+//           const norx_key_t* pKey - Key schedule from NORXKeyInit()
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//
+//*****************************************************************************
+void
+NORXStreamInitKey(norx_stream_t* pCtx, const norx_key_t* pKey,
+                  const uint8_t* pN) {
+  uint32_t i;
+
+  initialiseKey(pKey, pN, pCtx->S);
+  for (i = 0; i < 4; i++) {
+    pCtx->K[i] = pKey->K[i];
+  }
+
+  for (i = 0; i < 3; i++) {
+    pCtx->len[i] = 0;
+  }
+  pCtx->blocks = 0;
+  pCtx->phase = STREAM_HEADER;
+  pCtx->pos = RATE_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamHeader
+// Purpose -> Absorb more header bytes
+// Inputs -> norx_stream_t* pCtx - Stream
+//           const uint8_t* pA, len - Header bytes
+// Returns -> false if the payload or trailer was started already
+//
+//*****************************************************************************
+bool
+NORXStreamHeader(norx_stream_t* pCtx, const uint8_t* pA, size_t len) {
+  if (!enterPhase(pCtx, STREAM_HEADER)) {
+    return false;
+  }
+  absorbBytes(pCtx, pA, len, HEADER_DOMAIN);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamEncrypt
+// Purpose -> Encrypt more payload bytes, the cipher text for all of them is
+//            written before returning
+// Inputs -> norx_stream_t* pCtx - Stream
+//           const uint8_t* pM, len - Message bytes
+//           uint8_t* pC - Cipher text, len bytes, may be pM
+// Returns -> false if the trailer was started already
+//
+//*****************************************************************************
+bool
+NORXStreamEncrypt(norx_stream_t* pCtx, const uint8_t* pM, size_t len,
+                  uint8_t* pC) {
+  if (!enterPhase(pCtx, STREAM_PAYLOAD)) {
+    return false;
+  }
+  cryptBytes(pCtx, pM, len, pC, false);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamDecrypt
+// Purpose -> Decrypt more payload bytes
+// Inputs -> norx_stream_t* pCtx - Stream
+//           const uint8_t* pC, len - Cipher text bytes
+//           uint8_t* pM - Message, len bytes, may be pC
+// Returns -> false if the trailer was started already
+//
+//*****************************************************************************
+bool
+NORXStreamDecrypt(norx_stream_t* pCtx, const uint8_t* pC, size_t len,
+                  uint8_t* pM) {
+  if (!enterPhase(pCtx, STREAM_PAYLOAD)) {
+    return false;
+  }
+  cryptBytes(pCtx, pC, len, pM, true);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamTrailer
+// Purpose -> Absorb more trailer bytes
+// Inputs -> norx_stream_t* pCtx - Stream
+//           const uint8_t* pZ, len - Trailer bytes
+// Returns -> false if the stream was finalised already
+//
+//*****************************************************************************
+bool
+NORXStreamTrailer(norx_stream_t* pCtx, const uint8_t* pZ, size_t len) {
+  if (!enterPhase(pCtx, STREAM_TRAILER)) {
+    return false;
+  }
+  absorbBytes(pCtx, pZ, len, TRAILER_DOMAIN);
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamFinal
+// Purpose -> Close the stream and produce the tag, the context is wiped
+// Inputs -> norx_stream_t* pCtx - Stream
+//           uint8_t* pT - Tag, TAG_BYTES
+// Returns -> false if the stream was finalised already
+//
+//*****************************************************************************
+bool
+NORXStreamFinal(norx_stream_t* pCtx, uint8_t* pT) {
+  word_t tag[TAG_WORDS];
+  uint32_t i;
+
+  if (pCtx->phase == STREAM_DONE) {
+    return false;
+  }
+  enterPhase(pCtx, STREAM_DONE);
+
+  finalise(pCtx->S, pCtx->K, FINAL_DOMAIN, tag);
+  for (i = 0; i < TAG_WORDS; i++) {
+    storeWord(pT + i * WORD_BYTES, tag[i]);
+  }
+
+  wipe(tag, sizeof(tag));
+  wipe(pCtx, sizeof(*pCtx));
+  pCtx->phase = STREAM_DONE;
+
+  return true;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamFinalCheck
+// Purpose -> Close the stream and check its tag against a received one in
+//            constant time. The computed tag never leaves this function,
+//            it and the context are wiped.
+// Inputs -> norx_stream_t* pCtx - Stream
+//           const uint8_t* pT - Received tag, TAG_BYTES
+// Returns -> true if the tags match, false if they do not or the stream
+//            was finalised already
+//
+//*****************************************************************************
+bool
+NORXStreamFinalCheck(norx_stream_t* pCtx, const uint8_t* pT) {
+  word_t tag[TAG_WORDS];
+  bool ok;
+
+  if (pCtx->phase == STREAM_DONE) {
+    return false;
+  }
+  enterPhase(pCtx, STREAM_DONE);
+
+  finalise(pCtx->S, pCtx->K, FINAL_DOMAIN, tag);
+  ok = tagMatch(tag, pT);
+
+  wipe(tag, sizeof(tag));
+  wipe(pCtx, sizeof(*pCtx));
+  pCtx->phase = STREAM_DONE;
+
+  return ok;
+}
+
+//*****************************************************************************
+//
+// Function -> put64 / get64
+// Purpose -> Little endian integers in a checkpoint
+//
+//*****************************************************************************
+static void
+put64(uint8_t* p, uint64_t x) {
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    p[i] = (uint8_t)(x >> (8 * i));
+  }
+}
+
+static uint64_t
+get64(const uint8_t* p) {
+  uint64_t x = 0;
+  int i;
+
+  for (i = 7; i >= 0; i--) {
+    x = (x << 8) | p[i];
+  }
+  return x;
+}
+
+//*****************************************************************************
+//
+// Function -> lanesLive
+// Purpose -> true once the payload has branched the lanes and until they
+//            merge, only the lane states are live then
+//
+//*****************************************************************************
+static bool
+lanesLive(const norx_stream_t* pCtx) {
+  return pCtx->phase == STREAM_PAYLOAD && pCtx->len[STREAM_PAYLOAD] > 0;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamSave
+// Purpose -> Checkpoint a stream part way through
+// Inputs -> const norx_stream_t* pCtx - Stream, left as it is
+//           uint8_t* pOut - Checkpoint, up to STREAM_CKPT_BYTES
+// Returns -> Bytes written, 0 if the stream was finalised already
+//
+//*****************************************************************************
+size_t
+NORXStreamSave(const norx_stream_t* pCtx, uint8_t* pOut) {
+  const word_t* pwS;
+  uint32_t words;
+  uint32_t i;
+
+  if (pCtx->phase == STREAM_DONE) {
+    return 0;
+  }
+
+  memcpy(pOut, STREAM_CKPT_MAGIC, 8);
+  pOut[8] = WORD_LEN;
+  pOut[9] = RND_NUM;
+  pOut[10] = PARALLEL;
+  pOut[11] = (uint8_t)pCtx->phase;
+  for (i = 0; i < 4; i++) {
+    pOut[12 + i] = (uint8_t)(pCtx->pos >> (8 * i));
+  }
+  for (i = 0; i < 3; i++) {
+    put64(pOut + 16 + 8 * i, pCtx->len[i]);
+  }
+  put64(pOut + 40, pCtx->blocks);
+
+  pwS = lanesLive(pCtx) ? pCtx->Sbar : pCtx->S;
+  words = lanesLive(pCtx) ? LANES_WORDS : 16;
+  for (i = 0; i < words; i++) {
+    storeWord(pOut + STREAM_CKPT_FIXED + i * WORD_BYTES, pwS[i]);
+  }
+
+  return STREAM_CKPT_FIXED + (size_t)words * WORD_BYTES;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXStreamRestore
+// Purpose -> Set up a stream from a checkpoint
+// Inputs -> norx_stream_t* pCtx - Context to set up
+//           const norx_key_t* pKey - Key schedule the stream was started with
+//           const uint8_t* pIn - Checkpoint from NORXStreamSave()
+//           size_t len - Bytes in the checkpoint
+// Returns -> false if the checkpoint is not one this build wrote, pCtx is
+//            left alone then
+//
+//*****************************************************************************
+bool
+NORXStreamRestore(norx_stream_t* pCtx, const norx_key_t* pKey,
+                  const uint8_t* pIn, size_t len) {
+  norx_stream_t ctx;
+  word_t* pwS;
+  uint32_t words;
+  uint32_t i;
+
+  if (len < STREAM_CKPT_FIXED ||
+      memcmp(pIn, STREAM_CKPT_MAGIC, 8) != 0 ||
+      pIn[8] != WORD_LEN || pIn[9] != RND_NUM || pIn[10] != PARALLEL ||
+      pIn[11] >= STREAM_DONE) {
+    return false;
+  }
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.phase = pIn[11];
+  ctx.pos = 0;
+  for (i = 0; i < 4; i++) {
+    ctx.pos |= (uint32_t)pIn[12 + i] << (8 * i);
+  }
+  for (i = 0; i < 3; i++) {
+    ctx.len[i] = get64(pIn + 16 + 8 * i);
+  }
+  ctx.blocks = get64(pIn + 40);
+  if (ctx.pos > RATE_BYTES) {
+    return false;
+  }
+
+  pwS = lanesLive(&ctx) ? ctx.Sbar : ctx.S;
+  words = lanesLive(&ctx) ? LANES_WORDS : 16;
+  if (len != STREAM_CKPT_FIXED + (size_t)words * WORD_BYTES) {
+    return false;
+  }
+  for (i = 0; i < words; i++) {
+    pwS[i] = loadWord(pIn + STREAM_CKPT_FIXED + i * WORD_BYTES);
+  }
+  for (i = 0; i < 4; i++) {
+    ctx.K[i] = pKey->K[i];
+  }
+
+  *pCtx = ctx;
+  wipe(&ctx, sizeof(ctx));
+
+  return true;
+}
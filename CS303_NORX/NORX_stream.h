@@ -0,0 +1,90 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_stream.h                                                       *
+* Purpose -> Context based streaming NORX, the header, payload and trailer    *
+*            are fed in pieces of any byte length                             *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - Init/Update/Final Streaming API                 *
+*            2.0 10/17/2026 - Init from a Key Schedule                        *
+*            3.0 10/17/2026 - Checkpoint and Restore                          *
+*            4.0 10/17/2026 - Final with the Tag Checked                      *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_STREAM_H
+#define NORX_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Phases a stream moves through, only ever forwards
+//*****************************************************************************
+#define STREAM_HEADER   0
+#define STREAM_PAYLOAD  1
+#define STREAM_TRAILER  2
+#define STREAM_DONE     3
+
+//*****************************************************************************
+// Stream context. The open rate block lives in the state itself: its F has
+// already run, so new bytes XOR straight into the rate and pos counts how
+// much of it is used.
+//*****************************************************************************
+typedef struct {
+  word_t S[16];               // State, 4x4 matrix of words
+  word_t Sbar[LANES_WORDS];   // Lane states while the payload runs
+  word_t K[4];                // Key words, finalise() needs them again
+  uint64_t len[3];            // Bytes taken by header, payload and trailer
+  uint64_t blocks;            // Payload blocks started, block n is on lane n % P
+  uint32_t phase;             // STREAM_xxx
+  uint32_t pos;               // Bytes of the open block used, RATE_BYTES if none
+} norx_stream_t;
+
+//*****************************************************************************
+// Checkpoint of a stream, little endian:
+//   magic "NORXCKP1", W, L, P, phase, pos (4 bytes), header, payload and
+//   trailer bytes so far (8 bytes each), payload blocks (8 bytes)
+// then the live state words: S, or the PARALLEL lane states once payload
+// bytes have been taken. The key words are not in it, the restore is given
+// the key schedule again. It still holds the state, so keep it as secret as
+// the key.
+//*****************************************************************************
+#define STREAM_CKPT_MAGIC   "NORXCKP1"
+#define STREAM_CKPT_FIXED   (8 + 4 + 4 + 3 * 8 + 8)
+#define STREAM_CKPT_BYTES   (STREAM_CKPT_FIXED + LANES_WORDS * WORD_BYTES)
+
+//*****************************************************************************
+// Stream Prototypes. The update calls return false when the stream is past
+// their phase already, moving to a later phase closes the ones before it.
+// A stream being opened ends with NORXStreamFinalCheck(), which checks the
+// received tag without handing the computed one out. Either final call
+// wipes the context.
+//*****************************************************************************
+extern void NORXStreamInit(norx_stream_t* pCtx, const uint8_t* pK,
+                           const uint8_t* pN);
+extern void NORXStreamInitKey(norx_stream_t* pCtx, const norx_key_t* pKey,
+                              const uint8_t* pN);
+extern bool NORXStreamHeader(norx_stream_t* pCtx, const uint8_t* pA, size_t len);
+extern bool NORXStreamEncrypt(norx_stream_t* pCtx, const uint8_t* pM, size_t len,
+                              uint8_t* pC);
+extern bool NORXStreamDecrypt(norx_stream_t* pCtx, const uint8_t* pC, size_t len,
+                              uint8_t* pM);
+extern bool NORXStreamTrailer(norx_stream_t* pCtx, const uint8_t* pZ, size_t len);
+extern bool NORXStreamFinal(norx_stream_t* pCtx, uint8_t* pT);
+extern bool NORXStreamFinalCheck(norx_stream_t* pCtx, const uint8_t* pT);
+
+//*****************************************************************************
+// Checkpoint Prototypes. NORXStreamSave() writes at most STREAM_CKPT_BYTES
+// and returns how many, 0 once the stream is finalised. NORXStreamRestore()
+// sets up pCtx to carry on from the checkpoint exactly as the saved stream
+// would have, on any thread or in another process running the same build.
+// false if the checkpoint is cut short, damaged or from another build.
+//*****************************************************************************
+extern size_t NORXStreamSave(const norx_stream_t* pCtx, uint8_t* pOut);
+extern bool NORXStreamRestore(norx_stream_t* pCtx, const norx_key_t* pKey,
+                              const uint8_t* pIn, size_t len);
+
+#endif // NORX_STREAM_H
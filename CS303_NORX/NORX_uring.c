@@ -0,0 +1,804 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_uring.c                                                        *
+* Purpose -> io_uring pipeline around the stream API: reads, sealing and      *
+*            writes of different buffers all run at the same time             *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - io_uring Encryption Pipeline                    *
+*            2.0 10/17/2026 - Tag Checked by tagMatch()                       *
+*            3.0 10/17/2026 - Tag Checked by NORXStreamFinalCheck()           *
+*                                                                             *
+* Build -> needs -pthread and Linux 5.6 or later. The ring is driven through  *
+* the raw io_uring_setup/io_uring_enter system calls, liburing is not needed. *
+*                                                                             *
+* The run is a sequence of buffers, buffer n living in bufs[n % URING_BUFS].  *
+* The main thread owns the ring: it reads ahead into every free buffer,      *
+* hands the filled ones in order to the crypto thread, and writes each one   *
+* out as soon as it is sealed. The crypto thread runs NORXStreamEncrypt() or  *
+* NORXStreamDecrypt() in place on one buffer after the other, and bumps an    *
+* eventfd the ring has a read pending on, so the main thread only ever waits  *
+* on the ring. A buffer is free again once its write is done.                 *
+*                                                                             *
+* Regular files get as many reads and writes in flight as there are buffers,  *
+* at explicit offsets. Pipes and sockets get one at a time so the bytes stay  *
+* in order.                                                                   *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <errno.h>           // errno values
+#include <linux/io_uring.h>  // Ring layout and opcodes
+#include <pthread.h>         // Crypto thread
+#include <stdbool.h>         // bool types
+#include <stddef.h>          // size_t
+#include <stdint.h>          // uintXX_t types
+#include <stdlib.h>          // aligned_alloc, free
+#include <string.h>          // memset
+#include <sys/eventfd.h>     // eventfd
+#include <sys/mman.h>        // mmap of the rings
+#include <sys/stat.h>        // fstat
+#include <sys/syscall.h>     // io_uring system calls
+#include <sys/uio.h>         // struct iovec
+#include <time.h>            // clock_gettime
+#include <unistd.h>          // syscall, write, close
+
+#include "NORX.h"        // NORX defines and prototypes
+#include "NORX_stream.h" // Stream API
+#include "NORX_uring.h"  // Pipeline prototypes
+
+//*****************************************************************************
+// Ring size, enough for a read and a write per buffer and the eventfd read
+//*****************************************************************************
+#define RING_ENTRIES   (2 * URING_BUFS + 2)
+
+//*****************************************************************************
+// Request kind in the top half of user_data, buffer index in the bottom
+//*****************************************************************************
+#define REQ_READ       1
+#define REQ_WRITE      2
+#define REQ_EVENT      3
+#define REQ(kind, i)   (((uint64_t)(kind) << 32) | (uint32_t)(i))
+
+//*****************************************************************************
+// Buffer states
+//*****************************************************************************
+#define BUF_FREE       0
+#define BUF_READING    1
+#define BUF_READ       2   // Filled, waiting for or at the crypto thread
+#define BUF_WRITING    3
+
+//*****************************************************************************
+// The parts of the ring mapped from the kernel
+//*****************************************************************************
+typedef struct {
+  int fd;
+  uint32_t* pSqTail;
+  uint32_t* pSqArray;
+  uint32_t sqMask;
+  struct io_uring_sqe* pSqes;
+  uint32_t* pCqHead;
+  uint32_t* pCqTail;
+  uint32_t cqMask;
+  struct io_uring_cqe* pCqes;
+  void* pSqMap;
+  size_t sqMapBytes;
+  void* pCqMap;
+  size_t cqMapBytes;
+  size_t sqeBytes;
+  uint32_t queued;            // SQEs not passed to io_uring_enter yet
+} ring_t;
+
+//*****************************************************************************
+// One pipeline buffer
+//*****************************************************************************
+typedef struct {
+  uint8_t* p;
+  uint64_t seq;               // Buffer number in the run
+  uint64_t off;               // Input offset of p[0]
+  size_t want;                // Bytes to read
+  size_t got;                 // Bytes read so far
+  size_t cryptLen;            // Payload bytes, any after them are tag
+  uint64_t outOff;            // Output offset of p[0]
+  size_t put;                 // Bytes written so far
+  uint32_t state;             // BUF_xxx
+} pbuf_t;
+
+//*****************************************************************************
+// One run
+//*****************************************************************************
+typedef struct {
+  ring_t ring;
+  pbuf_t bufs[URING_BUFS];
+  uint8_t* pMem;
+  size_t bufBytes;
+  bool fixed;                 // Buffers are registered
+  bool dec;
+  bool draining;              // Stop resubmitting, just reap
+
+  int fdIn;
+  int fdOut;
+  bool inSeek;                // Regular file, reads at offsets
+  bool outSeek;
+  uint64_t inSize;            // Input bytes for a regular file
+  uint64_t payload;           // Cipher text bytes when decrypting
+
+  uint64_t total;             // Buffers in the run, UINT64_MAX until EOF
+  uint64_t readSeq;           // Next buffer to read
+  uint64_t handSeq;           // Next buffer to hand to the crypto thread
+  uint64_t writeSeq;          // Next buffer to write
+  uint64_t doneSeq;           // Buffers before this one are written
+  uint64_t inPos;
+  uint64_t outPos;
+  uint32_t readsOut;          // Reads in flight
+  uint32_t writesOut;         // Writes in flight
+  uint8_t tag[TAG_BYTES];     // Tag read from the input when decrypting
+
+  norx_stream_t ctx;          // Only touched by the crypto thread mid run
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  uint64_t handed;            // Buffers the crypto thread may take
+  uint64_t crypted;           // Buffers the crypto thread is done with
+  bool stop;
+
+  int efd;                    // Bumped by the crypto thread per buffer
+  uint64_t efdVal;
+  bool efdOut;                // Ring has a read on efd pending
+
+  norx_uring_stats_t stats;
+} pipe_t;
+
+//*****************************************************************************
+//
+// Function -> nowNs
+// Purpose -> Monotonic time in ns
+//
+//*****************************************************************************
+static uint64_t
+nowNs(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+//*****************************************************************************
+//
+// Function -> ringExit
+// Purpose -> Unmap and close a ring, ringInit() may have got part way
+//
+//*****************************************************************************
+static void
+ringExit(ring_t* pR) {
+  if (pR->pSqes != NULL && pR->pSqes != MAP_FAILED) {
+    munmap(pR->pSqes, pR->sqeBytes);
+  }
+  if (pR->pCqMap != NULL && pR->pCqMap != MAP_FAILED) {
+    munmap(pR->pCqMap, pR->cqMapBytes);
+  }
+  if (pR->pSqMap != NULL && pR->pSqMap != MAP_FAILED) {
+    munmap(pR->pSqMap, pR->sqMapBytes);
+  }
+  if (pR->fd >= 0) {
+    close(pR->fd);
+  }
+  memset(pR, 0, sizeof(*pR));
+  pR->fd = -1;
+}
+
+//*****************************************************************************
+//
+// Function -> ringInit
+// Purpose -> Set up a ring and map its queues
+// Returns -> 0 or -errno
+//
+//*****************************************************************************
+static int
+ringInit(ring_t* pR, uint32_t entries) {
+  struct io_uring_params p;
+  uint8_t* pSq;
+  uint8_t* pCq;
+  int err;
+
+  memset(pR, 0, sizeof(*pR));
+  memset(&p, 0, sizeof(p));
+  pR->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+  if (pR->fd < 0) {
+    return -errno;
+  }
+
+  pR->sqMapBytes = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+  pR->cqMapBytes = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  pR->sqeBytes = p.sq_entries * sizeof(struct io_uring_sqe);
+  pR->pSqMap = mmap(NULL, pR->sqMapBytes, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, pR->fd, IORING_OFF_SQ_RING);
+  pR->pCqMap = mmap(NULL, pR->cqMapBytes, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, pR->fd, IORING_OFF_CQ_RING);
+  pR->pSqes = (struct io_uring_sqe*)mmap(NULL, pR->sqeBytes,
+                                         PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, pR->fd,
+                                         IORING_OFF_SQES);
+  if (pR->pSqMap == MAP_FAILED || pR->pCqMap == MAP_FAILED ||
+      pR->pSqes == MAP_FAILED) {
+    err = -errno;
+    ringExit(pR);
+    return err;
+  }
+
+  pSq = (uint8_t*)pR->pSqMap;
+  pCq = (uint8_t*)pR->pCqMap;
+  pR->pSqTail = (uint32_t*)(pSq + p.sq_off.tail);
+  pR->pSqArray = (uint32_t*)(pSq + p.sq_off.array);
+  pR->sqMask = *(uint32_t*)(pSq + p.sq_off.ring_mask);
+  pR->pCqHead = (uint32_t*)(pCq + p.cq_off.head);
+  pR->pCqTail = (uint32_t*)(pCq + p.cq_off.tail);
+  pR->cqMask = *(uint32_t*)(pCq + p.cq_off.ring_mask);
+  pR->pCqes = (struct io_uring_cqe*)(pCq + p.cq_off.cqes);
+
+  return 0;
+}
+
+//*****************************************************************************
+//
+// Function -> ringQueue
+// Purpose -> Fill in the next SQE and publish it. The ring is sized so it
+//            can not run out: at most one read and one write per buffer and
+//            the eventfd read are ever in flight.
+//
+//*****************************************************************************
+static void
+ringQueue(ring_t* pR, uint8_t opcode, int fd, void* pBuf, uint32_t len,
+          uint64_t off, int bufIndex, uint64_t userData) {
+  uint32_t tail = *pR->pSqTail;
+  uint32_t idx = tail & pR->sqMask;
+  struct io_uring_sqe* pSqe = &pR->pSqes[idx];
+
+  memset(pSqe, 0, sizeof(*pSqe));
+  pSqe->opcode = opcode;
+  pSqe->fd = fd;
+  pSqe->addr = (uint64_t)(uintptr_t)pBuf;
+  pSqe->len = len;
+  pSqe->off = off;
+  pSqe->buf_index = (uint16_t)((bufIndex < 0) ? 0 : bufIndex);
+  pSqe->user_data = userData;
+  pR->pSqArray[idx] = idx;
+
+  __atomic_store_n(pR->pSqTail, tail + 1, __ATOMIC_RELEASE);
+  pR->queued++;
+}
+
+//*****************************************************************************
+//
+// Function -> ringEnter
+// Purpose -> Submit what is queued and wait for wait completions
+// Returns -> 0 or -errno
+//
+//*****************************************************************************
+static int
+ringEnter(ring_t* pR, uint32_t wait) {
+  long ret;
+
+  do {
+    ret = syscall(__NR_io_uring_enter, pR->fd, pR->queued, wait,
+                  (wait > 0) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+  } while (ret < 0 && errno == EINTR);
+  if (ret < 0) {
+    return -errno;
+  }
+  pR->queued -= (uint32_t)ret;
+  return 0;
+}
+
+//*****************************************************************************
+//
+// Function -> cryptMain
+// Purpose -> Crypto thread, runs the stream API over each buffer it is
+//            handed, in order, and tells the ring through the eventfd
+//
+//*****************************************************************************
+static void*
+cryptMain(void* pArg) {
+  pipe_t* pP = (pipe_t*)pArg;
+  const uint64_t one = 1;
+  pbuf_t* pB;
+  uint64_t t0;
+  ssize_t rc;
+
+  pthread_mutex_lock(&pP->lock);
+  for (;;) {
+    while (!pP->stop && pP->handed == pP->crypted) {
+      pthread_cond_wait(&pP->cond, &pP->lock);
+    }
+    if (pP->handed == pP->crypted) {
+      break;
+    }
+    pB = &pP->bufs[pP->crypted % URING_BUFS];
+    pthread_mutex_unlock(&pP->lock);
+
+    t0 = nowNs();
+    if (pP->dec) {
+      NORXStreamDecrypt(&pP->ctx, pB->p, pB->cryptLen, pB->p);
+    }
+    else {
+      NORXStreamEncrypt(&pP->ctx, pB->p, pB->cryptLen, pB->p);
+    }
+    pP->stats.cryptNs += nowNs() - t0;
+
+    pthread_mutex_lock(&pP->lock);
+    pP->crypted++;
+    rc = write(pP->efd, &one, sizeof(one));
+    (void)rc;
+  }
+  pthread_mutex_unlock(&pP->lock);
+
+  return NULL;
+}
+
+//*****************************************************************************
+//
+// Function -> submitRead / submitWrite
+// Purpose -> Queue the rest of a buffer's read or write
+//
+//*****************************************************************************
+static void
+submitRead(pipe_t* pP, pbuf_t* pB) {
+  uint32_t i = (uint32_t)(pB->seq % URING_BUFS);
+
+  ringQueue(&pP->ring, pP->fixed ? IORING_OP_READ_FIXED : IORING_OP_READ,
+            pP->fdIn, pB->p + pB->got, (uint32_t)(pB->want - pB->got),
+            pP->inSeek ? pB->off + pB->got : (uint64_t)-1,
+            pP->fixed ? (int)i : -1, REQ(REQ_READ, i));
+}
+
+static void
+submitWrite(pipe_t* pP, pbuf_t* pB) {
+  uint32_t i = (uint32_t)(pB->seq % URING_BUFS);
+
+  ringQueue(&pP->ring, pP->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE,
+            pP->fdOut, pB->p + pB->put, (uint32_t)(pB->cryptLen - pB->put),
+            pP->outSeek ? pB->outOff + pB->put : (uint64_t)-1,
+            pP->fixed ? (int)i : -1, REQ(REQ_WRITE, i));
+}
+
+//*****************************************************************************
+//
+// Function -> readDone
+// Purpose -> A buffer is filled: work out how much of it is payload and
+//            keep the tag bytes when decrypting
+//
+//*****************************************************************************
+static void
+readDone(pipe_t* pP, pbuf_t* pB) {
+  size_t i;
+
+  pB->state = BUF_READ;
+  pB->cryptLen = pB->got;
+  if (!pP->dec) {
+    return;
+  }
+
+  if (pB->off >= pP->payload) {
+    pB->cryptLen = 0;
+  }
+  else if (pP->payload - pB->off < pB->got) {
+    pB->cryptLen = (size_t)(pP->payload - pB->off);
+  }
+  for (i = pB->cryptLen; i < pB->got; i++) {
+    pP->tag[pB->off + i - pP->payload] = pB->p[i];
+  }
+}
+
+//*****************************************************************************
+//
+// Function -> reap
+// Purpose -> Handle every completion waiting on the ring
+// Returns -> 0 or -errno of a failed request
+//
+//*****************************************************************************
+static int
+reap(pipe_t* pP) {
+  ring_t* pR = &pP->ring;
+  struct io_uring_cqe* pCqe;
+  pbuf_t* pB;
+  uint32_t head;
+  uint32_t kind;
+  int32_t res;
+  int err = 0;
+
+  for (;;) {
+    head = *pR->pCqHead;
+    if (head == __atomic_load_n(pR->pCqTail, __ATOMIC_ACQUIRE)) {
+      break;
+    }
+    pCqe = &pR->pCqes[head & pR->cqMask];
+    kind = (uint32_t)(pCqe->user_data >> 32);
+    pB = &pP->bufs[(uint32_t)pCqe->user_data % URING_BUFS];
+    res = pCqe->res;
+    __atomic_store_n(pR->pCqHead, head + 1, __ATOMIC_RELEASE);
+
+    if (kind == REQ_EVENT) {
+      pP->efdOut = false;
+      continue;
+    }
+
+    //
+    // Retry what the kernel asks to be retried, anything else is fatal
+    //
+    if ((res == -EINTR || res == -EAGAIN) && !pP->draining) {
+      if (kind == REQ_READ) {
+        submitRead(pP, pB);
+      }
+      else {
+        submitWrite(pP, pB);
+      }
+      continue;
+    }
+    if (res < 0) {
+      err = (err != 0) ? err : res;
+      pP->draining = true;
+    }
+
+    if (kind == REQ_READ) {
+      pP->readsOut--;
+      if (pP->draining) {
+        continue;
+      }
+      pP->stats.reads++;
+      pP->stats.inBytes += (uint64_t)res;
+      pB->got += (size_t)res;
+
+      if (!pP->inSeek && res == 0) {
+        //
+        // End of a pipe or socket, this buffer is not part of the run
+        //
+        pP->total = pB->seq;
+        pP->readSeq = pB->seq;
+        pB->state = BUF_FREE;
+      }
+      else if (pP->inSeek && res == 0 && pB->got < pB->want) {
+        err = (err != 0) ? err : -EIO;
+        pP->draining = true;
+      }
+      else if (pP->inSeek && pB->got < pB->want) {
+        pP->readsOut++;
+        submitRead(pP, pB);
+      }
+      else {
+        readDone(pP, pB);
+      }
+    }
+    else {
+      pP->writesOut--;
+      if (pP->draining) {
+        continue;
+      }
+      pP->stats.writes++;
+      pP->stats.outBytes += (uint64_t)res;
+      pB->put += (size_t)res;
+      if (pB->put < pB->cryptLen) {
+        pP->writesOut++;
+        submitWrite(pP, pB);
+      }
+      else {
+        pB->state = BUF_FREE;
+      }
+    }
+  }
+
+  return err;
+}
+
+//*****************************************************************************
+//
+// Function -> pump
+// Purpose -> Move every buffer on as far as it can go without waiting:
+//            read into free ones, hand filled ones to the crypto thread and
+//            write sealed ones
+// Returns -> true if a buffer with nothing to write was freed, so there may
+//            be more to do before waiting
+//
+//*****************************************************************************
+static bool
+pump(pipe_t* pP) {
+  bool freed = false;
+  pbuf_t* pB;
+  uint64_t crypted;
+  uint64_t hand;
+
+  //
+  // Buffers whose writes are done are free to read into again
+  //
+  while (pP->doneSeq < pP->writeSeq &&
+         pP->bufs[pP->doneSeq % URING_BUFS].state == BUF_FREE) {
+    pP->doneSeq++;
+  }
+
+  //
+  // Reads, a pipe or socket one at a time
+  //
+  while (pP->readSeq < pP->total && pP->readSeq < pP->doneSeq + URING_BUFS &&
+         (pP->inSeek || pP->readsOut == 0)) {
+    pB = &pP->bufs[pP->readSeq % URING_BUFS];
+    pB->seq = pP->readSeq;
+    pB->off = pP->inPos;
+    pB->want = pP->bufBytes;
+    if (pP->inSeek && pP->inSize - pP->inPos < pB->want) {
+      pB->want = (size_t)(pP->inSize - pP->inPos);
+    }
+    pB->got = 0;
+    pB->state = BUF_READING;
+    pP->inPos += pB->want;
+    pP->readsOut++;
+    pP->readSeq++;
+    submitRead(pP, pB);
+  }
+
+  //
+  // Hand filled buffers over in order
+  //
+  hand = pP->handSeq;
+  while (hand < pP->readSeq && hand < pP->total &&
+         pP->bufs[hand % URING_BUFS].state == BUF_READ) {
+    hand++;
+  }
+
+  pthread_mutex_lock(&pP->lock);
+  if (hand != pP->handSeq) {
+    pP->handSeq = hand;
+    pP->handed = hand;
+    pthread_cond_signal(&pP->cond);
+  }
+  crypted = pP->crypted;
+  pthread_mutex_unlock(&pP->lock);
+
+  //
+  // Writes in order, a pipe or socket one at a time
+  //
+  while (pP->writeSeq < crypted && (pP->outSeek || pP->writesOut == 0)) {
+    pB = &pP->bufs[pP->writeSeq % URING_BUFS];
+    pB->outOff = pP->outPos;
+    pB->put = 0;
+    pP->outPos += pB->cryptLen;
+    pP->writeSeq++;
+    if (pB->cryptLen == 0) {
+      pB->state = BUF_FREE;
+      freed = true;
+      continue;
+    }
+    pB->state = BUF_WRITING;
+    pP->writesOut++;
+    submitWrite(pP, pB);
+  }
+
+  if (!pP->efdOut) {
+    ringQueue(&pP->ring, IORING_OP_READ, pP->efd, &pP->efdVal,
+              sizeof(pP->efdVal), 0, -1, REQ(REQ_EVENT, 0));
+    pP->efdOut = true;
+  }
+
+  return freed;
+}
+
+//*****************************************************************************
+//
+// Function -> writeAll
+// Purpose -> Plain blocking write of the tag once the pipeline is done
+//
+//*****************************************************************************
+static int
+writeAll(pipe_t* pP, const uint8_t* p, size_t len) {
+  ssize_t n;
+
+  while (len > 0) {
+    n = pP->outSeek ? pwrite(pP->fdOut, p, len, (off_t)pP->outPos)
+                    : write(pP->fdOut, p, len);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return (n < 0) ? -errno : -EIO;
+    }
+    pP->stats.outBytes += (uint64_t)n;
+    pP->outPos += (uint64_t)n;
+    p += n;
+    len -= (size_t)n;
+  }
+  return 0;
+}
+
+//*****************************************************************************
+//
+// Function -> runPipe
+// Purpose -> Whole run for both directions
+// Returns -> 0, -errno or URING_BAD_TAG
+//
+//*****************************************************************************
+static int
+runPipe(int fdIn, int fdOut, const norx_key_t* pKey, const uint8_t* pN,
+        const uint8_t* pA, size_t aLen, size_t bufBytes, bool dec,
+        norx_uring_stats_t* pStats) {
+  static const uint64_t one = 1;
+  struct iovec iov[URING_BUFS];
+  struct stat st;
+  uint8_t tag[TAG_BYTES];
+  uint64_t t0 = nowNs();
+  pipe_t* pP;
+  bool freed;
+  uint32_t i;
+  ssize_t rc;
+  int err;
+
+  pP = (pipe_t*)calloc(1, sizeof(*pP));
+  if (pP == NULL) {
+    return -ENOMEM;
+  }
+  pP->bufBytes = (bufBytes == 0) ? URING_BUF_BYTES : bufBytes;
+  pP->dec = dec;
+  pP->fdIn = fdIn;
+  pP->fdOut = fdOut;
+  pP->total = UINT64_MAX;
+  pP->ring.fd = -1;
+  pP->efd = -1;
+
+  if (fstat(fdIn, &st) != 0) {
+    err = -errno;
+    goto out;
+  }
+  pP->inSeek = S_ISREG(st.st_mode);
+  pP->inSize = (uint64_t)st.st_size;
+  if (fstat(fdOut, &st) != 0) {
+    err = -errno;
+    goto out;
+  }
+  pP->outSeek = S_ISREG(st.st_mode);
+
+  if (pP->inSeek) {
+    pP->total = (pP->inSize + pP->bufBytes - 1) / pP->bufBytes;
+  }
+  if (dec) {
+    if (!pP->inSeek || pP->inSize < TAG_BYTES) {
+      err = -EINVAL;
+      goto out;
+    }
+    pP->payload = pP->inSize - TAG_BYTES;
+  }
+
+  err = ringInit(&pP->ring, RING_ENTRIES);
+  if (err != 0) {
+    goto out;
+  }
+  pP->efd = eventfd(0, EFD_CLOEXEC);
+  pP->pMem = (uint8_t*)aligned_alloc(4096, (pP->bufBytes + 4095) / 4096 *
+                                           4096 * URING_BUFS);
+  if (pP->efd < 0 || pP->pMem == NULL) {
+    err = (pP->efd < 0) ? -errno : -ENOMEM;
+    goto out;
+  }
+
+  //
+  // Registered buffers save the kernel pinning pages per request, they are
+  // only an optimisation so a failure (RLIMIT_MEMLOCK) is not fatal
+  //
+  for (i = 0; i < URING_BUFS; i++) {
+    pP->bufs[i].p = pP->pMem + (pP->bufBytes + 4095) / 4096 * 4096 * i;
+    iov[i].iov_base = pP->bufs[i].p;
+    iov[i].iov_len = pP->bufBytes;
+  }
+  pP->fixed = syscall(__NR_io_uring_register, pP->ring.fd,
+                      IORING_REGISTER_BUFFERS, iov, URING_BUFS) == 0;
+  pP->stats.fixed = pP->fixed;
+
+  NORXStreamInitKey(&pP->ctx, pKey, pN);
+  NORXStreamHeader(&pP->ctx, pA, aLen);
+
+  pthread_mutex_init(&pP->lock, NULL);
+  pthread_cond_init(&pP->cond, NULL);
+  if (pthread_create(&pP->thread, NULL, cryptMain, pP) != 0) {
+    pthread_cond_destroy(&pP->cond);
+    pthread_mutex_destroy(&pP->lock);
+    err = -EAGAIN;
+    goto out;
+  }
+
+  for (;;) {
+    freed = pump(pP);
+    if (pP->doneSeq == pP->total) {
+      break;
+    }
+    if (freed) {
+      continue;
+    }
+    err = ringEnter(&pP->ring, 1);
+    if (err == 0) {
+      err = reap(pP);
+    }
+    if (err != 0) {
+      break;
+    }
+  }
+
+  //
+  // Stop the crypto thread, then wait out whatever is still in flight so
+  // no buffer is freed under the kernel
+  //
+  pthread_mutex_lock(&pP->lock);
+  pP->stop = true;
+  pthread_cond_signal(&pP->cond);
+  pthread_mutex_unlock(&pP->lock);
+  pthread_join(pP->thread, NULL);
+  pthread_cond_destroy(&pP->cond);
+  pthread_mutex_destroy(&pP->lock);
+
+  pP->draining = true;
+  rc = write(pP->efd, &one, sizeof(one));
+  (void)rc;
+  while ((pP->readsOut > 0 || pP->writesOut > 0 || pP->efdOut) &&
+         ringEnter(&pP->ring, 1) == 0) {
+    reap(pP);
+  }
+
+  if (err == 0) {
+    if (dec) {
+      err = NORXStreamFinalCheck(&pP->ctx, pP->tag) ? 0 : URING_BAD_TAG;
+    }
+    else {
+      NORXStreamFinal(&pP->ctx, tag);
+      err = writeAll(pP, tag, TAG_BYTES);
+      wipe(tag, sizeof(tag));
+    }
+  }
+
+out:
+  pP->stats.totalNs = nowNs() - t0;
+  if (pStats != NULL) {
+    *pStats = pP->stats;
+  }
+  if (pP->ring.fd >= 0) {
+    ringExit(&pP->ring);
+  }
+  if (pP->efd >= 0) {
+    close(pP->efd);
+  }
+  free(pP->pMem);
+  wipe(pP, sizeof(*pP));
+  free(pP);
+
+  return err;
+}
+
+//*****************************************************************************
+//
+// Function -> NORXUringEnc
+// Purpose -> Encrypt fdIn to fdOut, cipher text then tag
+// Inputs -> int fdIn, fdOut - File descriptors, any kind
+//           const norx_key_t* pKey - Key schedule
+//           const uint8_t* pN - Nonce, NONCE_BYTES
+//           const uint8_t* pA, aLen - Header
+//           size_t bufBytes - Bytes per pipeline buffer, 0 for the default
+//           norx_uring_stats_t* pStats - What the run did, may be NULL
+// Returns -> 0 or -errno
+//
+//*****************************************************************************
+int
+NORXUringEnc(int fdIn, int fdOut, const norx_key_t* pKey, const uint8_t* pN,
+             const uint8_t* pA, size_t aLen, size_t bufBytes,
+             norx_uring_stats_t* pStats) {
+  return runPipe(fdIn, fdOut, pKey, pN, pA, aLen, bufBytes, false, pStats);
+}
+
+//*****************************************************************************
+//
+// Function -> NORXUringDec
+// Purpose -> Decrypt fdIn, cipher text then tag, to fdOut
+// Inputs -> Same as NORXUringEnc(), fdIn a regular file
+// Returns -> 0, -errno or URING_BAD_TAG
+//
+//*****************************************************************************
+int
+NORXUringDec(int fdIn, int fdOut, const norx_key_t* pKey, const uint8_t* pN,
+             const uint8_t* pA, size_t aLen, size_t bufBytes,
+             norx_uring_stats_t* pStats) {
+  return runPipe(fdIn, fdOut, pKey, pN, pA, aLen, bufBytes, true, pStats);
+}
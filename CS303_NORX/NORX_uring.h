@@ -0,0 +1,66 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_uring.h                                                        *
+* Purpose -> Encrypt or decrypt from one file descriptor to another with the  *
+*            reads and writes on io_uring and the stream API on its own       *
+*            thread, so I/O and sealing overlap                               *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - io_uring Encryption Pipeline                    *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_URING_H
+#define NORX_URING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "NORX.h"
+
+//*****************************************************************************
+// Pipeline buffers, registered with the ring once per run. bufBytes = 0
+// takes URING_BUF_BYTES.
+//*****************************************************************************
+#define URING_BUFS        8
+#define URING_BUF_BYTES   ((size_t)1 << 20)
+
+//*****************************************************************************
+// Results besides 0 and -errno
+//*****************************************************************************
+#define URING_BAD_TAG     1
+
+//*****************************************************************************
+// What a run did
+//*****************************************************************************
+typedef struct {
+  uint64_t inBytes;           // Bytes read
+  uint64_t outBytes;          // Bytes written, tag included
+  uint64_t reads;             // Read requests completed
+  uint64_t writes;            // Write requests completed
+  uint64_t cryptNs;           // Time the crypto thread spent sealing
+  uint64_t totalNs;           // Time for the whole run
+  bool fixed;                 // Registered buffers were used
+} norx_uring_stats_t;
+
+//*****************************************************************************
+// Pipeline Prototypes. Both run the payload through the stream API with
+// header pA, no trailer, and return 0, -errno on an I/O error or
+// URING_BAD_TAG.
+//
+// NORXUringEnc() - Reads fdIn to its end, any kind of fd, and writes the
+//                  cipher text and then the tag to fdOut
+// NORXUringDec() - fdIn must be a regular file holding cipher text and tag.
+//                  Plain text is written as it is decrypted, so on
+//                  URING_BAD_TAG the caller must throw fdOut's data away.
+//
+// pStats may be NULL.
+//*****************************************************************************
+extern int NORXUringEnc(int fdIn, int fdOut, const norx_key_t* pKey,
+                        const uint8_t* pN, const uint8_t* pA, size_t aLen,
+                        size_t bufBytes, norx_uring_stats_t* pStats);
+extern int NORXUringDec(int fdIn, int fdOut, const norx_key_t* pKey,
+                        const uint8_t* pN, const uint8_t* pA, size_t aLen,
+                        size_t bufBytes, norx_uring_stats_t* pStats);
+
+#endif // NORX_URING_H
@@ -0,0 +1,88 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_variants.c                                                     *
+* Purpose -> Stamp out the NORX variants from NORX_engine.h so they can all   *
+*            be used from one program                                         *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - NORX32-4-1, NORX64-4-1, NORX64-6-1 and          *
+*                             NORX64-4-4 Side by Side                         *
+*                                                                             *
+******************************************************************************/
+
+//*****************************************************************************
+// Includes
+//*****************************************************************************
+#include <stdbool.h>   // bool types
+#include <stddef.h>    // size_t
+#include <stdint.h>    // uintXX_t types
+#include <string.h>    // memcpy, memset, strcmp
+
+#include "NORX_variants.h" // Variant prototypes and table
+
+//*****************************************************************************
+// NORX32-4-1
+//*****************************************************************************
+#define ENGINE_NAME  NORX32_4_1
+#define ENGINE_W     32
+#define ENGINE_L     4
+#define ENGINE_P     1
+#include "NORX_engine.h"
+
+//*****************************************************************************
+// NORX64-4-1
+//*****************************************************************************
+#define ENGINE_NAME  NORX64_4_1
+#define ENGINE_W     64
+#define ENGINE_L     4
+#define ENGINE_P     1
+#include "NORX_engine.h"
+
+//*****************************************************************************
+// NORX64-6-1
+//*****************************************************************************
+#define ENGINE_NAME  NORX64_6_1
+#define ENGINE_W     64
+#define ENGINE_L     6
+#define ENGINE_P     1
+#include "NORX_engine.h"
+
+//*****************************************************************************
+// NORX64-4-4
+//*****************************************************************************
+#define ENGINE_NAME  NORX64_4_4
+#define ENGINE_W     64
+#define ENGINE_L     4
+#define ENGINE_P     4
+#include "NORX_engine.h"
+
+//*****************************************************************************
+// Variant table
+//*****************************************************************************
+const variant_t NORXVariants[] = {
+  { "NORX32-4-1", 32, 4, 1, 16, NORX32_4_1Enc, NORX32_4_1Dec },
+  { "NORX64-4-1", 64, 4, 1, 32, NORX64_4_1Enc, NORX64_4_1Dec },
+  { "NORX64-6-1", 64, 6, 1, 32, NORX64_6_1Enc, NORX64_6_1Dec },
+  { "NORX64-4-4", 64, 4, 4, 32, NORX64_4_4Enc, NORX64_4_4Dec },
+};
+
+const uint32_t NORXVariantCount = sizeof(NORXVariants) / sizeof(NORXVariants[0]);
+
+//*****************************************************************************
+//
+// Function -> NORXFindVariant
+// Purpose -> Look a variant up by name
+// Inputs -> const char* name - e.g. "NORX64-4-1"
+// Returns -> The table entry, or NULL if there is no such variant
+//
+//*****************************************************************************
+const variant_t*
+NORXFindVariant(const char* name) {
+  uint32_t i;
+
+  for (i = 0; i < NORXVariantCount; i++) {
+    if (strcmp(NORXVariants[i].name, name) == 0) {
+      return &NORXVariants[i];
+    }
+  }
+  return NULL;
+}
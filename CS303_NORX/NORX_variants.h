@@ -0,0 +1,98 @@
+/******************************************************************************
+*                                                                             *
+* File -> NORX_variants.h                                                     *
+* Purpose -> Prototypes for the NORX variants built from NORX_engine.h, and   *
+*            a table to pick one of them by name at run time                  *
+* Author -> Joseph Kroeker                                                    *
+* Version -> 1.0 10/17/2026 - NORX32-4-1, NORX64-4-1, NORX64-6-1 and          *
+*                             NORX64-4-4 Side by Side                         *
+*                                                                             *
+******************************************************************************/
+
+#ifndef NORX_VARIANTS_H
+#define NORX_VARIANTS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//*****************************************************************************
+// Encrypt and decrypt function types shared by every variant
+//*****************************************************************************
+typedef void (*variant_enc_t)(const uint8_t* pK, const uint8_t* pN,
+                              const uint8_t* pA, size_t aLen,
+                              const uint8_t* pM, size_t mLen,
+                              const uint8_t* pZ, size_t zLen,
+                              uint8_t* pC, uint8_t* pT);
+typedef bool (*variant_dec_t)(const uint8_t* pK, const uint8_t* pN,
+                              const uint8_t* pA, size_t aLen,
+                              const uint8_t* pC, size_t cLen,
+                              const uint8_t* pZ, size_t zLen,
+                              const uint8_t* pT, uint8_t* pM);
+
+//*****************************************************************************
+// One entry per variant, key, nonce and tag are all 4 words
+//*****************************************************************************
+typedef struct {
+  const char* name;         // e.g. "NORX64-4-1"
+  uint32_t wordLen;         // bits per word
+  uint32_t rounds;          // rounds of F
+  uint32_t parallel;        // lanes
+  uint32_t keyBytes;        // bytes of key, nonce and tag
+  variant_enc_t pfnEnc;
+  variant_dec_t pfnDec;
+} variant_t;
+
+extern const variant_t NORXVariants[];
+extern const uint32_t NORXVariantCount;
+
+extern const variant_t* NORXFindVariant(const char* name);
+
+//*****************************************************************************
+// Variant Prototypes
+//*****************************************************************************
+extern void NORX32_4_1Enc(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pM, size_t mLen,
+                          const uint8_t* pZ, size_t zLen,
+                          uint8_t* pC, uint8_t* pT);
+extern bool NORX32_4_1Dec(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pC, size_t cLen,
+                          const uint8_t* pZ, size_t zLen,
+                          const uint8_t* pT, uint8_t* pM);
+
+extern void NORX64_4_1Enc(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pM, size_t mLen,
+                          const uint8_t* pZ, size_t zLen,
+                          uint8_t* pC, uint8_t* pT);
+extern bool NORX64_4_1Dec(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pC, size_t cLen,
+                          const uint8_t* pZ, size_t zLen,
+                          const uint8_t* pT, uint8_t* pM);
+
+extern void NORX64_6_1Enc(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pM, size_t mLen,
+                          const uint8_t* pZ, size_t zLen,
+                          uint8_t* pC, uint8_t* pT);
+extern bool NORX64_6_1Dec(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pC, size_t cLen,
+                          const uint8_t* pZ, size_t zLen,
+                          const uint8_t* pT, uint8_t* pM);
+
+extern void NORX64_4_4Enc(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pM, size_t mLen,
+                          const uint8_t* pZ, size_t zLen,
+                          uint8_t* pC, uint8_t* pT);
+extern bool NORX64_4_4Dec(const uint8_t* pK, const uint8_t* pN,
+                          const uint8_t* pA, size_t aLen,
+                          const uint8_t* pC, size_t cLen,
+                          const uint8_t* pZ, size_t zLen,
+                          const uint8_t* pT, uint8_t* pM);
+
+#endif // NORX_VARIANTS_H